@@ -0,0 +1,628 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "maze_escape.h"
+
+// Benchmark harness: every benchmark runs a fixed number of timed iterations
+// (after one untimed warm-up) with fixed seeds, so runs are comparable across
+// versions. Results are written as JSON.
+
+#define DEFAULT_REPEAT 10
+#define BENCH_SEED 12345u
+
+// A timed unit of work (setup and teardown happen outside the timed region)
+typedef void (*BenchFunction)(void* context);
+
+// Run-wide options and output state
+typedef struct {
+    FILE* out;
+    const char* filter;
+    int repeat;
+    int result_count;
+} BenchRunner;
+
+// Local function prototypes
+static void bench_run(BenchRunner* runner, const char* name, const char* params,
+                      double items_per_iteration, BenchFunction function, void* context);
+static bool bench_selected(BenchRunner* runner, const char* name);
+static int compare_doubles(const void* a, const void* b);
+static unsigned int bench_random(unsigned int* state);
+static Maze* bench_create_maze(int width, int height);
+static void bench_maze_generate(BenchRunner* runner);
+static void bench_maze_algorithms(BenchRunner* runner);
+static void bench_path_queries(BenchRunner* runner);
+static void bench_hpa_queries(BenchRunner* runner);
+static void bench_graph_queries(BenchRunner* runner);
+static void bench_raycasts(BenchRunner* runner);
+static void bench_terrain_costs(BenchRunner* runner);
+static void bench_physics_bodies(BenchRunner* runner);
+static void bench_physics_step(BenchRunner* runner);
+static void bench_frame_render(BenchRunner* runner);
+static void bench_rgb_to_yuv(BenchRunner* runner);
+static void bench_pipe_write(BenchRunner* runner);
+
+// Main function
+int main(int argc, char* argv[]) {
+    BenchRunner runner = {stdout, NULL, DEFAULT_REPEAT, 0};
+    const char* output_filename = NULL;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            runner.filter = argv[++i];
+        } else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            runner.repeat = atoi(argv[++i]);
+            if (runner.repeat < 1) runner.repeat = 1;
+        } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
+            output_filename = argv[++i];
+        } else {
+            fprintf(stderr, "Usage: %s [--filter <substring>] [--repeat <count>] [--output <file.json>]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    
+    if (output_filename) {
+        runner.out = fopen(output_filename, "w");
+        if (!runner.out) {
+            fprintf(stderr, "Error opening %s\n", output_filename);
+            return EXIT_FAILURE;
+        }
+    }
+    
+    fprintf(runner.out, "{\n  \"suite\": \"maze_escape_bench\",\n  \"repeat\": %d,\n  \"results\": [", runner.repeat);
+    
+    bench_maze_generate(&runner);
+    bench_maze_algorithms(&runner);
+    bench_path_queries(&runner);
+    bench_hpa_queries(&runner);
+    bench_graph_queries(&runner);
+    bench_raycasts(&runner);
+    bench_terrain_costs(&runner);
+    bench_physics_bodies(&runner);
+    bench_physics_step(&runner);
+    bench_frame_render(&runner);
+    bench_rgb_to_yuv(&runner);
+    bench_pipe_write(&runner);
+    
+    fprintf(runner.out, "\n  ]\n}\n");
+    
+    if (runner.out != stdout) {
+        fclose(runner.out);
+    }
+    
+    return EXIT_SUCCESS;
+}
+
+// maze_generate at several sizes
+typedef struct {
+    int width;
+    int height;
+} MazeSizeContext;
+
+static void maze_generate_iteration(void* context) {
+    MazeSizeContext* size = (MazeSizeContext*)context;
+    Maze* maze = maze_create(size->width, size->height, 40);
+    maze_generate(maze, BENCH_SEED);
+    maze_destroy(maze);
+}
+
+static void bench_maze_generate(BenchRunner* runner) {
+    static const int sizes[][2] = {{20, 30}, {64, 64}, {128, 128}, {256, 256}};
+    
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        MazeSizeContext size = {sizes[i][0], sizes[i][1]};
+        char params[32];
+        snprintf(params, sizeof(params), "%dx%d", size.width, size.height);
+        bench_run(runner, "maze_generate", params, size.width * size.height,
+            maze_generate_iteration, &size);
+    }
+}
+
+// Every carving algorithm on one large maze (same buffers, same seed)
+typedef struct {
+    Maze* maze;
+    MazeAlgorithm algorithm;
+} AlgorithmContext;
+
+static void maze_algorithm_iteration(void* context) {
+    AlgorithmContext* ctx = (AlgorithmContext*)context;
+    maze_generate_with(ctx->maze, BENCH_SEED, ctx->algorithm);
+}
+
+static void bench_maze_algorithms(BenchRunner* runner) {
+    if (!bench_selected(runner, "maze_algorithm")) return;
+    
+    AlgorithmContext ctx;
+    ctx.maze = maze_create(512, 512, 40);
+    
+    for (int i = 0; i < MAZE_ALGORITHM_COUNT; i++) {
+        ctx.algorithm = (MazeAlgorithm)i;
+        char params[48];
+        snprintf(params, sizeof(params), "%s 512x512", maze_algorithm_name(ctx.algorithm));
+        bench_run(runner, "maze_algorithm", params, 512 * 512, maze_algorithm_iteration, &ctx);
+    }
+    
+    maze_destroy(ctx.maze);
+}
+
+// Path queries and the distance field they read
+typedef struct {
+    Maze* maze;
+    int* starts;
+    int start_count;
+} PathContext;
+
+static void path_query_iteration(void* context) {
+    PathContext* ctx = (PathContext*)context;
+    for (int i = 0; i < ctx->start_count; i++) {
+        int* path;
+        int length;
+        maze_get_path_to_exit(ctx->maze, ctx->starts[i * 2], ctx->starts[i * 2 + 1], &path, &length);
+        free(path);
+    }
+}
+
+static void distance_field_iteration(void* context) {
+    PathContext* ctx = (PathContext*)context;
+    maze_compute_distance_field(ctx->maze);
+}
+
+static void bench_path_queries(BenchRunner* runner) {
+    if (!bench_selected(runner, "path_query") && !bench_selected(runner, "distance_field")) return;
+    
+    PathContext ctx;
+    ctx.maze = bench_create_maze(64, 64);
+    ctx.start_count = 1000;
+    ctx.starts = (int*)malloc(ctx.start_count * 2 * sizeof(int));
+    
+    // Random open cells
+    unsigned int state = BENCH_SEED;
+    for (int i = 0; i < ctx.start_count; i++) {
+        int x, y;
+        do {
+            x = bench_random(&state) % ctx.maze->width;
+            y = bench_random(&state) % ctx.maze->height;
+        } while (maze_get_exit_distance(ctx.maze, x, y) == MAZE_UNREACHABLE);
+        ctx.starts[i * 2] = x;
+        ctx.starts[i * 2 + 1] = y;
+    }
+    
+    bench_run(runner, "path_query", "64x64", ctx.start_count, path_query_iteration, &ctx);
+    bench_run(runner, "distance_field", "64x64", 64 * 64, distance_field_iteration, &ctx);
+    
+    free(ctx.starts);
+    maze_destroy(ctx.maze);
+}
+
+// Hierarchical path queries on a large maze (sector caches built before timing)
+typedef struct {
+    MazeHpa* hpa;
+    int* starts;
+    int start_count;
+} HpaContext;
+
+static void hpa_query_iteration(void* context) {
+    HpaContext* ctx = (HpaContext*)context;
+    for (int i = 0; i < ctx->start_count; i++) {
+        int* path;
+        int length;
+        hpa_get_path_to_exit(ctx->hpa, ctx->starts[i * 2], ctx->starts[i * 2 + 1], &path, &length);
+        free(path);
+    }
+}
+
+static void bench_hpa_queries(BenchRunner* runner) {
+    if (!bench_selected(runner, "hpa_path_query") && !bench_selected(runner, "distance_field")) return;
+    
+    Maze* maze = bench_create_maze(1024, 1024);
+    HpaContext ctx;
+    ctx.hpa = hpa_create(maze, HPA_DEFAULT_SECTOR_SIZE);
+    ctx.start_count = 20;
+    ctx.starts = (int*)malloc(ctx.start_count * 2 * sizeof(int));
+    
+    unsigned int state = BENCH_SEED;
+    for (int i = 0; i < ctx.start_count; i++) {
+        int x, y;
+        do {
+            x = bench_random(&state) % maze->width;
+            y = bench_random(&state) % maze->height;
+        } while (maze_get_exit_distance(maze, x, y) == MAZE_UNREACHABLE);
+        ctx.starts[i * 2] = x;
+        ctx.starts[i * 2 + 1] = y;
+    }
+    
+    // A flat breadth-first search over the whole maze, for comparison
+    PathContext flat = {maze, NULL, 0};
+    bench_run(runner, "distance_field", "1024x1024", 1024 * 1024, distance_field_iteration, &flat);
+    
+    char params[32];
+    snprintf(params, sizeof(params), "1024x1024 sector %d", HPA_DEFAULT_SECTOR_SIZE);
+    bench_run(runner, "hpa_path_query", params, ctx.start_count, hpa_query_iteration, &ctx);
+    
+    free(ctx.starts);
+    hpa_destroy(ctx.hpa);
+    maze_destroy(maze);
+}
+
+// Junction graph build, exit distance field and point-to-point queries
+typedef struct {
+    MazeGraph* graph;
+    int* field;
+    int* starts;
+    int start_count;
+} GraphContext;
+
+static void graph_build_iteration(void* context) {
+    GraphContext* ctx = (GraphContext*)context;
+    ctx->graph->dirty = true;
+    maze_graph_update(ctx->graph);
+}
+
+static void graph_distance_field_iteration(void* context) {
+    GraphContext* ctx = (GraphContext*)context;
+    Maze* maze = ctx->graph->maze;
+    maze_graph_distance_field(ctx->graph, maze->exit_x, maze->exit_y, ctx->field);
+}
+
+static void graph_path_query_iteration(void* context) {
+    GraphContext* ctx = (GraphContext*)context;
+    Maze* maze = ctx->graph->maze;
+    for (int i = 0; i < ctx->start_count; i++) {
+        int* path;
+        int length;
+        maze_graph_find_path(ctx->graph, ctx->starts[i * 2], ctx->starts[i * 2 + 1],
+                             maze->exit_x, maze->exit_y, &path, &length);
+        free(path);
+    }
+}
+
+static void bench_graph_queries(BenchRunner* runner) {
+    if (!bench_selected(runner, "graph_")) return;
+    
+    Maze* maze = bench_create_maze(1024, 1024);
+    GraphContext ctx;
+    ctx.graph = maze_graph_create(maze);
+    ctx.field = (int*)malloc(1024 * 1024 * sizeof(int));
+    ctx.start_count = 20;
+    ctx.starts = (int*)malloc(ctx.start_count * 2 * sizeof(int));
+    
+    unsigned int state = BENCH_SEED;
+    for (int i = 0; i < ctx.start_count; i++) {
+        int x, y;
+        do {
+            x = bench_random(&state) % maze->width;
+            y = bench_random(&state) % maze->height;
+        } while (maze_get_exit_distance(maze, x, y) == MAZE_UNREACHABLE);
+        ctx.starts[i * 2] = x;
+        ctx.starts[i * 2 + 1] = y;
+    }
+    
+    bench_run(runner, "graph_build", "1024x1024", 1024 * 1024, graph_build_iteration, &ctx);
+    bench_run(runner, "graph_distance_field", "1024x1024", 1024 * 1024, graph_distance_field_iteration, &ctx);
+    bench_run(runner, "graph_path_query", "1024x1024", ctx.start_count, graph_path_query_iteration, &ctx);
+    
+    free(ctx.starts);
+    free(ctx.field);
+    maze_graph_destroy(ctx.graph);
+    maze_destroy(maze);
+}
+
+// Visibility fans: 32 rays of up to 16 cells from random open cells
+typedef struct {
+    Maze* maze;
+    MazeRay* rays;
+    MazeRayHit* hits;
+    int ray_count;
+} RaycastContext;
+
+static void raycast_batch_iteration(void* context) {
+    RaycastContext* ctx = (RaycastContext*)context;
+    maze_raycast_batch(ctx->maze, ctx->rays, ctx->ray_count, ctx->hits);
+}
+
+static void bench_raycasts(BenchRunner* runner) {
+    if (!bench_selected(runner, "maze_raycast")) return;
+    
+    RaycastContext ctx;
+    ctx.maze = bench_create_maze(1024, 1024);
+    ctx.ray_count = 128 * 32;
+    ctx.rays = (MazeRay*)malloc(ctx.ray_count * sizeof(MazeRay));
+    ctx.hits = (MazeRayHit*)malloc(ctx.ray_count * sizeof(MazeRayHit));
+    
+    unsigned int state = BENCH_SEED;
+    float cell_size = (float)ctx.maze->cell_size;
+    for (int i = 0; i < ctx.ray_count; i += 32) {
+        int x, y;
+        do {
+            x = bench_random(&state) % ctx.maze->width;
+            y = bench_random(&state) % ctx.maze->height;
+        } while (maze_is_wall(ctx.maze, x, y));
+        
+        for (int j = 0; j < 32; j++) {
+            float angle = j * (6.2831853f / 32.0f);
+            MazeRay ray = {(x + 0.5f) * cell_size, (y + 0.5f) * cell_size, cosf(angle), sinf(angle), 16.0f * cell_size};
+            ctx.rays[i + j] = ray;
+        }
+    }
+    
+    bench_run(runner, "maze_raycast", "1024x1024 32-ray fans", ctx.ray_count, raycast_batch_iteration, &ctx);
+    
+    free(ctx.hits);
+    free(ctx.rays);
+    maze_destroy(ctx.maze);
+}
+
+// Weighted exit cost field over mud, ice and belts (radix-heap Dijkstra)
+static void terrain_cost_iteration(void* context) {
+    maze_terrain_compute_costs((MazeTerrain*)context);
+}
+
+static void bench_terrain_costs(BenchRunner* runner) {
+    if (!bench_selected(runner, "terrain_cost_field")) return;
+    
+    Maze* maze = bench_create_maze(1024, 1024);
+    MazeTerrain* terrain = maze_terrain_create(maze);
+    maze_terrain_populate(terrain, BENCH_SEED, 0.3f);
+    
+    bench_run(runner, "terrain_cost_field", "1024x1024 30% terrain", 1024 * 1024, terrain_cost_iteration, terrain);
+    
+    maze_terrain_destroy(terrain);
+    maze_destroy(maze);
+}
+
+// maze_add_physics_bodies into a fresh space
+static void physics_bodies_iteration(void* context) {
+    Maze* maze = (Maze*)context;
+    cpSpace* space = physics_create_space(0, 0);
+    maze_add_physics_bodies(maze, space);
+    physics_destroy_space(space);
+}
+
+static void bench_physics_bodies(BenchRunner* runner) {
+    if (!bench_selected(runner, "maze_add_physics_bodies")) return;
+    
+    Maze* maze = bench_create_maze(64, 64);
+    bench_run(runner, "maze_add_physics_bodies", "64x64", 64 * 64, physics_bodies_iteration, maze);
+    maze_destroy(maze);
+}
+
+// cpSpaceStep with N characters in a maze (one second at 60 Hz per iteration)
+static void physics_step_iteration(void* context) {
+    cpSpace* space = (cpSpace*)context;
+    for (int i = 0; i < 60; i++) {
+        cpSpaceStep(space, 1.0 / 60.0);
+    }
+}
+
+static void bench_physics_step(BenchRunner* runner) {
+    if (!bench_selected(runner, "physics_step")) return;
+    
+    static const int character_counts[] = {4, 16, 64};
+    
+    for (int c = 0; c < (int)(sizeof(character_counts) / sizeof(character_counts[0])); c++) {
+        int count = character_counts[c];
+        Maze* maze = bench_create_maze(32, 32);
+        cpSpace* space = physics_create_space(0, 0);
+        maze_add_physics_bodies(maze, space);
+        
+        // Scatter characters over open cells, each pushed in a random direction
+        Character** characters = (Character**)malloc(count * sizeof(Character*));
+        unsigned int state = BENCH_SEED;
+        for (int i = 0; i < count; i++) {
+            int x, y;
+            do {
+                x = bench_random(&state) % maze->width;
+                y = bench_random(&state) % maze->height;
+            } while (maze_is_wall(maze, x, y));
+            
+            characters[i] = character_create_of_type((CharacterType)(i % 4),
+                (x + 0.5f) * maze->cell_size, (y + 0.5f) * maze->cell_size);
+            character_attach_physics(characters[i], space);
+            cpBodySetVelocity(characters[i]->body,
+                cpv((int)(bench_random(&state) % 200) - 100, (int)(bench_random(&state) % 200) - 100));
+        }
+        
+        char params[32];
+        snprintf(params, sizeof(params), "%d characters", count);
+        bench_run(runner, "physics_step", params, 60, physics_step_iteration, space);
+        
+        for (int i = 0; i < count; i++) {
+            character_destroy(characters[i]);
+        }
+        free(characters);
+        physics_destroy_space(space);
+        maze_destroy(maze);
+    }
+}
+
+// Draw one headless frame of a race in progress
+typedef struct {
+    Renderer* renderer;
+    Simulation* sim;
+} RenderContext;
+
+static void frame_render_iteration(void* context) {
+    RenderContext* ctx = (RenderContext*)context;
+    renderer_draw_simulation(ctx->renderer, ctx->sim, 1.0f, 60);
+}
+
+static void bench_frame_render(BenchRunner* runner) {
+    if (!bench_selected(runner, "frame_render")) return;
+    
+    SimulationConfig config = {
+        .maze_width = 20,
+        .maze_height = 30,
+        .cell_size = 40,
+        .character_types = "runner,smasher,climber,teleporter",
+        .simulation_duration = 30,
+        .random_seed = BENCH_SEED
+    };
+    
+    RenderContext ctx;
+    ctx.sim = simulation_create(&config);
+    ctx.renderer = renderer_create_headless(720, 1280);
+    if (!ctx.sim || !ctx.renderer) {
+        fprintf(stderr, "Skipping frame_render: %s\n", SDL_GetError());
+        simulation_destroy(ctx.sim);
+        renderer_destroy(ctx.renderer);
+        return;
+    }
+    ctx.sim->verbose = false;
+    renderer_load_textures(ctx.renderer);
+    renderer_reset(ctx.renderer, BENCH_SEED);
+    
+    // Run a couple of seconds so particles and racers are spread out
+    for (int i = 0; i < 120 && ctx.sim->running; i++) {
+        simulation_step(ctx.sim, 1.0f / 60.0f);
+        renderer_add_simulation_effects(ctx.renderer, ctx.sim);
+        renderer_update_animations(ctx.renderer, ctx.sim, 1.0f / 60.0f);
+    }
+    
+    bench_run(runner, "frame_render", "720x1280", 1, frame_render_iteration, &ctx);
+    
+    renderer_destroy(ctx.renderer);
+    simulation_destroy(ctx.sim);
+}
+
+// RGB24 -> YUV 4:2:0 conversion of one frame
+typedef struct {
+    uint8_t* rgb;
+    uint8_t* yuv;
+    int width;
+    int height;
+} FrameContext;
+
+static void rgb_to_yuv_iteration(void* context) {
+    FrameContext* ctx = (FrameContext*)context;
+    encoder_rgb_to_yuv420(ctx->rgb, ctx->width * 3, ctx->width, ctx->height, ctx->yuv);
+}
+
+static void bench_rgb_to_yuv(BenchRunner* runner) {
+    if (!bench_selected(runner, "rgb_to_yuv420")) return;
+    
+    static const int sizes[][2] = {{720, 1280}, {1080, 1920}};
+    
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(sizes[0])); i++) {
+        FrameContext ctx = {NULL, NULL, sizes[i][0], sizes[i][1]};
+        ctx.rgb = (uint8_t*)malloc(ctx.width * ctx.height * 3);
+        ctx.yuv = (uint8_t*)malloc(encoder_yuv420_size(ctx.width, ctx.height));
+        
+        unsigned int state = BENCH_SEED;
+        for (int p = 0; p < ctx.width * ctx.height * 3; p++) {
+            ctx.rgb[p] = (uint8_t)bench_random(&state);
+        }
+        
+        char params[32];
+        snprintf(params, sizeof(params), "%dx%d", ctx.width, ctx.height);
+        bench_run(runner, "rgb_to_yuv420", params, 1, rgb_to_yuv_iteration, &ctx);
+        
+        free(ctx.yuv);
+        free(ctx.rgb);
+    }
+}
+
+// Throughput of the encoder's pipe path into a process that discards its input
+typedef struct {
+    FILE* pipe;
+    uint8_t* frame;
+    int frame_size;
+} PipeContext;
+
+static void pipe_write_iteration(void* context) {
+    PipeContext* ctx = (PipeContext*)context;
+    for (int i = 0; i < 60; i++) {
+        fwrite(ctx->frame, ctx->frame_size, 1, ctx->pipe);
+    }
+    fflush(ctx->pipe);
+}
+
+static void bench_pipe_write(BenchRunner* runner) {
+    if (!bench_selected(runner, "pipe_write")) return;
+    
+    PipeContext ctx;
+    ctx.frame_size = encoder_yuv420_size(720, 1280);
+    ctx.frame = (uint8_t*)calloc(1, ctx.frame_size);
+    
+#ifdef _WIN32
+    ctx.pipe = _popen("more > NUL", "wb");
+#else
+    ctx.pipe = popen("cat > /dev/null", "w");
+#endif
+    
+    if (ctx.pipe && ctx.frame) {
+        bench_run(runner, "pipe_write", "720x1280 yuv420p", 60, pipe_write_iteration, &ctx);
+    } else {
+        fprintf(stderr, "Skipping pipe_write: cannot open null sink\n");
+    }
+    
+    if (ctx.pipe) {
+#ifdef _WIN32
+        _pclose(ctx.pipe);
+#else
+        pclose(ctx.pipe);
+#endif
+    }
+    free(ctx.frame);
+}
+
+// Helper: Time a benchmark and append its result object
+static void bench_run(BenchRunner* runner, const char* name, const char* params,
+                      double items_per_iteration, BenchFunction function, void* context) {
+    if (!bench_selected(runner, name)) return;
+    
+    double* samples = (double*)malloc(runner->repeat * sizeof(double));
+    if (!samples) return;
+    
+    // Warm caches and lazily created state
+    function(context);
+    
+    double total = 0.0;
+    for (int i = 0; i < runner->repeat; i++) {
+        uint64_t start = trace_now_ns();
+        function(context);
+        samples[i] = (double)(trace_now_ns() - start);
+        total += samples[i];
+    }
+    
+    qsort(samples, runner->repeat, sizeof(double), compare_doubles);
+    double median = samples[runner->repeat / 2];
+    double mean = total / runner->repeat;
+    
+    fprintf(runner->out,
+        "%s\n    {\"name\": \"%s\", \"params\": \"%s\", \"iterations\": %d, "
+        "\"min_ns\": %.0f, \"median_ns\": %.0f, \"mean_ns\": %.0f, \"max_ns\": %.0f, "
+        "\"items_per_second\": %.1f}",
+        runner->result_count > 0 ? "," : "",
+        name, params, runner->repeat,
+        samples[0], median, mean, samples[runner->repeat - 1],
+        median > 0 ? items_per_iteration * 1e9 / median : 0.0);
+    fflush(runner->out);
+    runner->result_count++;
+    
+    free(samples);
+}
+
+// Helper: Check a benchmark name against --filter
+static bool bench_selected(BenchRunner* runner, const char* name) {
+    return !runner->filter || strstr(name, runner->filter) != NULL;
+}
+
+// Helper: qsort comparator for timing samples
+static int compare_doubles(const void* a, const void* b) {
+    double da = *(const double*)a;
+    double db = *(const double*)b;
+    return (da > db) - (da < db);
+}
+
+// Helper: Deterministic random numbers for benchmark inputs
+static unsigned int bench_random(unsigned int* state) {
+    *state = (*state * 1103515245 + 12345) & 0x7fffffff;
+    return *state >> 8;
+}
+
+// Helper: Generated maze with a fixed seed
+static Maze* bench_create_maze(int width, int height) {
+    Maze* maze = maze_create(width, height, 40);
+    maze_generate(maze, BENCH_SEED);
+    return maze;
+}
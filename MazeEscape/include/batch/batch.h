@@ -0,0 +1,38 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <stdbool.h>
+#include "maze_escape.h"
+
+// One video to render in batch mode
+typedef struct {
+    unsigned int seed;
+    int maze_width;
+    int maze_height;
+    char* character_types;
+    char* output_filename;
+} BatchJob;
+
+// Result of rendering one job
+typedef struct {
+    bool has_winner;
+    char winner_name[32];
+    float race_time;           // Winner's escape time, or the timeout
+    bool decided_early;        // Video cut once decided; the race was finished off-screen
+    int frame_count;
+} BatchOutcome;
+
+// Called once per second of rendered video
+typedef void (*BatchProgressFunc)(void* user_data, int frame, float race_time);
+
+// Function declarations
+BatchJob* batch_load_jobs(const char* path, int* job_count);
+bool batch_parse_job(const char* line, BatchJob* job);
+void batch_clear_job(BatchJob* job);
+void batch_free_jobs(BatchJob* jobs, int job_count);
+bool batch_run(const BatchJob* jobs, int job_count, const AppSettings* settings, int worker_count);
+bool batch_render_frames(const BatchJob* job, const AppSettings* settings, Renderer* renderer,
+                         VideoEncoder* encoder, Arena* arena,
+                         BatchProgressFunc progress, void* user_data, BatchOutcome* outcome);
+
+#endif // BATCH_H
@@ -33,6 +33,7 @@ typedef struct Character {
     float size;
     float cooldown;
     float ability_cooldown_remaining;
+    int ability_uses;
     int current_cell_x;
     int current_cell_y;
     bool has_escaped;
@@ -40,9 +41,26 @@ typedef struct Character {
     CharacterState state;
     
     // Physics
+    float mass;
+    float friction;
     cpBody* body;
     cpShape* shape;
     
+    // Next cell chosen by a planner (overrides the downhill step while set)
+    bool has_target;
+    int target_cell_x;
+    int target_cell_y;
+    
+    // Per-character random stream (deterministic for a given race seed)
+    unsigned int rng_state;
+    
+    // Speed pad boost (speed is scaled while time remains)
+    float boost_multiplier;
+    float boost_remaining;
+    
+    // Owner of the character's memory (NULL = heap allocated)
+    Arena* arena;
+    
     // Animation properties
     float angle;
     float animation_frame;
@@ -56,12 +74,16 @@ typedef struct Character {
 
 // Function declarations
 Character* character_create(CharacterType type, const char* name, float x, float y);
+Character* character_create_of_type(CharacterType type, float x, float y);
+Character* character_create_in_arena(Arena* arena, CharacterType type, float x, float y);
 void character_destroy(Character* character);
+void character_attach_physics(Character* character, cpSpace* space);
 void character_update(Character* character, Maze* maze, float dt);
 void character_render(Character* character, void* renderer);
 void character_apply_force(Character* character, float force_x, float force_y);
 void character_use_ability(Character* character, Maze* maze);
 void character_check_escaped(Character* character, Maze* maze);
+void character_apply_boost(Character* character, float multiplier, float duration);
 
 // Character type-specific functions
 Character* runner_create(const char* name, float x, float y);
@@ -0,0 +1,13 @@
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#include <stdbool.h>
+#include "maze_escape.h"
+
+// Longest request or reply line on the daemon socket
+#define DAEMON_LINE_MAX 1024
+
+// Function declarations
+bool daemon_run(const char* socket_path, const char* spool_dir, const AppSettings* settings, int worker_count);
+
+#endif // DAEMON_H
@@ -0,0 +1,79 @@
+#ifndef MAZE_COOP_H
+#define MAZE_COOP_H
+
+#include <stdbool.h>
+#include "maze/maze.h"
+
+// Default planning window in steps, and the longest window supported
+#define COOP_DEFAULT_WINDOW 8
+#define COOP_MAX_WINDOW 16
+
+// Default search expansions per coop_update call
+#define COOP_DEFAULT_BUDGET 512
+
+// Space-time nodes a single plan may create
+#define COOP_MAX_NODES 2048
+
+// One planning agent: path[k] is its planned cell at clock step plan_time + k
+typedef struct {
+    int cell;              // Current cell index (x * height + y), -1 when inactive
+    int path[COOP_MAX_WINDOW + 1];
+    int plan_time;         // Clock step of path[0] (-1 = no plan)
+} CoopAgent;
+
+// A cell claimed by an agent at one clock step
+typedef struct {
+    int cell;
+    int time;
+    int agent;
+    unsigned int stamp;    // Live only while equal to the table stamp
+} CoopReservation;
+
+// Open list entry of the space-time search
+typedef struct {
+    int estimate;
+    int node;
+} CoopHeapEntry;
+
+// Windowed cooperative A* (WHCA*): every agent plans `window` steps ahead in
+// space-time (moves and waits), avoiding the cells and swaps the others have
+// reserved. The exit distance field is the heuristic, so plans are shortest
+// routes unless someone is in the way. Replans are spread across calls
+// under a fixed expansion budget.
+typedef struct {
+    Maze* maze;
+    int window;
+    int clock;             // Planning steps since creation
+    CoopAgent* agents;
+    int agent_count;
+    int next_agent;        // Round-robin replanning cursor
+    int replans;           // Plans made so far (statistics)
+    
+    // Reservation table (open addressing, cleared by bumping the stamp)
+    CoopReservation* table;
+    int table_mask;
+    unsigned int table_stamp;
+    
+    // Space-time search state, stamped so it never needs clearing
+    int* node_cell;
+    int* node_time;
+    int* node_parent;
+    int node_count;
+    int* visit_key;        // cell * (COOP_MAX_WINDOW + 1) + time
+    int* visit_node;
+    unsigned int* visit_stamp;
+    unsigned int stamp;
+    int visit_mask;
+    CoopHeapEntry* heap;
+    int heap_size;
+} MazeCoop;
+
+// Function declarations
+MazeCoop* coop_create(Maze* maze, int agent_count, int window);
+void coop_destroy(MazeCoop* coop);
+void coop_set_agent(MazeCoop* coop, int agent, int x, int y);
+void coop_advance(MazeCoop* coop);
+int coop_update(MazeCoop* coop, int budget);
+bool coop_next_cell(MazeCoop* coop, int agent, int* x, int* y);
+
+#endif // MAZE_COOP_H
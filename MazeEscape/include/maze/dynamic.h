@@ -0,0 +1,59 @@
+#ifndef MAZE_DYNAMIC_H
+#define MAZE_DYNAMIC_H
+
+#include <stdbool.h>
+#include "maze/maze.h"
+
+// Kinds of scheduled maze pieces
+typedef enum {
+    MAZE_DYNAMIC_DOOR,      // A corridor cell that closes and opens on a timer
+    MAZE_DYNAMIC_MOVER,     // A wall block sliding back and forth along a line of cells
+    MAZE_DYNAMIC_ROTOR      // A square section turned a quarter at a time
+} MazeDynamicType;
+
+// One scheduled piece
+typedef struct {
+    MazeDynamicType type;
+    int x;                  // Door cell, first track cell, or section's top-left cell
+    int y;
+    int dx;                 // Track direction (movers)
+    int dy;
+    int size;               // Track length (movers) or section side (rotors)
+    float period;           // Seconds between changes
+    float next_time;        // Clock time of the next change
+    int state;              // Door: 1 = closed; mover: block position; rotor: quarter turns
+    int step;               // Mover direction along the track (+1 / -1)
+} MazeDynamicElement;
+
+// Asked before a cell is closed; true postpones the change (e.g. a racer stands there)
+typedef bool (*MazeBlockedFunc)(void* user_data, int x, int y);
+
+// Dynamic maze layer: elements change cells on their own timers, and every
+// change due in a tick goes through maze_set_cells as one batch, so it is
+// journaled and the exit distance field, listeners and (via the journal)
+// physics update incrementally.
+struct MazeDynamic {
+    Maze* maze;
+    float time;
+    MazeDynamicElement* elements;
+    int element_count;
+    int element_capacity;
+    MazeCellChange* edits;  // Batch under construction for the current tick
+    int edit_count;
+    int edit_capacity;
+    MazeBlockedFunc blocked;
+    void* blocked_data;
+    int postponed;          // Changes delayed because a cell was blocked (statistics)
+};
+
+// Function declarations
+MazeDynamic* maze_dynamic_create(Maze* maze);
+void maze_dynamic_destroy(MazeDynamic* dynamic);
+void maze_dynamic_set_blocked(MazeDynamic* dynamic, MazeBlockedFunc func, void* user_data);
+bool maze_dynamic_add_door(MazeDynamic* dynamic, int x, int y, float period, float phase);
+bool maze_dynamic_add_mover(MazeDynamic* dynamic, int x, int y, int dx, int dy, int length, float period, float phase);
+bool maze_dynamic_add_rotor(MazeDynamic* dynamic, int x, int y, int size, float period, float phase);
+int maze_dynamic_populate(MazeDynamic* dynamic, unsigned int seed);
+int maze_dynamic_update(MazeDynamic* dynamic, float dt);
+
+#endif // MAZE_DYNAMIC_H
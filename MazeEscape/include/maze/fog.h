@@ -0,0 +1,47 @@
+#ifndef MAZE_FOG_H
+#define MAZE_FOG_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "maze/maze.h"
+
+// Cells per side of a fog tile (the unit the renderer re-uploads)
+#define FOG_TILE_SIZE 16
+
+// Default sight radius in cells
+#define FOG_DEFAULT_RADIUS 6
+
+// Fog of war: every viewer reveals the cells it can see (recursive
+// shadowcasting, walls block sight) into its own bitmap and into a shared
+// one. Field of view is recomputed only when a viewer changes cell, and
+// tiles whose shared bits changed are queued so the renderer can update
+// just those parts of its fog overlay.
+typedef struct {
+    Maze* maze;
+    int radius;
+    int viewer_count;
+    int words_per_map;      // 64-bit words per bitmap
+    uint64_t* revealed;     // Cells any viewer has seen
+    uint64_t* viewer_maps;  // viewer_count bitmaps of words_per_map words
+    int* viewer_cells;      // Cell index each viewer last looked from (-1 = recompute)
+    int revealed_count;
+    
+    // Dirty tiles since the last fog_clear_dirty
+    int tiles_x;
+    int tiles_y;
+    unsigned char* tile_dirty;
+    int* dirty_tiles;
+    int dirty_count;
+} MazeFog;
+
+// Function declarations
+MazeFog* fog_create(Maze* maze, int viewer_count, int radius);
+void fog_destroy(MazeFog* fog);
+bool fog_move_viewer(MazeFog* fog, int viewer, int x, int y);
+void fog_invalidate(MazeFog* fog);
+bool fog_is_revealed(const MazeFog* fog, int x, int y);
+bool fog_viewer_revealed(const MazeFog* fog, int viewer, int x, int y);
+void fog_mark_all_dirty(MazeFog* fog);
+void fog_clear_dirty(MazeFog* fog);
+
+#endif // MAZE_FOG_H
@@ -0,0 +1,29 @@
+#ifndef MAZE_GENERATORS_H
+#define MAZE_GENERATORS_H
+
+#include <stdbool.h>
+#include "maze/maze.h"
+
+// Carvers for the alternative algorithms. They work on a grid of node cells
+// at odd coordinates, open the passages between them in the maze's cell
+// block, and use its scratch buffer (and the not yet computed exit distance
+// field) as work space, so they allocate nothing.
+
+// Function declarations
+void maze_carve_wilson(Maze* maze, unsigned int* seed);
+void maze_carve_kruskal(Maze* maze, unsigned int* seed);
+void maze_carve_prim(Maze* maze, unsigned int* seed);
+void maze_carve_sidewinder(Maze* maze, unsigned int* seed);
+void maze_carve_binary_tree(Maze* maze, unsigned int* seed);
+int maze_braid(Maze* maze, float fraction, unsigned int seed);
+
+// Generator random numbers: a 31-bit LCG that can jump ahead in O(log n)
+unsigned int maze_random_next(unsigned int* seed);
+int maze_random_below(unsigned int* seed, int bound);
+unsigned int maze_random_jump(unsigned int seed, unsigned int steps);
+
+// Union-find over cell or node indices (parent array supplied by the caller)
+int maze_union_find_root(int* parent, int index);
+bool maze_union_find_join(int* parent, int a, int b);
+
+#endif // MAZE_GENERATORS_H
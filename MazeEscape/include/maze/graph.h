@@ -0,0 +1,52 @@
+#ifndef MAZE_GRAPH_H
+#define MAZE_GRAPH_H
+
+#include <stdbool.h>
+#include "maze/maze.h"
+
+// Open list entry of graph searches
+typedef struct {
+    int distance;
+    int node;
+} MazeGraphHeapEntry;
+
+// The maze collapsed to junctions, dead ends and the exit (nodes), joined by
+// corridors weighted with their length in steps (edges). Edges are stored
+// in CSR form, once per direction. Every corridor cell remembers which edge
+// covers it and how far along, so cells map onto the graph in O(1).
+typedef struct {
+    Maze* maze;
+    bool dirty;            // Rebuilt before the next query
+    int node_count;
+    int edge_count;
+    int* node_cell;        // Cell index (x * height + y) of each node
+    int* edge_offsets;     // Edges of node n are [edge_offsets[n], edge_offsets[n + 1])
+    int* edge_sources;
+    int* edge_targets;
+    int* edge_weights;     // Corridor length in steps
+    int* edge_reverse;     // The same corridor walked the other way
+    unsigned char* edge_dirs; // First step from the source node (north, east, south, west)
+    int* cell_node;        // Node of each cell, or -1
+    int* cell_edge;        // Edge covering each corridor cell, or -1
+    int* cell_offset;      // Steps from that edge's source node
+    int node_capacity;
+    int edge_capacity;
+    
+    // Search state
+    int* distance;
+    int* parent_edge;
+    MazeGraphHeapEntry* heap;
+    int heap_size;
+    int heap_capacity;
+} MazeGraph;
+
+// Function declarations
+MazeGraph* maze_graph_create(Maze* maze);
+void maze_graph_destroy(MazeGraph* graph);
+bool maze_graph_update(MazeGraph* graph);
+int maze_graph_distance(MazeGraph* graph, int start_x, int start_y, int goal_x, int goal_y);
+bool maze_graph_find_path(MazeGraph* graph, int start_x, int start_y, int goal_x, int goal_y,
+                          int** path, int* path_length);
+void maze_graph_distance_field(MazeGraph* graph, int x, int y, int* cell_distance);
+
+#endif // MAZE_GRAPH_H
@@ -0,0 +1,71 @@
+#ifndef MAZE_HPA_H
+#define MAZE_HPA_H
+
+#include <stdbool.h>
+#include "maze/maze.h"
+
+// Default sector edge length in cells
+#define HPA_DEFAULT_SECTOR_SIZE 32
+
+// A border cell with an open neighbour in the next sector
+typedef struct {
+    int x;
+    int y;
+    int dir;               // Direction of the neighbour (north, east, south, west)
+} HpaPortal;
+
+// Cached abstraction of one sector
+typedef struct {
+    HpaPortal* portals;
+    int* distances;        // portal_count x portal_count steps inside the sector
+    int portal_count;
+    bool dirty;            // Rebuilt on next use
+} HpaSector;
+
+// Open list entry of the abstract search
+typedef struct {
+    int estimate;
+    int node;
+} HpaHeapEntry;
+
+// Hierarchical path planner: the maze is split into square sectors, each
+// reduced to its border portals and the distances between them. Queries
+// search the small portal graph first and only expand the chosen segments
+// into cells. Sector caches are rebuilt lazily after cell edits.
+typedef struct {
+    Maze* maze;
+    int sector_size;
+    int sectors_x;
+    int sectors_y;
+    int max_portals;       // Portal slots per sector
+    HpaSector* sectors;
+    int sector_rebuilds;   // Sectors abstracted so far (statistics)
+    
+    // Abstract search state, stamped so it never needs clearing
+    int* cost;
+    int* parent;
+    unsigned int* visit_stamp;
+    unsigned int stamp;
+    int* goal_cost;        // Steps from each goal-sector portal to the goal
+    HpaHeapEntry* heap;
+    int heap_size;
+    int heap_capacity;
+    
+    // Sector-local breadth-first search (sector_size^2 cells)
+    int* local_distance;
+    int* local_queue;
+} MazeHpa;
+
+// Function declarations
+MazeHpa* hpa_create(Maze* maze, int sector_size);
+void hpa_destroy(MazeHpa* hpa);
+void hpa_invalidate_cell(MazeHpa* hpa, int x, int y);
+bool hpa_find_waypoints(MazeHpa* hpa, int start_x, int start_y, int goal_x, int goal_y,
+                        int** waypoints, int* waypoint_count);
+bool hpa_refine_segment(MazeHpa* hpa, int from_x, int from_y, int to_x, int to_y,
+                        int** cells, int* cell_count);
+bool hpa_find_path(MazeHpa* hpa, int start_x, int start_y, int goal_x, int goal_y,
+                   int** path, int* path_length);
+void hpa_get_path_to_exit(MazeHpa* hpa, int start_x, int start_y, int** path, int* path_length);
+
+#endif // MAZE_HPA_H
@@ -3,6 +3,7 @@
 
 #include <stdbool.h>
 #include "chipmunk/chipmunk.h"
+#include "memory/arena.h"
 
 // Cell types
 typedef enum {
@@ -14,28 +15,103 @@ typedef enum {
     CELL_SPECIAL = 5
 } CellType;
 
-// Maze structure
+// Distance value for cells that cannot reach the exit
+#define MAZE_UNREACHABLE -1
+
+// A cell edit made after generation (broken wall, etc.)
 typedef struct {
+    int x;
+    int y;
+    CellType old_type;
+    CellType new_type;
+} MazeCellChange;
+
+// Passage carving algorithms (all produce perfect mazes before extras are added)
+typedef enum {
+    MAZE_ALGORITHM_BACKTRACKER = 0, // Long winding corridors (default)
+    MAZE_ALGORITHM_WILSON,          // Uniform spanning tree, unbiased
+    MAZE_ALGORITHM_KRUSKAL,         // Many short dead ends
+    MAZE_ALGORITHM_PRIM,            // Radial, short corridors
+    MAZE_ALGORITHM_SIDEWINDER,      // Row by row, open top corridor
+    MAZE_ALGORITHM_BINARY_TREE,     // Row by row, open top row and left column
+    MAZE_ALGORITHM_COUNT
+} MazeAlgorithm;
+
+// Most change listeners attached to one maze
+#define MAZE_MAX_LISTENERS 4
+
+typedef struct Maze Maze;
+
+// Scheduled cell changes (doors, moving walls, rotating sections), see maze/dynamic.h
+typedef struct MazeDynamic MazeDynamic;
+
+// Floor types and weighted costs to the exit, see maze/terrain.h
+typedef struct MazeTerrain MazeTerrain;
+
+// Called after cells change (path caches, physics, renderers)
+typedef void (*MazeChangeFunc)(Maze* maze, const MazeCellChange* changes, int change_count, void* user_data);
+
+typedef struct {
+    MazeChangeFunc func;
+    void* user_data;
+} MazeListener;
+
+// Maze structure
+struct Maze {
     int width;
     int height;
-    CellType** cells;
+    CellType** cells;      // Column pointers into one contiguous cell block
     int* start_positions;  // [x1, y1, x2, y2, ...] for multiple characters
     int exit_x;
     int exit_y;
+    int repaired_cells;    // Walls opened by generation to join the entrance to the exit
     int cell_size;         // Size in pixels
     cpSpace* physics_space; // Chipmunk physics space reference
-} Maze;
+    cpShape** cell_shapes; // Collider per cell (NULL = none), set by maze_add_physics_bodies
+    int* exit_distance;    // Steps to the exit per cell, index x * height + y
+    int* scratch;          // Per-cell work buffer for searches (width * height)
+    Arena* arena;          // Owner of all maze memory (NULL = heap allocated)
+    
+    // Journal of cell edits since the last maze_clear_changes
+    MazeCellChange* changes;
+    int change_count;
+    int change_capacity;
+    
+    // Notified of every edit made through maze_set_cell(s) / maze_break_wall
+    MazeListener listeners[MAZE_MAX_LISTENERS];
+    int listener_count;
+    
+    // Advanced by maze_update (NULL = static maze)
+    MazeDynamic* dynamic;
+    
+    // Mud, ice and conveyors; kept in step with cell edits (NULL = uniform floor)
+    MazeTerrain* terrain;
+};
 
 // Function declarations
 Maze* maze_create(int width, int height, int cell_size);
+Maze* maze_create_in_arena(Arena* arena, int width, int height, int cell_size);
 void maze_generate(Maze* maze, unsigned int seed);
+void maze_generate_with(Maze* maze, unsigned int seed, MazeAlgorithm algorithm);
+const char* maze_algorithm_name(MazeAlgorithm algorithm);
+bool maze_algorithm_parse(const char* name, MazeAlgorithm* algorithm);
+int maze_connect_to_exit(Maze* maze, int x, int y);
 void maze_destroy(Maze* maze);
 bool maze_is_wall(Maze* maze, int x, int y);
 void maze_set_cell(Maze* maze, int x, int y, CellType type);
+int maze_set_cells(Maze* maze, const MazeCellChange* edits, int edit_count);
 CellType maze_get_cell(Maze* maze, int x, int y);
 void maze_add_physics_bodies(Maze* maze, cpSpace* space);
+void maze_sync_physics(Maze* maze, const MazeCellChange* changes, int change_count);
 void maze_break_wall(Maze* maze, int x, int y);
 void maze_update(Maze* maze, float dt);
 void maze_get_path_to_exit(Maze* maze, int start_x, int start_y, int** path, int* path_length);
+void maze_compute_distance_field(Maze* maze);
+void maze_relax_distance_field(Maze* maze, int x, int y);
+void maze_raise_distance_field(Maze* maze, int x, int y);
+void maze_clear_changes(Maze* maze);
+int maze_get_exit_distance(Maze* maze, int x, int y);
+bool maze_add_listener(Maze* maze, MazeChangeFunc func, void* user_data);
+void maze_remove_listener(Maze* maze, MazeChangeFunc func, void* user_data);
 
 #endif // MAZE_H
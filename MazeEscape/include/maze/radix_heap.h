@@ -0,0 +1,35 @@
+#ifndef MAZE_RADIX_HEAP_H
+#define MAZE_RADIX_HEAP_H
+
+#include <stdbool.h>
+
+// Buckets of a radix heap: one for keys equal to the last popped key, then
+// one per bit length of (key ^ last)
+#define RADIX_HEAP_BUCKETS 33
+
+// An entry: non-negative integer key and the cell or node it belongs to
+typedef struct {
+    unsigned int key;
+    int value;
+} RadixHeapEntry;
+
+// Monotone priority queue for Dijkstra over integer costs: keys pushed are
+// never below the last key popped. Entries sit in the bucket of the highest
+// bit where they differ from that key, and each pop empties at most one
+// bucket into lower ones, so an entry moves at most 32 times in its life.
+typedef struct {
+    RadixHeapEntry* buckets[RADIX_HEAP_BUCKETS];
+    int sizes[RADIX_HEAP_BUCKETS];
+    int capacities[RADIX_HEAP_BUCKETS];
+    unsigned int last;      // Last key popped (lower bound of every entry)
+    int count;
+} RadixHeap;
+
+// Function declarations
+void radix_heap_init(RadixHeap* heap);
+void radix_heap_free(RadixHeap* heap);
+void radix_heap_clear(RadixHeap* heap);
+bool radix_heap_push(RadixHeap* heap, unsigned int key, int value);
+bool radix_heap_pop(RadixHeap* heap, RadixHeapEntry* entry);
+
+#endif // MAZE_RADIX_HEAP_H
@@ -0,0 +1,35 @@
+#ifndef MAZE_RAYCAST_H
+#define MAZE_RAYCAST_H
+
+#include <stdbool.h>
+#include "maze/maze.h"
+
+// A ray in world (pixel) coordinates; the direction need not be normalised
+typedef struct {
+    float origin_x;
+    float origin_y;
+    float dir_x;
+    float dir_y;
+    float max_distance;
+} MazeRay;
+
+// Where a ray stopped
+typedef struct {
+    bool hit;              // A wall (or the maze edge) was reached within max_distance
+    int cell_x;            // Wall cell hit, or the last cell reached
+    int cell_y;
+    int normal_x;          // Face of the wall cell the ray entered (points back along the ray)
+    int normal_y;
+    float distance;        // World distance to the wall face, or max_distance
+    int cell_count;        // Open cells traversed before stopping
+} MazeRayHit;
+
+// Function declarations
+bool maze_raycast(Maze* maze, float origin_x, float origin_y, float dir_x, float dir_y, float max_distance,
+                  MazeRayHit* hit, int* cells, int max_cells);
+void maze_raycast_batch(Maze* maze, const MazeRay* rays, int ray_count, MazeRayHit* hits);
+int maze_trace_cells(Maze* maze, float origin_x, float origin_y, float dir_x, float dir_y, float max_distance,
+                     int* cells, int max_cells);
+bool maze_line_of_sight(Maze* maze, float from_x, float from_y, float to_x, float to_y);
+
+#endif // MAZE_RAYCAST_H
@@ -0,0 +1,25 @@
+#ifndef MAZE_STATS_H
+#define MAZE_STATS_H
+
+#include "maze/maze.h"
+
+// Start positions reported per maze
+#define MAZE_STATS_SPAWNS 4
+
+// Layout analytics of a generated maze
+typedef struct {
+    int open_cells;
+    int solution_length;       // Steps from the entrance to the exit (MAZE_UNREACHABLE if cut off)
+    int dead_ends;             // Open cells with one open neighbour
+    int junctions;             // Open cells with three or more
+    float branching_factor;    // Mean onward choices at a junction
+    int longest_corridor;      // Longest straight run of open cells
+    int useful_breakables;     // Breakable walls whose removal shortens a route to the exit
+    int spawn_distance[MAZE_STATS_SPAWNS]; // Steps to the exit from each start position
+} MazeStats;
+
+// Function declarations
+void maze_compute_stats(Maze* maze, MazeStats* stats);
+void maze_print_stats(const MazeStats* stats);
+
+#endif // MAZE_STATS_H
@@ -0,0 +1,59 @@
+#ifndef MAZE_TERRAIN_H
+#define MAZE_TERRAIN_H
+
+#include <stdbool.h>
+#include "maze/maze.h"
+#include "maze/radix_heap.h"
+
+// Floor types of open cells
+typedef enum {
+    TERRAIN_NORMAL = 0,
+    TERRAIN_MUD,                // Slow and grippy
+    TERRAIN_ICE,                // Fast but slippery
+    TERRAIN_CONVEYOR_UP,        // Belts push racers along one direction
+    TERRAIN_CONVEYOR_RIGHT,
+    TERRAIN_CONVEYOR_DOWN,
+    TERRAIN_CONVEYOR_LEFT,
+    TERRAIN_COUNT
+} TerrainType;
+
+// Cost of entering a normal cell (leaves room for cheaper terrain below it)
+#define TERRAIN_BASE_COST 4
+
+// How a floor type affects routes and racers
+typedef struct {
+    const char* name;
+    unsigned char cost;         // Cost to enter (doubled against a belt, halved along it)
+    float speed_scale;          // Racer top speed multiplier
+    float traction;             // Steering force multiplier (low = slides)
+    float friction_scale;       // Racer shape friction multiplier
+    int push_x;                 // Belt direction (conveyors)
+    int push_y;
+} TerrainInfo;
+
+// Terrain layer: a type byte and a cost byte per cell packed in one block,
+// and the weighted cost to the exit over them. The cost field is a
+// Dijkstra from the exit on a radix heap, which suits small integer costs:
+// every entry is moved between buckets at most 32 times, so a full update
+// stays close to linear on large mazes. The step-count exit distance field
+// is left as it is for paths, planners and scoring.
+struct MazeTerrain {
+    Maze* maze;
+    unsigned char* types;       // TerrainType per cell, index x * height + y
+    unsigned char* costs;       // Entry cost per cell (second half of the types block)
+    int* exit_cost;             // Weighted cost to the exit per cell (MAZE_UNREACHABLE if cut off)
+    RadixHeap heap;             // Reused by every cost field update
+    int terrain_cells;          // Open cells with a non-normal type
+};
+
+// Function declarations
+MazeTerrain* maze_terrain_create(Maze* maze);
+void maze_terrain_destroy(MazeTerrain* terrain);
+const TerrainInfo* maze_terrain_info(TerrainType type);
+void maze_terrain_set(MazeTerrain* terrain, int x, int y, TerrainType type);
+int maze_terrain_populate(MazeTerrain* terrain, unsigned int seed, float fraction);
+void maze_terrain_compute_costs(MazeTerrain* terrain);
+TerrainType maze_get_terrain(Maze* maze, int x, int y);
+int maze_get_exit_cost(Maze* maze, int x, int y);
+
+#endif // MAZE_TERRAIN_H
@@ -0,0 +1,41 @@
+#ifndef MAZE_TRIGGERS_H
+#define MAZE_TRIGGERS_H
+
+#include <stdbool.h>
+#include "maze/maze.h"
+
+// Power-ups behind CELL_SPECIAL cells
+typedef enum {
+    MAZE_TRIGGER_SPEED_PAD,      // Temporary speed boost
+    MAZE_TRIGGER_COOLDOWN_RESET, // Ability ready again
+    MAZE_TRIGGER_PORTAL          // Jump to the paired portal
+} MazeTriggerType;
+
+// One special cell
+typedef struct {
+    MazeTriggerType type;
+    int x;
+    int y;
+    int partner;                 // Paired portal's trigger index (-1 otherwise)
+} MazeTrigger;
+
+// Trigger table: every cell holds the index of its trigger (-1 = none), so
+// a racer entering a cell costs one lookup however many special cells the
+// maze has. Built from the CELL_SPECIAL cells after generation and kept in
+// step with the change journal.
+typedef struct {
+    Maze* maze;
+    unsigned int seed;           // Types of cells that turn special later
+    int* cell_triggers;          // width * height trigger indices
+    MazeTrigger* triggers;
+    int trigger_count;
+    int trigger_capacity;
+} MazeTriggers;
+
+// Function declarations
+MazeTriggers* maze_triggers_create(Maze* maze, unsigned int seed);
+void maze_triggers_destroy(MazeTriggers* triggers);
+const MazeTrigger* maze_triggers_at(const MazeTriggers* triggers, int x, int y);
+void maze_triggers_apply_changes(MazeTriggers* triggers, const MazeCellChange* changes, int change_count);
+
+#endif // MAZE_TRIGGERS_H
@@ -0,0 +1,34 @@
+#ifndef MAZE_CORE_H
+#define MAZE_CORE_H
+
+// Headless simulation core: maze, characters, physics, races, trajectories
+// and tracing. Nothing here depends on SDL, so tools that only simulate
+// (tests, seed search, workers) can use it without a display stack.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "chipmunk/chipmunk.h"
+#include "memory/arena.h"
+#include "memory/pool.h"
+#include "maze/maze.h"
+#include "maze/generators.h"
+#include "maze/hpa.h"
+#include "maze/graph.h"
+#include "maze/coop.h"
+#include "maze/fog.h"
+#include "maze/dynamic.h"
+#include "maze/raycast.h"
+#include "maze/radix_heap.h"
+#include "maze/terrain.h"
+#include "maze/triggers.h"
+#include "maze/stats.h"
+#include "characters/character.h"
+#include "physics/physics.h"
+#include "simulation/simulation.h"
+#include "simulation/timelapse.h"
+#include "trajectory/trajectory.h"
+#include "trace/trace.h"
+
+#endif // MAZE_CORE_H
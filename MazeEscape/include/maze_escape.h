@@ -1,19 +1,22 @@
 #ifndef MAZE_ESCAPE_H
 #define MAZE_ESCAPE_H
 
-#include <stdio.h>
-#include <stdlib.h>
-#include <stdbool.h>
 #include <time.h>
-#include <string.h>
 #include <SDL.h>
-#include "chipmunk/chipmunk.h"
-#include "maze/maze.h"
-#include "characters/character.h"
-#include "physics/physics.h"
+#include "maze_core.h"
 #include "rendering/renderer.h"
 #include "video/encoder.h"
 
+// Most extra outputs per run (--view)
+#define APP_MAX_VIEWS 4
+
+// Extra output video cut from the same frames as the main one
+typedef struct {
+    const char* output_filename;
+    int width;
+    int height;
+} AppView;
+
 // Application settings
 typedef struct {
     int maze_width;
@@ -22,12 +25,35 @@ typedef struct {
     char* character_types;
     int simulation_duration;
     unsigned int random_seed;
+    MazeAlgorithm maze_algorithm; // Passage carving algorithm (--algorithm)
+    float braid_fraction;  // Share of dead ends opened into loops (--braid)
+    bool cooperative;      // Racers plan around each other's next cells (--cooperative)
+    int fog_radius;        // Racers reveal the maze within this many cells (--fog, 0 = off)
+    bool dynamic_maze;     // Doors, sliding walls and rotating junctions (--dynamic)
+    float terrain_fraction; // Share of the floor covered by mud, ice and belts (--terrain)
+    bool early_stop;       // Search and batch skip the tail of decided races (--early-stop)
     char* output_filename;
     int video_width;
     int video_height;
     int fps;
+    AppView views[APP_MAX_VIEWS]; // Extra outputs, e.g. 1:1 and 16:9 next to the 9:16 video (--view)
+    int view_count;
     float zoom_level;
     bool debug_mode;
+    bool offline_mode;     // Fixed 1/fps steps, no vsync, no frame delay
+    int timelapse_speedup; // Most race steps per output frame in dull stretches (--timelapse, 1 = off)
+    char* batch_file;      // Job list for batch mode (NULL for a single run)
+    int worker_count;      // Concurrent batch jobs / search workers (0 = one per CPU)
+    int search_count;      // Seeds to score in search mode (0 = no search)
+    int top_count;         // Seeds printed by search mode
+    int min_solution;      // Search skips mazes with a shorter solution (0 = no limit)
+    int min_shortcuts;     // Search skips mazes with fewer useful breakable walls (0 = no limit)
+    int max_spawn_spread;  // Search skips mazes whose spawns differ more in exit distance (-1 = no limit)
+    char* record_file;     // Trajectory to record during a single run
+    char* replay_file;     // Trajectory to render instead of simulating
+    char* trace_file;      // Chrome trace of per-phase frame timings (NULL = off)
+    char* daemon_socket;   // UNIX socket to serve render jobs on (NULL = no daemon)
+    char* spool_dir;       // Where daemon workers pre-start their encoders
 } AppSettings;
 
 // Global declarations
@@ -38,5 +64,9 @@ void parse_arguments(int argc, char* argv[]);
 void initialize_simulation(void);
 void run_simulation(void);
 void cleanup_simulation(void);
+bool run_batch(void);
+bool run_search(void);
+bool run_replay(void);
+bool run_daemon(void);
 
 #endif // MAZE_ESCAPE_H
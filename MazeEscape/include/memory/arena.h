@@ -0,0 +1,26 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// Linear (bump) allocator. Allocations are never freed one by one; the whole
+// arena is reset in O(1) and its blocks are reused by the next run.
+typedef struct ArenaBlock ArenaBlock;
+
+typedef struct Arena {
+    ArenaBlock* first;
+    ArenaBlock* current;
+    size_t block_size;     // Size of new blocks (larger requests get their own block)
+} Arena;
+
+// Function declarations
+Arena* arena_create(size_t block_size);
+void arena_destroy(Arena* arena);
+void* arena_alloc(Arena* arena, size_t size);
+void* arena_calloc(Arena* arena, size_t count, size_t size);
+void* arena_grow(Arena* arena, void* data, size_t old_size, size_t new_size);
+char* arena_strdup(Arena* arena, const char* text);
+void arena_reset(Arena* arena);
+size_t arena_capacity(const Arena* arena);
+
+#endif // ARENA_H
@@ -0,0 +1,27 @@
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+
+// Per-thread size-class pool used for Chipmunk's allocations. The build maps
+// Chipmunk's cpcalloc/cprealloc/cpfree to these functions, so spaces, bodies,
+// shapes and arbiters created and freed on a worker thread recycle the same
+// blocks from run to run instead of going through malloc/free.
+//
+// Blocks larger than the biggest size class fall back to malloc. Memory
+// freed on another thread joins that thread's free lists.
+
+// Pool counters for the calling thread
+typedef struct {
+    size_t chunk_bytes;    // Bytes of chunks carved into size-class blocks
+    size_t system_allocs;  // malloc/realloc calls made (chunks and large blocks)
+} PoolStats;
+
+// Function declarations
+void* pool_calloc(size_t count, size_t size);
+void* pool_realloc(void* data, size_t size);
+void pool_free(void* data);
+void pool_get_stats(PoolStats* stats);
+void pool_release_thread(void);
+
+#endif // POOL_H
@@ -28,6 +28,7 @@ void physics_update(cpSpace* space, float dt);
 cpBody* physics_create_static_body(cpSpace* space);
 cpBody* physics_create_dynamic_body(cpSpace* space, float mass, float moment, float x, float y);
 cpShape* physics_add_box(cpSpace* space, cpBody* body, float width, float height, float friction, CollisionType type);
+cpShape* physics_add_box_at(cpSpace* space, cpBody* body, float x, float y, float width, float height, float friction, CollisionType type);
 cpShape* physics_add_circle(cpSpace* space, cpBody* body, float radius, float friction, CollisionType type);
 void physics_apply_impulse(cpBody* body, float impulse_x, float impulse_y);
 void physics_apply_force(cpBody* body, float force_x, float force_y);
@@ -4,6 +4,7 @@
 #include <SDL.h>
 #include "../maze/maze.h"
 #include "../characters/character.h"
+#include "../simulation/simulation.h"
 
 // Colors
 typedef struct {
@@ -38,33 +39,59 @@ typedef enum {
     TEXTURE_COUNT
 } TextureID;
 
+// Particle pool entry (defined in renderer.c)
+typedef struct Particle Particle;
+
 // Renderer structure
 typedef struct {
-    SDL_Window* window;
+    SDL_Window* window;           // NULL for headless renderers
     SDL_Renderer* sdl_renderer;
+    SDL_Surface* target_surface;  // Software render target for headless renderers
+    SDL_Surface* readback_surface; // Last frame read back from a window (renderer_read_frame)
     SDL_Texture* textures[TEXTURE_COUNT];
     int screen_width;
     int screen_height;
     float camera_x;
     float camera_y;
     float camera_zoom;
+    float time;            // Simulation clock in seconds, drives animations
+    SDL_Rect hud_area;     // Where banners and debug info go (the part every output keeps)
     bool show_debug;
+    
+    // Fog overlay: one texel per maze cell, updated tile by tile from the fog's dirty queue
+    SDL_Texture* fog_texture;
+    int fog_width;
+    int fog_height;
+    
+    // Particle pool, owned per renderer so workers can render in parallel
+    Particle* particles;
+    int next_particle;
+    unsigned int rng_state;
 } Renderer;
 
 // Function declarations
-Renderer* renderer_create(int width, int height, const char* title);
+Renderer* renderer_create(int width, int height, const char* title, bool vsync);
+Renderer* renderer_create_headless(int width, int height);
 void renderer_destroy(Renderer* renderer);
 void renderer_clear(Renderer* renderer, Color background);
 void renderer_present(Renderer* renderer);
+SDL_Surface* renderer_read_frame(Renderer* renderer);
 void renderer_load_textures(Renderer* renderer);
 void renderer_set_camera(Renderer* renderer, float x, float y, float zoom);
+void renderer_set_time(Renderer* renderer, float time);
+void renderer_set_hud_area(Renderer* renderer, const SDL_Rect* area);
+void renderer_reset(Renderer* renderer, unsigned int seed);
 void renderer_draw_maze(Renderer* renderer, Maze* maze);
+void renderer_draw_fog(Renderer* renderer, MazeFog* fog);
 void renderer_draw_character(Renderer* renderer, Character* character);
 void renderer_draw_debug_info(Renderer* renderer, int fps, int character_count);
 void renderer_draw_text(Renderer* renderer, const char* text, int x, int y, Color color, float scale);
 void renderer_add_particle_effect(Renderer* renderer, ParticleType type, float x, float y, int count);
+void renderer_add_simulation_effects(Renderer* renderer, Simulation* sim);
 void renderer_update_particles(Renderer* renderer, float dt);
+void renderer_update_animations(Renderer* renderer, Simulation* sim, float dt);
 void renderer_draw_particles(Renderer* renderer);
 void renderer_draw_celebration(Renderer* renderer, Character* winner);
+void renderer_draw_simulation(Renderer* renderer, Simulation* sim, float zoom, int fps);
 
 #endif // RENDERER_H
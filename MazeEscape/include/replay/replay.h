@@ -0,0 +1,14 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdbool.h>
+#include "maze_escape.h"
+
+// Function declarations
+int replay_count_frames(const char* trajectory_path);
+bool replay_render_range(const char* trajectory_path, const char* output_filename,
+                         const AppSettings* settings, int first_frame, int end_frame);
+bool replay_render(const char* trajectory_path, const char* output_filename,
+                   const AppSettings* settings, int worker_count);
+
+#endif // REPLAY_H
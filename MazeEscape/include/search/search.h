@@ -0,0 +1,34 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include <stdbool.h>
+#include "simulation/simulation.h"
+
+// Outcome of one headless race
+typedef struct {
+    unsigned int seed;
+    float score;               // Higher is more exciting
+    int lead_changes;
+    float finish_margin;       // Seconds between first and second escape
+    int ability_uses;
+    float duration;            // Seconds until the winner escaped (or timeout)
+    bool has_winner;
+    bool filtered;             // Rejected by the layout filter, never simulated
+    bool margin_estimated;     // Decided race stopped at the winner's escape; the margin is predicted
+} SearchResult;
+
+// Layout limits checked before a seed is simulated
+typedef struct {
+    int min_solution_length;   // Steps from entrance to exit (0 = no limit)
+    int min_useful_breakables; // Breakable walls that shorten a route (0 = no limit)
+    int max_spawn_spread;      // Largest difference of spawn-to-exit distances (-1 = no limit)
+} SearchFilter;
+
+// Function declarations
+bool search_filter_seed(const SimulationConfig* config, const SearchFilter* filter, Arena* arena);
+bool search_score_seed(const SimulationConfig* config, float fps, Arena* arena, SearchResult* result);
+SearchResult* search_run(const SimulationConfig* base_config, const SearchFilter* filter, int seed_count,
+                         float fps, int worker_count, int* result_count);
+void search_print_top(const SearchResult* results, int result_count, int top_count);
+
+#endif // SEARCH_H
@@ -0,0 +1,106 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <stdbool.h>
+#include "chipmunk/chipmunk.h"
+#include "../maze/maze.h"
+#include "../maze/coop.h"
+#include "../maze/fog.h"
+#include "../maze/triggers.h"
+#include "../characters/character.h"
+
+// Maximum number of racers (one per maze start position)
+#define SIMULATION_MAX_CHARACTERS 4
+
+// Kinds of things a step can report to renderers and recorders
+typedef enum {
+    SIM_EVENT_EFFECT,        // Visual effect at a world position
+    SIM_EVENT_CELL_CHANGE    // Maze cell changed type
+} SimulationEventType;
+
+// Visual effects (mapped to particle types by the renderer)
+typedef enum {
+    SIM_EFFECT_DUST,
+    SIM_EFFECT_SPARK,
+    SIM_EFFECT_CELEBRATION,
+    SIM_EFFECT_TELEPORT
+} SimulationEffect;
+
+// Something that happened during the last step
+typedef struct {
+    SimulationEventType type;
+    int kind;                     // SimulationEffect or new CellType
+    float x;                      // World position (effects)
+    float y;
+    int cell_x;                   // Cell (maze edits)
+    int cell_y;
+    int count;                    // Particle count (effects)
+} SimulationEvent;
+
+// Parameters for a single race
+typedef struct {
+    int maze_width;
+    int maze_height;
+    int cell_size;
+    const char* character_types;  // Comma-separated, e.g. "runner,smasher"
+    int simulation_duration;      // Seconds before the race times out
+    unsigned int random_seed;
+    MazeAlgorithm maze_algorithm; // Passage carving algorithm (default backtracker)
+    float braid_fraction;         // Share of dead ends opened into loops (0 = perfect maze)
+    bool cooperative;             // Racers reserve their next cells and plan around each other
+    int fog_radius;               // Sight radius in cells for fog of war (0 = whole maze visible)
+    bool dynamic_maze;            // Doors, sliding walls and rotating junctions change the maze
+    float terrain_fraction;       // Share of the floor covered by mud, ice and conveyors (0 = plain floor)
+    bool stop_when_decided;       // Stop running once the winner looks settled...
+    float decided_epilogue;       // ...after this many more seconds (simulation_finish gives the result)
+} SimulationConfig;
+
+// State of a single race: maze, physics space and racers
+typedef struct {
+    SimulationConfig config;
+    Arena* arena;                 // Memory of the maze, racers and events (NULL = heap)
+    bool owns_arena;              // Arena is freed by simulation_destroy
+    Maze* maze;
+    cpSpace* physics_space;
+    Character** characters;
+    int character_count;
+    Character* winner;
+    int escaped_count;
+    int leader_index;             // Racer closest to the exit (-1 before the first step)
+    int lead_changes;
+    float time;
+    bool running;
+    bool verbose;                 // Print winner / timeout messages
+    
+    // Outcome prediction, refreshed every step
+    float predicted_finish[SIMULATION_MAX_CHARACTERS]; // Estimated escape time per racer (-1 = cannot reach the exit)
+    int predicted_winner;         // Racer expected to escape first (-1 = none)
+    float decided_time;           // Race clock when that racer's lead looked settled (-1 = open race)
+    
+    // Cooperative planning (NULL unless config.cooperative)
+    MazeCoop* coop;
+    float coop_step_time;         // Seconds per planning step (one cell at mean racer speed)
+    float coop_elapsed;
+    
+    // Fog of war, one viewer per racer (NULL unless config.fog_radius > 0)
+    MazeFog* fog;
+    
+    // Power-ups on the special cells, checked when a racer changes cell
+    MazeTriggers* triggers;
+    int triggers_fired;
+    
+    // Events produced by the last simulation_step
+    SimulationEvent* events;
+    int event_count;
+    int event_capacity;
+} Simulation;
+
+// Function declarations
+Simulation* simulation_create(const SimulationConfig* config);
+Simulation* simulation_create_in_arena(const SimulationConfig* config, Arena* arena);
+void simulation_destroy(Simulation* sim);
+void simulation_step(Simulation* sim, float dt);
+void simulation_finish(Simulation* sim, float dt);
+void simulation_push_event(Simulation* sim, const SimulationEvent* event);
+
+#endif // SIMULATION_H
@@ -0,0 +1,37 @@
+#ifndef TIMELAPSE_H
+#define TIMELAPSE_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include "simulation.h"
+
+// Time-lapse of an offline render: every simulated step gets an activity
+// score (leader progress, events, racer motion), and dull stretches run
+// several steps per output frame, so those frames are never drawn or
+// encoded. The race clock of every output frame goes to a map file, so
+// overlays added later can line up with the video.
+typedef struct {
+    int max_speedup;            // Most simulated steps per output frame
+    int speedup;                // Steps per output frame in use
+    int ramp_frames;            // Frames spent at the current speed-up while it may rise
+    float activity;             // Smoothed activity score (0 = nothing happening)
+    float progress;             // Smoothed leader progress rate (1 = full speed towards the exit)
+    float event_level;          // Held for a moment after an event (1 = just happened)
+    int leader_index;           // Leader at the previous step
+    int leader_distance;        // Its exit distance at the previous step (-1 = unknown)
+    int lead_changes;
+    float frame_dt;             // Seconds per output frame
+    int frame_count;            // Output frames mapped so far
+    int step_count;             // Simulated steps measured so far
+    FILE* map_file;             // CSV of output time to race time (NULL = not kept)
+    bool failed;
+} TimeLapse;
+
+// Function declarations
+TimeLapse* timelapse_open(int max_speedup, int fps, const char* map_path);
+bool timelapse_close(TimeLapse* lapse);
+float timelapse_measure(TimeLapse* lapse, Simulation* sim, float dt);
+int timelapse_next_speedup(TimeLapse* lapse);
+void timelapse_write_frame(TimeLapse* lapse, float sim_time);
+
+#endif // TIMELAPSE_H
@@ -0,0 +1,36 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+// A timed region of code. Zones are recorded into a buffer owned by the
+// calling thread, so recording never takes a lock; when tracing is disabled
+// a zone is a flag test and nothing else.
+typedef struct {
+    const char* name;   // Must outlive the trace (use string literals)
+    uint64_t start_ns;
+    bool active;
+} TraceZone;
+
+// Open and close a zone in the current scope:
+//   TRACE_BEGIN(zone, "physics.step");
+//   ...
+//   TRACE_END(zone);
+#define TRACE_BEGIN(zone, zone_name) TraceZone zone = trace_zone_begin(zone_name)
+#define TRACE_END(zone) trace_zone_end(&(zone))
+
+// Function declarations
+void trace_enable(bool enabled);
+bool trace_is_enabled(void);
+uint64_t trace_now_ns(void);
+void trace_set_thread_name(const char* name);
+TraceZone trace_zone_begin(const char* name);
+void trace_zone_end(TraceZone* zone);
+
+// Call these once all traced threads have finished
+bool trace_write_chrome(const char* filename);
+void trace_print_summary(void);
+void trace_shutdown(void);
+
+#endif // TRACE_H
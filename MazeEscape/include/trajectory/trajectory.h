@@ -0,0 +1,27 @@
+#ifndef TRAJECTORY_H
+#define TRAJECTORY_H
+
+#include <stdbool.h>
+#include "simulation/simulation.h"
+
+// Trajectory files store a race as its initial maze plus per-frame character
+// transforms, states and events, delta and varint coded. Replaying one
+// rebuilds the race state without Chipmunk so it can be re-rendered.
+
+typedef struct TrajectoryWriter TrajectoryWriter;
+typedef struct TrajectoryReader TrajectoryReader;
+
+// Recording
+TrajectoryWriter* trajectory_writer_open(const char* path, const Simulation* sim, int fps);
+bool trajectory_write_frame(TrajectoryWriter* writer, const Simulation* sim, bool stepped);
+bool trajectory_writer_close(TrajectoryWriter* writer);
+
+// Replay
+TrajectoryReader* trajectory_reader_open(const char* path);
+Simulation* trajectory_reader_simulation(TrajectoryReader* reader);
+int trajectory_reader_fps(const TrajectoryReader* reader);
+float trajectory_reader_frame_dt(const TrajectoryReader* reader);
+bool trajectory_read_frame(TrajectoryReader* reader);
+void trajectory_reader_close(TrajectoryReader* reader);
+
+#endif // TRAJECTORY_H
@@ -3,6 +3,7 @@
 
 #include <SDL.h>
 #include <stdbool.h>
+#include <stdint.h>
 
 // Video encoder settings
 typedef struct {
@@ -18,13 +19,18 @@ typedef struct {
 // Function declarations
 VideoEncoder* encoder_create(const char* filename, int width, int height, int fps, int bitrate);
 void encoder_destroy(VideoEncoder* encoder);
+bool encoder_set_output(VideoEncoder* encoder, const char* filename);
 bool encoder_start(VideoEncoder* encoder);
 bool encoder_encode_frame(VideoEncoder* encoder, SDL_Surface* surface);
+bool encoder_encode_region(VideoEncoder* encoder, SDL_Surface* surface, const SDL_Rect* region);
 bool encoder_encode_renderer(VideoEncoder* encoder, SDL_Renderer* renderer);
 void encoder_stop(VideoEncoder* encoder);
 bool encoder_is_recording(VideoEncoder* encoder);
 float encoder_get_duration(VideoEncoder* encoder);
 void encoder_add_text_overlay(VideoEncoder* encoder, const char* text, int x, int y, float duration);
 void encoder_add_transition_effect(VideoEncoder* encoder, const char* effect_name);
+int encoder_yuv420_size(int width, int height);
+void encoder_rgb_to_yuv420(const uint8_t* rgb, int pitch, int width, int height, uint8_t* yuv);
+bool encoder_concat_files(const char** inputs, int input_count, const char* output_filename);
 
 #endif // VIDEO_ENCODER_H
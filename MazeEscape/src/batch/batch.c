@@ -0,0 +1,330 @@
+#include "batch/batch.h"
+#include "trace/trace.h"
+#include "memory/pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Arena block size of a batch worker (large enough for big mazes in one block)
+#define BATCH_ARENA_BLOCK_SIZE (256 * 1024)
+
+// Seconds of racing shown after an early-stopped race is decided
+#define BATCH_DECIDED_EPILOGUE 3.0f
+
+// Shared work queue for the worker pool
+typedef struct {
+    const BatchJob* jobs;
+    int job_count;
+    const AppSettings* settings;
+    SDL_atomic_t next_job;
+    SDL_atomic_t failed_jobs;
+} BatchQueue;
+
+// Local function prototypes
+static int batch_worker(void* data);
+static bool batch_render_job(const BatchJob* job, int job_index, const AppSettings* settings,
+                             Renderer* renderer, VideoEncoder** encoder, Arena* arena);
+
+// Load jobs from a file: one "<seed> <width>x<height> <characters> <output>" per line
+BatchJob* batch_load_jobs(const char* path, int* job_count) {
+    *job_count = 0;
+    
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Error opening job file %s\n", path);
+        return NULL;
+    }
+    
+    int capacity = 16;
+    BatchJob* jobs = (BatchJob*)malloc(capacity * sizeof(BatchJob));
+    
+    char line[1024];
+    int line_number = 0;
+    while (jobs && fgets(line, sizeof(line), file)) {
+        line_number++;
+        
+        // Skip blank lines and comments
+        char* start = line + strspn(line, " \t\r\n");
+        if (*start == '\0' || *start == '#') continue;
+        
+        if (*job_count == capacity) {
+            capacity *= 2;
+            BatchJob* grown = (BatchJob*)realloc(jobs, capacity * sizeof(BatchJob));
+            if (!grown) {
+                batch_free_jobs(jobs, *job_count);
+                jobs = NULL;
+                break;
+            }
+            jobs = grown;
+        }
+        
+        if (batch_parse_job(start, &jobs[*job_count])) {
+            (*job_count)++;
+        } else {
+            fprintf(stderr, "%s:%d: expected '<seed> <width>x<height> <characters> <output>'\n",
+                path, line_number);
+        }
+    }
+    
+    fclose(file);
+    
+    if (!jobs) {
+        *job_count = 0;
+    }
+    return jobs;
+}
+
+// Free a job list
+void batch_free_jobs(BatchJob* jobs, int job_count) {
+    if (!jobs) return;
+    
+    for (int i = 0; i < job_count; i++) {
+        batch_clear_job(&jobs[i]);
+    }
+    free(jobs);
+}
+
+// Free the strings of one job
+void batch_clear_job(BatchJob* job) {
+    free(job->character_types);
+    free(job->output_filename);
+    job->character_types = NULL;
+    job->output_filename = NULL;
+}
+
+// Render all jobs on a pool of worker threads, each with its own renderer and encoder
+bool batch_run(const BatchJob* jobs, int job_count, const AppSettings* settings, int worker_count) {
+    if (worker_count < 1) worker_count = 1;
+    if (worker_count > job_count) worker_count = job_count;
+    
+    BatchQueue queue;
+    queue.jobs = jobs;
+    queue.job_count = job_count;
+    queue.settings = settings;
+    SDL_AtomicSet(&queue.next_job, 0);
+    SDL_AtomicSet(&queue.failed_jobs, 0);
+    
+    printf("Rendering %d jobs on %d workers\n", job_count, worker_count);
+    
+    SDL_Thread** threads = (SDL_Thread**)malloc(worker_count * sizeof(SDL_Thread*));
+    if (!threads) return false;
+    
+    int started = 0;
+    for (int i = 0; i < worker_count; i++) {
+        threads[i] = SDL_CreateThread(batch_worker, "batch_worker", &queue);
+        if (threads[i]) {
+            started++;
+        } else {
+            fprintf(stderr, "Error creating worker thread: %s\n", SDL_GetError());
+        }
+    }
+    
+    // Fall back to rendering on this thread if no worker could start
+    if (started == 0) {
+        batch_worker(&queue);
+    }
+    
+    for (int i = 0; i < worker_count; i++) {
+        if (threads[i]) {
+            SDL_WaitThread(threads[i], NULL);
+        }
+    }
+    free(threads);
+    
+    int failed = SDL_AtomicGet(&queue.failed_jobs);
+    printf("Batch complete: %d of %d jobs succeeded\n", job_count - failed, job_count);
+    return failed == 0;
+}
+
+// Helper: Worker thread - pull jobs until the queue is empty
+static int batch_worker(void* data) {
+    BatchQueue* queue = (BatchQueue*)data;
+    const AppSettings* settings = queue->settings;
+    trace_set_thread_name("batch_worker");
+    
+    // Renderer, textures and encoder buffers live for the whole batch
+    Renderer* renderer = renderer_create_headless(settings->video_width, settings->video_height);
+    if (!renderer) {
+        fprintf(stderr, "Error creating headless renderer: %s\n", SDL_GetError());
+        return 1;
+    }
+    renderer_load_textures(renderer);
+    renderer->show_debug = settings->debug_mode;
+    
+    VideoEncoder* encoder = NULL;
+    
+    // Races are built in one arena that is reset after each job
+    Arena* arena = arena_create(BATCH_ARENA_BLOCK_SIZE);
+    
+    for (;;) {
+        int index = SDL_AtomicAdd(&queue->next_job, 1);
+        if (index >= queue->job_count) break;
+        
+        if (!batch_render_job(&queue->jobs[index], index, settings, renderer, &encoder, arena)) {
+            SDL_AtomicAdd(&queue->failed_jobs, 1);
+        }
+    }
+    
+    encoder_destroy(encoder);
+    renderer_destroy(renderer);
+    arena_destroy(arena);
+    pool_release_thread();
+    return 0;
+}
+
+// Helper: Simulate and encode one job offline (fixed 1/fps steps)
+static bool batch_render_job(const BatchJob* job, int job_index, const AppSettings* settings,
+                             Renderer* renderer, VideoEncoder** encoder, Arena* arena) {
+    // Create the encoder on first use, then just retarget it
+    if (!*encoder) {
+        *encoder = encoder_create(
+            job->output_filename,
+            settings->video_width,
+            settings->video_height,
+            settings->fps,
+            5000000 // 5 Mbps bitrate
+        );
+        if (!*encoder) return false;
+    } else if (!encoder_set_output(*encoder, job->output_filename)) {
+        return false;
+    }
+    
+    if (!encoder_start(*encoder)) return false;
+    
+    BatchOutcome outcome;
+    bool ok = batch_render_frames(job, settings, renderer, *encoder, arena, NULL, NULL, &outcome);
+    
+    encoder_stop(*encoder);
+    if (!ok) return false;
+    
+    if (outcome.has_winner) {
+        printf("[job %d] seed %u: %s escaped in %.2f seconds%s\n",
+            job_index, job->seed, outcome.winner_name, outcome.race_time,
+            outcome.decided_early ? " (after the video)" : "");
+    } else {
+        printf("[job %d] seed %u: no winner after %.2f seconds\n",
+            job_index, job->seed, outcome.race_time);
+    }
+    
+    return true;
+}
+
+// Simulate one job offline (fixed 1/fps steps) and encode every frame into a
+// recording encoder. The race is built in the arena, which is reset afterwards.
+bool batch_render_frames(const BatchJob* job, const AppSettings* settings, Renderer* renderer,
+                         VideoEncoder* encoder, Arena* arena,
+                         BatchProgressFunc progress, void* user_data, BatchOutcome* outcome) {
+    SimulationConfig config = {
+        .maze_width = job->maze_width,
+        .maze_height = job->maze_height,
+        .cell_size = settings->cell_size,
+        .character_types = job->character_types,
+        .simulation_duration = settings->simulation_duration,
+        .random_seed = job->seed,
+        .maze_algorithm = settings->maze_algorithm,
+        .braid_fraction = settings->braid_fraction,
+        .cooperative = settings->cooperative,
+        .fog_radius = settings->fog_radius,
+        .dynamic_maze = settings->dynamic_maze,
+        .terrain_fraction = settings->terrain_fraction,
+        .stop_when_decided = settings->early_stop,
+        .decided_epilogue = BATCH_DECIDED_EPILOGUE
+    };
+    
+    Simulation* sim = simulation_create_in_arena(&config, arena);
+    if (!sim) {
+        arena_reset(arena);
+        return false;
+    }
+    sim->verbose = false;
+    
+    renderer_reset(renderer, job->seed);
+    float frame_dt = 1.0f / settings->fps;
+    int frame = 0;
+    
+    // Dull stretches run several steps per frame, with a time map next to the video
+    TimeLapse* timelapse = NULL;
+    if (settings->timelapse_speedup > 1) {
+        char map_path[1024];
+        snprintf(map_path, sizeof(map_path), "%s.timemap", job->output_filename);
+        timelapse = timelapse_open(settings->timelapse_speedup, settings->fps, map_path);
+    }
+    
+    while (sim->running) {
+        TRACE_BEGIN(frame_zone, "frame");
+        int steps = timelapse_next_speedup(timelapse);
+        for (int step = 0; step < steps && sim->running; step++) {
+            simulation_step(sim, frame_dt);
+            renderer_add_simulation_effects(renderer, sim);
+            renderer_update_animations(renderer, sim, frame_dt);
+            timelapse_measure(timelapse, sim, frame_dt);
+        }
+        timelapse_write_frame(timelapse, sim->time);
+        renderer_draw_simulation(renderer, sim, settings->zoom_level, settings->fps);
+        encoder_encode_frame(encoder, renderer->target_surface);
+        TRACE_END(frame_zone);
+        
+        if (progress && ++frame % settings->fps == 0) {
+            progress(user_data, frame, sim->time);
+        }
+    }
+    
+    // Celebration epilogue, as in the interactive mode
+    if (sim->winner) {
+        for (int i = 0; i < 5 * settings->fps; i++) {
+            sim->time += frame_dt;
+            renderer_update_animations(renderer, sim, frame_dt);
+            timelapse_write_frame(timelapse, sim->time);
+            renderer_draw_simulation(renderer, sim, settings->zoom_level, settings->fps);
+            encoder_encode_frame(encoder, renderer->target_surface);
+            frame++;
+        }
+    }
+    
+    if (timelapse && !timelapse_close(timelapse)) {
+        fprintf(stderr, "Error writing time map for %s\n", job->output_filename);
+    }
+    
+    // A video cut once the race was decided still reports the real result:
+    // the rest of the race is simulated without drawing or encoding it
+    outcome->decided_early = !sim->winner && sim->time < config.simulation_duration;
+    if (outcome->decided_early) {
+        simulation_finish(sim, frame_dt);
+    }
+    Character* winner = sim->winner;
+    float race_time = winner ? winner->escape_time : sim->time;
+    
+    outcome->has_winner = winner != NULL;
+    outcome->winner_name[0] = '\0';
+    if (winner) {
+        snprintf(outcome->winner_name, sizeof(outcome->winner_name), "%s", winner->name);
+    }
+    outcome->race_time = race_time;
+    outcome->frame_count = frame;
+    
+    simulation_destroy(sim);
+    arena_reset(arena);
+    return true;
+}
+
+// Parse "<seed> <width>x<height> <characters> <output>"
+bool batch_parse_job(const char* line, BatchJob* job) {
+    unsigned int seed;
+    int width, height;
+    char types[256];
+    char output[512];
+    
+    if (sscanf(line, "%u %dx%d %255s %511s", &seed, &width, &height, types, output) != 5) {
+        return false;
+    }
+    if (width < 5 || height < 5) {
+        return false;
+    }
+    
+    job->seed = seed;
+    job->maze_width = width;
+    job->maze_height = height;
+    job->character_types = strdup(types);
+    job->output_filename = strdup(output);
+    return true;
+}
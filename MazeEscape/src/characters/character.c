@@ -1,5 +1,7 @@
 #include "characters/character.h"
 #include "physics/physics.h"
+#include "maze/raycast.h"
+#include "maze/terrain.h"
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
@@ -9,21 +11,52 @@ static void runner_ability(Character* self, Maze* maze);
 static void smasher_ability(Character* self, Maze* maze);
 static void climber_ability(Character* self, Maze* maze);
 static void teleporter_ability(Character* self, Maze* maze);
+static int character_random(Character* character);
+static void character_steer_to_exit(Character* character, Maze* maze);
+static void character_apply_terrain(Character* character, Maze* maze);
+static void character_init(Character* character, CharacterType type, char* name, float x, float y);
+static void runner_setup(Character* runner);
+static void smasher_setup(Character* smasher);
+static void climber_setup(Character* climber);
+static void teleporter_setup(Character* teleporter);
+
+// Ability ranges in cells
+#define ABILITY_REACH_CELLS 1.5f
+#define TELEPORT_RANGE_CELLS 3.0f
+#define TELEPORT_MAX_CELLS 16
+
+// Acceleration of a conveyor belt on the racer riding it (pixels / s^2)
+#define CONVEYOR_PUSH 300.0f
+
+// Neighbour offsets used for steering
+static const int STEER_DX[4] = {0, 1, 0, -1};
+static const int STEER_DY[4] = {-1, 0, 1, 0};
+
+// Default display names, indexed by CharacterType
+static const char* const CHARACTER_NAMES[4] = {"Runner", "Smasher", "Climber", "Teleporter"};
 
 // Base character creation function
 Character* character_create(CharacterType type, const char* name, float x, float y) {
     Character* character = (Character*)malloc(sizeof(Character));
     if (!character) return NULL;
     
+    character_init(character, type, strdup(name), x, y);
+    return character;
+}
+
+// Helper: Initialize the properties shared by every character type
+static void character_init(Character* character, CharacterType type, char* name, float x, float y) {
     // Initialize basic properties
     character->type = type;
-    character->name = strdup(name);
+    character->name = name;
+    character->arena = NULL;
     character->x = x;
     character->y = y;
     character->speed = 200.0f;
     character->size = 20.0f;
     character->cooldown = 5.0f;
     character->ability_cooldown_remaining = 0.0f;
+    character->ability_uses = 0;
     character->has_escaped = false;
     character->escape_time = 0.0f;
     character->state = STATE_IDLE;
@@ -32,22 +65,92 @@ Character* character_create(CharacterType type, const char* name, float x, float
     character->angle = 0.0f;
     character->animation_frame = 0.0f;
     character->sprite_index = 0;
+    character->rng_state = 1;
+    character->has_target = false;
+    character->target_cell_x = 0;
+    character->target_cell_y = 0;
+    character->boost_multiplier = 1.0f;
+    character->boost_remaining = 0.0f;
     
     // Set default functions
     character->use_ability = NULL;
     character->update = NULL;
     character->render = NULL;
     
-    // Physics body and shape will be initialized by specific character types
+    // Physics body and shape are created by character_attach_physics
+    character->mass = 10.0f;
+    character->friction = 0.7f;
     character->body = NULL;
     character->shape = NULL;
+}
+
+// Create the character's physics body and shape in a space
+void character_attach_physics(Character* character, cpSpace* space) {
+    if (character->body || character->shape || !space) return;
+    
+    // Create dynamic body
+    character->body = physics_create_dynamic_body(
+        space,
+        character->mass,
+        cpMomentForCircle(character->mass, 0, character->size, cpvzero),
+        character->x, character->y
+    );
+    
+    // Create circle shape
+    character->shape = physics_add_circle(
+        space,
+        character->body,
+        character->size,        // radius
+        character->friction,
+        COLLISION_CHARACTER     // collision type
+    );
+    
+    // Store character pointer in shape for collision callbacks
+    cpShapeSetUserData(character->shape, character);
+}
+
+// Create a character of the given type with its default name
+Character* character_create_of_type(CharacterType type, float x, float y) {
+    return character_create_in_arena(NULL, type, x, y);
+}
+
+// Create a character of the given type in an arena (NULL for the heap).
+// Arena characters are released with the arena; character_destroy leaves them alone.
+Character* character_create_in_arena(Arena* arena, CharacterType type, float x, float y) {
+    if (type < CHARACTER_RUNNER || type > CHARACTER_TELEPORTER) return NULL;
     
+    Character* character;
+    if (arena) {
+        character = (Character*)arena_alloc(arena, sizeof(Character));
+        if (!character) return NULL;
+        character_init(character, type, arena_strdup(arena, CHARACTER_NAMES[type]), x, y);
+        character->arena = arena;
+    } else {
+        character = character_create(type, CHARACTER_NAMES[type], x, y);
+        if (!character) return NULL;
+    }
+    
+    switch (type) {
+        case CHARACTER_RUNNER:
+            runner_setup(character);
+            break;
+        case CHARACTER_SMASHER:
+            smasher_setup(character);
+            break;
+        case CHARACTER_CLIMBER:
+            climber_setup(character);
+            break;
+        case CHARACTER_TELEPORTER:
+            teleporter_setup(character);
+            break;
+    }
     return character;
 }
 
 // Destroy a character
 void character_destroy(Character* character) {
-    if (character) {
+    // Arena characters are freed with their arena
+    if (character && !character->arena) {
         free(character->name);
         // Physics bodies and shapes are automatically cleaned up by the space
         free(character);
@@ -67,6 +170,9 @@ void character_update(Character* character, Maze* maze, float dt) {
     character->current_cell_x = (int)(character->x / maze->cell_size);
     character->current_cell_y = (int)(character->y / maze->cell_size);
     
+    // React to the floor under the new position
+    character_apply_terrain(character, maze);
+    
     // Update ability cooldown
     if (character->ability_cooldown_remaining > 0) {
         character->ability_cooldown_remaining -= dt;
@@ -75,6 +181,15 @@ void character_update(Character* character, Maze* maze, float dt) {
         }
     }
     
+    // Update speed boost
+    if (character->boost_remaining > 0) {
+        character->boost_remaining -= dt;
+        if (character->boost_remaining <= 0) {
+            character->boost_remaining = 0;
+            character->boost_multiplier = 1.0f;
+        }
+    }
+    
     // Update animation frame
     character->animation_frame += dt * 10.0f;
     if (character->animation_frame >= 4.0f) {
@@ -99,12 +214,8 @@ void character_update(Character* character, Maze* maze, float dt) {
     if (character->update) {
         character->update(character, maze, dt);
     } else {
-        // Default AI behavior: move randomly
-        if (rand() % 30 == 0) {  // Occasionally change direction
-            float force_x = ((rand() % 200) - 100) * 5.0f;
-            float force_y = ((rand() % 200) - 100) * 5.0f;
-            character_apply_force(character, force_x, force_y);
-        }
+        // Default AI behavior: head downhill on the exit distance field
+        character_steer_to_exit(character, maze);
     }
 }
 
@@ -126,6 +237,7 @@ void character_use_ability(Character* character, Maze* maze) {
     if (character->use_ability) {
         character->use_ability(character, maze);
         character->ability_cooldown_remaining = character->cooldown;
+        character->ability_uses++;
         character->state = STATE_USING_ABILITY;
     }
 }
@@ -140,166 +252,109 @@ void character_check_escaped(Character* character, Maze* maze) {
     if (character->current_cell_x == maze->exit_x && 
         character->current_cell_y == maze->exit_y) {
         character->has_escaped = true;
-        character->escape_time = 0.0f; // TODO: track global time
+        character->escape_time = 0.0f; // Stamped with the race clock by simulation_step
         character->state = STATE_ESCAPED;
     }
 }
 
+// Scale the character's speed for a while (overlapping boosts keep the
+// stronger multiplier and the longer time left)
+void character_apply_boost(Character* character, float multiplier, float duration) {
+    character->boost_multiplier = fmaxf(character->boost_multiplier, multiplier);
+    character->boost_remaining = fmaxf(character->boost_remaining, duration);
+}
+
 // Create a Runner character
 Character* runner_create(const char* name, float x, float y) {
     // Create base character
     Character* runner = character_create(CHARACTER_RUNNER, name, x, y);
+    if (runner) {
+        runner_setup(runner);
+    }
     
+    return runner;
+}
+
+// Helper: Apply Runner properties to a base character
+static void runner_setup(Character* runner) {
     // Set runner-specific properties
     runner->speed = 300.0f;  // Faster than other types
     runner->cooldown = 3.0f;
-      // Create physics body
-    if (runner->body == NULL && runner->shape == NULL && maze->physics_space) {
-        cpSpace* space = maze->physics_space;
-        
-        // Create dynamic body
-        runner->body = physics_create_dynamic_body(
-            space, 
-            10.0f,                  // mass
-            cpMomentForCircle(10.0f, 0, runner->size, cpvzero), // moment
-            x, y                    // position
-        );
-        
-        // Create circle shape
-        runner->shape = physics_add_circle(
-            space, 
-            runner->body, 
-            runner->size,          // radius
-            0.7f,                  // friction
-            COLLISION_CHARACTER    // collision type
-        );
-        
-        // Store character pointer in shape for collision callbacks
-        cpShapeSetUserData(runner->shape, runner);
-    }
+    runner->mass = 10.0f;
+    runner->friction = 0.7f;
     
     // Runner's special ability: temporary speed boost
     runner->use_ability = runner_ability;
-    
-    return runner;
 }
 
 // Create a Smasher character
 Character* smasher_create(const char* name, float x, float y) {
     // Create base character
     Character* smasher = character_create(CHARACTER_SMASHER, name, x, y);
+    if (smasher) {
+        smasher_setup(smasher);
+    }
     
+    return smasher;
+}
+
+// Helper: Apply Smasher properties to a base character
+static void smasher_setup(Character* smasher) {
     // Set smasher-specific properties
     smasher->speed = 200.0f;
     smasher->size = 25.0f;  // Larger than other types
     smasher->cooldown = 5.0f;
-      // Create physics body
-    if (smasher->body == NULL && smasher->shape == NULL && maze->physics_space) {
-        cpSpace* space = maze->physics_space;
-        
-        // Create dynamic body - smasher is heavier
-        smasher->body = physics_create_dynamic_body(
-            space, 
-            20.0f,                  // mass (heavier than others)
-            cpMomentForCircle(20.0f, 0, smasher->size, cpvzero), // moment
-            x, y                    // position
-        );
-        
-        // Create circle shape
-        smasher->shape = physics_add_circle(
-            space, 
-            smasher->body, 
-            smasher->size,          // radius
-            0.8f,                   // friction (more grippy)
-            COLLISION_CHARACTER     // collision type
-        );
-        
-        // Store character pointer in shape for collision callbacks
-        cpShapeSetUserData(smasher->shape, smasher);
-    }
+    smasher->mass = 20.0f;      // Heavier than others
+    smasher->friction = 0.8f;   // More grippy
     
     // Smasher's special ability: break walls
     smasher->use_ability = smasher_ability;
-    
-    return smasher;
 }
 
 // Create a Climber character
 Character* climber_create(const char* name, float x, float y) {
     // Create base character
     Character* climber = character_create(CHARACTER_CLIMBER, name, x, y);
+    if (climber) {
+        climber_setup(climber);
+    }
     
+    return climber;
+}
+
+// Helper: Apply Climber properties to a base character
+static void climber_setup(Character* climber) {
     // Set climber-specific properties
     climber->speed = 180.0f;  // Slower than runner
     climber->cooldown = 8.0f;
-      // Create physics body
-    if (climber->body == NULL && climber->shape == NULL && maze->physics_space) {
-        cpSpace* space = maze->physics_space;
-        
-        // Create dynamic body - climber is lighter
-        climber->body = physics_create_dynamic_body(
-            space, 
-            8.0f,                   // mass (lighter than others)
-            cpMomentForCircle(8.0f, 0, climber->size, cpvzero), // moment
-            x, y                    // position
-        );
-        
-        // Create circle shape
-        climber->shape = physics_add_circle(
-            space, 
-            climber->body, 
-            climber->size,          // radius
-            0.6f,                   // friction
-            COLLISION_CHARACTER     // collision type
-        );
-        
-        // Store character pointer in shape for collision callbacks
-        cpShapeSetUserData(climber->shape, climber);
-    }
+    climber->mass = 8.0f;       // Lighter than others
+    climber->friction = 0.6f;
     
     // Climber's special ability: climb over walls
     climber->use_ability = climber_ability;
-    
-    return climber;
 }
 
 // Create a Teleporter character
 Character* teleporter_create(const char* name, float x, float y) {
     // Create base character
     Character* teleporter = character_create(CHARACTER_TELEPORTER, name, x, y);
+    if (teleporter) {
+        teleporter_setup(teleporter);
+    }
     
+    return teleporter;
+}
+
+// Helper: Apply Teleporter properties to a base character
+static void teleporter_setup(Character* teleporter) {
     // Set teleporter-specific properties
     teleporter->speed = 150.0f;  // Slower than others
     teleporter->cooldown = 10.0f;
-      // Create physics body
-    if (teleporter->body == NULL && teleporter->shape == NULL && maze->physics_space) {
-        cpSpace* space = maze->physics_space;
-        
-        // Create dynamic body
-        teleporter->body = physics_create_dynamic_body(
-            space, 
-            7.0f,                   // mass (lightest)
-            cpMomentForCircle(7.0f, 0, teleporter->size, cpvzero), // moment
-            x, y                    // position
-        );
-        
-        // Create circle shape
-        teleporter->shape = physics_add_circle(
-            space, 
-            teleporter->body, 
-            teleporter->size,       // radius
-            0.5f,                   // friction (less grippy)
-            COLLISION_CHARACTER     // collision type
-        );
-        
-        // Store character pointer in shape for collision callbacks
-        cpShapeSetUserData(teleporter->shape, teleporter);
-    }
+    teleporter->mass = 7.0f;    // Lightest
+    teleporter->friction = 0.5f; // Less grippy
     
     // Teleporter's special ability: teleport a short distance
     teleporter->use_ability = teleporter_ability;
-    
-    return teleporter;
 }
 
 // Runner ability implementation
@@ -316,16 +371,15 @@ static void runner_ability(Character* self, Maze* maze) {
 // Smasher ability implementation
 static void smasher_ability(Character* self, Maze* maze) {
     // Find direction character is facing
-    int dx = (int)cos(self->angle);
-    int dy = (int)sin(self->angle);
+    float dx = cosf(self->angle);
+    float dy = sinf(self->angle);
     
-    // Check if there's a breakable wall in that direction
-    int target_x = self->current_cell_x + dx;
-    int target_y = self->current_cell_y + dy;
-    
-    if (maze_get_cell(maze, target_x, target_y) == CELL_BREAKABLE) {
+    // Check if the first wall in that direction is breakable and within reach
+    MazeRayHit hit;
+    if (maze_raycast(maze, self->x, self->y, dx, dy, ABILITY_REACH_CELLS * maze->cell_size, &hit, NULL, 0) &&
+        maze_get_cell(maze, hit.cell_x, hit.cell_y) == CELL_BREAKABLE) {
         // Break the wall
-        maze_break_wall(maze, target_x, target_y);
+        maze_break_wall(maze, hit.cell_x, hit.cell_y);
         
         // Apply recoil
         physics_apply_impulse(self->body, -dx * 1000.0f, -dy * 1000.0f);
@@ -335,17 +389,15 @@ static void smasher_ability(Character* self, Maze* maze) {
 // Climber ability implementation
 static void climber_ability(Character* self, Maze* maze) {
     // Find direction character is facing
-    int dx = (int)cos(self->angle);
-    int dy = (int)sin(self->angle);
-    
-    // Check if there's a wall in that direction
-    int target_x = self->current_cell_x + dx;
-    int target_y = self->current_cell_y + dy;
+    float dx = cosf(self->angle);
+    float dy = sinf(self->angle);
     
-    if (maze_is_wall(maze, target_x, target_y)) {
-        // Check if there's an empty space beyond the wall
-        int beyond_x = target_x + dx;
-        int beyond_y = target_y + dy;
+    // Check if there's a wall within reach in that direction
+    MazeRayHit hit;
+    if (maze_raycast(maze, self->x, self->y, dx, dy, ABILITY_REACH_CELLS * maze->cell_size, &hit, NULL, 0)) {
+        // Check if there's an empty space behind the face the ray entered
+        int beyond_x = hit.cell_x - hit.normal_x;
+        int beyond_y = hit.cell_y - hit.normal_y;
         
         if (!maze_is_wall(maze, beyond_x, beyond_y)) {
             // Teleport to the other side of the wall
@@ -362,28 +414,131 @@ static void climber_ability(Character* self, Maze* maze) {
 
 // Teleporter ability implementation
 static void teleporter_ability(Character* self, Maze* maze) {
-    // Teleport in the direction character is facing
-    float distance = 3.0f * maze->cell_size;
-    float target_x = self->x + cos(self->angle) * distance;
-    float target_y = self->y + sin(self->angle) * distance;
-    
-    // Convert to cell coordinates
-    int cell_x = (int)(target_x / maze->cell_size);
-    int cell_y = (int)(target_y / maze->cell_size);
-    
-    // Make sure the target is within bounds and not a wall
-    if (cell_x >= 0 && cell_x < maze->width && 
-        cell_y >= 0 && cell_y < maze->height &&
-        !maze_is_wall(maze, cell_x, cell_y)) {
-            
+    // Teleport in the direction character is facing, through walls, to the
+    // farthest open cell the line crosses within range
+    float distance = TELEPORT_RANGE_CELLS * maze->cell_size;
+    int cells[TELEPORT_MAX_CELLS * 2];
+    int count = maze_trace_cells(maze, self->x, self->y, cosf(self->angle), sinf(self->angle), distance,
+                                 cells, TELEPORT_MAX_CELLS);
+    
+    // Index 0 is the cell we're standing in
+    for (int i = count - 1; i > 0; i--) {
+        int cell_x = cells[i * 2];
+        int cell_y = cells[i * 2 + 1];
+        if (maze_is_wall(maze, cell_x, cell_y)) continue;
+        
         // Adjust to center of cell
-        target_x = (cell_x + 0.5f) * maze->cell_size;
-        target_y = (cell_y + 0.5f) * maze->cell_size;
+        float target_x = (cell_x + 0.5f) * maze->cell_size;
+        float target_y = (cell_y + 0.5f) * maze->cell_size;
         
         // Teleport
         cpBodySetPosition(self->body, cpv(target_x, target_y));
         cpBodySetVelocity(self->body, cpvzero);
         self->x = target_x;
         self->y = target_y;
+        break;
+    }
+}
+
+// Helper: Next value from the character's own random stream
+static int character_random(Character* character) {
+    character->rng_state = (character->rng_state * 1103515245 + 12345) & 0x7fffffff;
+    return (int)(character->rng_state >> 8);
+}
+
+// Helper: Match the shape's friction to the floor under the character and
+// let conveyor belts push it along
+static void character_apply_terrain(Character* character, Maze* maze) {
+    if (!character->body || character->has_escaped) return;
+    
+    const TerrainInfo* terrain = maze_terrain_info(
+        maze_get_terrain(maze, character->current_cell_x, character->current_cell_y));
+    if (character->shape) {
+        cpShapeSetFriction(character->shape, character->friction * terrain->friction_scale);
+    }
+    if (terrain->push_x || terrain->push_y) {
+        character_apply_force(character,
+            terrain->push_x * CONVEYOR_PUSH * character->mass,
+            terrain->push_y * CONVEYOR_PUSH * character->mass);
+    }
+}
+
+// Helper: Steer toward the neighbouring cell cheapest to the exit (terrain
+// costs included), or the planner's chosen cell when there is one (holding
+// position when told to wait). Mud slows the racer and ice weakens its grip.
+static void character_steer_to_exit(Character* character, Maze* maze) {
+    if (!character->body || character->has_escaped) return;
+    
+    int cx = character->current_cell_x;
+    int cy = character->current_cell_y;
+    const TerrainInfo* terrain = maze_terrain_info(maze_get_terrain(maze, cx, cy));
+    float max_speed = character->speed * character->boost_multiplier * terrain->speed_scale;
+    float gain = character->mass * 5.0f * terrain->traction;
+    int best_x = cx;
+    int best_y = cy;
+    int best_distance = maze_get_exit_cost(maze, cx, cy);
+    
+    if (character->has_target && abs(character->target_cell_x - cx) + abs(character->target_cell_y - cy) <= 1) {
+        cpVect vel = cpBodyGetVelocity(character->body);
+        float target_x = (character->target_cell_x + 0.5f) * maze->cell_size;
+        float target_y = (character->target_cell_y + 0.5f) * maze->cell_size;
+        float dx = target_x - character->x;
+        float dy = target_y - character->y;
+        float length = sqrtf(dx * dx + dy * dy);
+        
+        // Waiting: settle at the cell centre instead of pushing into the racer ahead
+        float speed = (character->target_cell_x == cx && character->target_cell_y == cy)
+            ? fminf(max_speed, length * 2.0f)
+            : max_speed;
+        float desired_x = length > 0.001f ? dx / length * speed : 0.0f;
+        float desired_y = length > 0.001f ? dy / length * speed : 0.0f;
+        character_apply_force(character,
+            (desired_x - (float)vel.x) * gain,
+            (desired_y - (float)vel.y) * gain);
+        return;
+    }
+    
+    for (int dir = 0; dir < 4; dir++) {
+        int distance = maze_get_exit_cost(maze, cx + STEER_DX[dir], cy + STEER_DY[dir]);
+        if (distance != MAZE_UNREACHABLE && 
+            (best_distance == MAZE_UNREACHABLE || distance < best_distance)) {
+            best_distance = distance;
+            best_x = cx + STEER_DX[dir];
+            best_y = cy + STEER_DY[dir];
+        }
+    }
+    
+    cpVect vel = cpBodyGetVelocity(character->body);
+    
+    if (best_x == cx && best_y == cy) {
+        // No way downhill: wander randomly, occasionally changing direction
+        if (character_random(character) % 30 == 0) {
+            float force_x = ((character_random(character) % 200) - 100) * 5.0f;
+            float force_y = ((character_random(character) % 200) - 100) * 5.0f;
+            character_apply_force(character, force_x, force_y);
+        }
+    } else {
+        // Accelerate toward the centre of the next cell at the character's speed
+        float target_x = (best_x + 0.5f) * maze->cell_size;
+        float target_y = (best_y + 0.5f) * maze->cell_size;
+        float dx = target_x - character->x;
+        float dy = target_y - character->y;
+        float length = sqrtf(dx * dx + dy * dy);
+        
+        if (length > 0.001f) {
+            float desired_x = dx / length * max_speed;
+            float desired_y = dy / length * max_speed;
+            character_apply_force(character,
+                (desired_x - (float)vel.x) * gain,
+                (desired_y - (float)vel.y) * gain);
+        }
+    }
+    
+    // Pinned against something: try the special ability
+    if (cpvlength(vel) < 5.0f) {
+        character->state = STATE_STUCK;
+        if (character->ability_cooldown_remaining <= 0) {
+            character_use_ability(character, maze);
+        }
     }
 }
@@ -0,0 +1,577 @@
+#include "daemon/daemon.h"
+#include "batch/batch.h"
+#include "trace/trace.h"
+#include "memory/pool.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+
+// The daemon needs UNIX domain sockets and poll(), which are POSIX only
+bool daemon_run(const char* socket_path, const char* spool_dir, const AppSettings* settings, int worker_count) {
+    (void)socket_path;
+    (void)spool_dir;
+    (void)settings;
+    (void)worker_count;
+    fprintf(stderr, "--daemon is not supported on Windows\n");
+    return false;
+}
+
+#else
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+// Most clients connected at once
+#define DAEMON_MAX_CLIENTS 64
+
+// Poll timeout, so signals and "shutdown" are noticed promptly
+#define DAEMON_POLL_MS 250
+
+// Arena block size of a daemon worker (same as a batch worker)
+#define DAEMON_ARENA_BLOCK_SIZE (256 * 1024)
+
+// A connected client; workers hold a reference while they report to it
+typedef struct {
+    int fd;
+    int refcount;              // Guarded by Daemon.lock
+    bool closed;               // Guarded by write_lock
+    SDL_mutex* write_lock;     // Serialises replies from the loop and the workers
+    char buffer[DAEMON_LINE_MAX];
+    size_t length;
+} DaemonClient;
+
+// A queued job and the client that submitted it
+typedef struct DaemonJob {
+    int id;
+    BatchJob job;
+    DaemonClient* client;
+    struct DaemonJob* next;
+} DaemonJob;
+
+// Daemon state shared by the accept loop and the workers
+typedef struct {
+    const AppSettings* settings;
+    const char* spool_dir;
+    SDL_mutex* lock;
+    SDL_cond* job_ready;
+    DaemonJob* head;
+    DaemonJob* tail;
+    int next_id;
+    int queued;
+    int running;
+    int completed;
+    int failed;
+    SDL_atomic_t stopping;
+} Daemon;
+
+// One warm worker: renderer, arena and an ffmpeg already waiting on a spool file
+typedef struct {
+    Daemon* daemon;
+    int index;
+    char spool_path[512];
+} DaemonWorker;
+
+// Progress context of the job being rendered
+typedef struct {
+    DaemonClient* client;
+    int id;
+} DaemonProgress;
+
+// Set by SIGINT/SIGTERM
+static volatile sig_atomic_t daemon_signalled = 0;
+
+// Local function prototypes
+static void daemon_on_signal(int signal_number);
+static int daemon_listen(const char* socket_path);
+static int daemon_worker(void* data);
+static bool daemon_prepare_spool(DaemonWorker* worker, VideoEncoder* encoder);
+static bool daemon_move_file(const char* from, const char* to);
+static void daemon_on_progress(void* user_data, int frame, float race_time);
+static void daemon_handle_line(Daemon* daemon, DaemonClient* client, char* line);
+static void daemon_send(DaemonClient* client, const char* format, ...);
+static DaemonClient* daemon_client_create(int fd);
+static void daemon_client_close(DaemonClient* client);
+static void daemon_client_release(Daemon* daemon, DaemonClient* client);
+
+// Serve render jobs on a UNIX domain socket until "shutdown", SIGINT or SIGTERM
+bool daemon_run(const char* socket_path, const char* spool_dir, const AppSettings* settings, int worker_count) {
+    if (worker_count < 1) worker_count = 1;
+    
+    Daemon daemon;
+    memset(&daemon, 0, sizeof(daemon));
+    daemon.settings = settings;
+    daemon.spool_dir = spool_dir ? spool_dir : ".";
+    daemon.next_id = 1;
+    daemon.lock = SDL_CreateMutex();
+    daemon.job_ready = SDL_CreateCond();
+    if (!daemon.lock || !daemon.job_ready) {
+        fprintf(stderr, "Error creating daemon locks: %s\n", SDL_GetError());
+        SDL_DestroyCond(daemon.job_ready);
+        SDL_DestroyMutex(daemon.lock);
+        return false;
+    }
+    
+    // A client hanging up mid-reply must not kill the daemon
+    signal(SIGPIPE, SIG_IGN);
+    signal(SIGINT, daemon_on_signal);
+    signal(SIGTERM, daemon_on_signal);
+    
+    int listener = daemon_listen(socket_path);
+    if (listener < 0) {
+        SDL_DestroyCond(daemon.job_ready);
+        SDL_DestroyMutex(daemon.lock);
+        return false;
+    }
+    
+    // Workers warm up (renderer, textures, ffmpeg) before the first job arrives
+    DaemonWorker* workers = (DaemonWorker*)calloc(worker_count, sizeof(DaemonWorker));
+    SDL_Thread** threads = (SDL_Thread**)calloc(worker_count, sizeof(SDL_Thread*));
+    int started = 0;
+    for (int i = 0; workers && threads && i < worker_count; i++) {
+        workers[i].daemon = &daemon;
+        workers[i].index = i;
+        threads[i] = SDL_CreateThread(daemon_worker, "daemon_worker", &workers[i]);
+        if (threads[i]) {
+            started++;
+        } else {
+            fprintf(stderr, "Error creating worker thread: %s\n", SDL_GetError());
+        }
+    }
+    
+    printf("Listening on %s with %d workers (spool: %s)\n", socket_path, started, daemon.spool_dir);
+    fflush(stdout);
+    
+    DaemonClient* clients[DAEMON_MAX_CLIENTS];
+    int client_count = 0;
+    struct pollfd fds[DAEMON_MAX_CLIENTS + 1];
+    
+    while (started > 0 && !daemon_signalled && !SDL_AtomicGet(&daemon.stopping)) {
+        fds[0].fd = listener;
+        fds[0].events = client_count < DAEMON_MAX_CLIENTS ? POLLIN : 0;
+        fds[0].revents = 0;
+        for (int i = 0; i < client_count; i++) {
+            fds[i + 1].fd = clients[i]->fd;
+            fds[i + 1].events = POLLIN;
+            fds[i + 1].revents = 0;
+        }
+    
+        int ready = poll(fds, client_count + 1, DAEMON_POLL_MS);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            fprintf(stderr, "Error polling daemon socket: %s\n", strerror(errno));
+            break;
+        }
+        if (ready == 0) continue;
+    
+        // Read requests before accepting, so indices in fds still match clients
+        for (int i = client_count - 1; i >= 0; i--) {
+            if (!(fds[i + 1].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+    
+            DaemonClient* client = clients[i];
+            size_t space = sizeof(client->buffer) - 1 - client->length;
+            ssize_t received = recv(client->fd, client->buffer + client->length, space, 0);
+            bool hang_up = received <= 0;
+    
+            if (!hang_up) {
+                client->length += (size_t)received;
+                client->buffer[client->length] = '\0';
+    
+                // Handle every complete line, keep the remainder for the next read
+                char* start = client->buffer;
+                char* newline;
+                while ((newline = strchr(start, '\n')) != NULL) {
+                    *newline = '\0';
+                    daemon_handle_line(&daemon, client, start);
+                    start = newline + 1;
+                }
+                client->length = strlen(start);
+                memmove(client->buffer, start, client->length + 1);
+    
+                // A full buffer without a newline can never become a valid request
+                if (client->length == sizeof(client->buffer) - 1) {
+                    daemon_send(client, "error 0 line too long\n");
+                    hang_up = true;
+                }
+            }
+    
+            if (hang_up) {
+                daemon_client_close(client);
+                daemon_client_release(&daemon, client);
+                clients[i] = clients[--client_count];
+            }
+        }
+    
+        if (fds[0].revents & POLLIN) {
+            int fd = accept(listener, NULL, NULL);
+            if (fd >= 0) {
+                // Keep the socket out of the ffmpeg processes the workers spawn
+                fcntl(fd, F_SETFD, FD_CLOEXEC);
+                DaemonClient* client = daemon_client_create(fd);
+                if (client) {
+                    clients[client_count++] = client;
+                } else {
+                    close(fd);
+                }
+            }
+        }
+    }
+    
+    // Stop the workers; each finishes the job it is rendering
+    SDL_LockMutex(daemon.lock);
+    SDL_AtomicSet(&daemon.stopping, 1);
+    SDL_CondBroadcast(daemon.job_ready);
+    SDL_UnlockMutex(daemon.lock);
+    
+    for (int i = 0; threads && i < worker_count; i++) {
+        if (threads[i]) {
+            SDL_WaitThread(threads[i], NULL);
+        }
+    }
+    free(threads);
+    free(workers);
+    
+    // Jobs nobody picked up are reported as failed
+    while (daemon.head) {
+        DaemonJob* job = daemon.head;
+        daemon.head = job->next;
+        daemon_send(job->client, "error %d daemon shutting down\n", job->id);
+        daemon_client_release(&daemon, job->client);
+        batch_clear_job(&job->job);
+        free(job);
+        daemon.failed++;
+    }
+    
+    for (int i = 0; i < client_count; i++) {
+        daemon_client_close(clients[i]);
+        daemon_client_release(&daemon, clients[i]);
+    }
+    
+    close(listener);
+    unlink(socket_path);
+    
+    printf("Daemon stopped: %d jobs completed, %d failed\n", daemon.completed, daemon.failed);
+    
+    SDL_DestroyCond(daemon.job_ready);
+    SDL_DestroyMutex(daemon.lock);
+    return started > 0;
+}
+
+// Helper: Ask the accept loop to stop
+static void daemon_on_signal(int signal_number) {
+    (void)signal_number;
+    daemon_signalled = 1;
+}
+
+// Helper: Bind and listen on a UNIX domain socket, replacing a stale one
+static int daemon_listen(const char* socket_path) {
+    struct sockaddr_un address;
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    
+    if (strlen(socket_path) >= sizeof(address.sun_path)) {
+        fprintf(stderr, "Socket path too long: %s\n", socket_path);
+        return -1;
+    }
+    strcpy(address.sun_path, socket_path);
+    
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        fprintf(stderr, "Error creating socket: %s\n", strerror(errno));
+        return -1;
+    }
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    
+    // A socket file left by a daemon that crashed would make bind() fail
+    unlink(socket_path);
+    
+    if (bind(fd, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(fd, 16) != 0) {
+        fprintf(stderr, "Error listening on %s: %s\n", socket_path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    
+    return fd;
+}
+
+// Helper: Worker thread - render queued jobs into pre-started encoders
+static int daemon_worker(void* data) {
+    DaemonWorker* worker = (DaemonWorker*)data;
+    Daemon* daemon = worker->daemon;
+    const AppSettings* settings = daemon->settings;
+    trace_set_thread_name("daemon_worker");
+    
+    snprintf(worker->spool_path, sizeof(worker->spool_path), "%s/.maze_spool_%d_%d.mp4",
+        daemon->spool_dir, (int)getpid(), worker->index);
+    
+    // Renderer, textures, arena and encoder buffers live as long as the daemon
+    Renderer* renderer = renderer_create_headless(settings->video_width, settings->video_height);
+    if (!renderer) {
+        fprintf(stderr, "Error creating headless renderer: %s\n", SDL_GetError());
+        return 1;
+    }
+    renderer_load_textures(renderer);
+    renderer->show_debug = settings->debug_mode;
+    
+    Arena* arena = arena_create(DAEMON_ARENA_BLOCK_SIZE);
+    VideoEncoder* encoder = encoder_create(
+        worker->spool_path,
+        settings->video_width,
+        settings->video_height,
+        settings->fps,
+        5000000 // 5 Mbps bitrate
+    );
+    
+    // Spawn ffmpeg now, so the first job does not wait for it
+    if (encoder) {
+        daemon_prepare_spool(worker, encoder);
+    }
+    
+    for (;;) {
+        SDL_LockMutex(daemon->lock);
+        while (!daemon->head && !SDL_AtomicGet(&daemon->stopping)) {
+            SDL_CondWait(daemon->job_ready, daemon->lock);
+        }
+        if (SDL_AtomicGet(&daemon->stopping)) {
+            SDL_UnlockMutex(daemon->lock);
+            break;
+        }
+        DaemonJob* job = daemon->head;
+        daemon->head = job->next;
+        if (!daemon->head) daemon->tail = NULL;
+        daemon->queued--;
+        daemon->running++;
+        SDL_UnlockMutex(daemon->lock);
+    
+        daemon_send(job->client, "started %d %d\n", job->id, worker->index);
+    
+        // The encoder may be cold if ffmpeg failed to start after the last job
+        bool ok = encoder && arena &&
+                  (encoder_is_recording(encoder) || daemon_prepare_spool(worker, encoder));
+    
+        BatchOutcome outcome = { 0 };
+        if (ok) {
+            DaemonProgress progress = { job->client, job->id };
+            ok = batch_render_frames(&job->job, settings, renderer, encoder, arena,
+                                     daemon_on_progress, &progress, &outcome);
+            encoder_stop(encoder);
+        }
+    
+        if (ok) {
+            ok = daemon_move_file(worker->spool_path, job->job.output_filename);
+        } else {
+            remove(worker->spool_path);
+        }
+    
+        if (!ok) {
+            daemon_send(job->client, "error %d render failed\n", job->id);
+        } else if (outcome.has_winner) {
+            daemon_send(job->client, "done %d %s %s %.2f %d\n", job->id, job->job.output_filename,
+                outcome.winner_name, outcome.race_time, outcome.frame_count);
+        } else {
+            daemon_send(job->client, "done %d %s - %.2f %d\n", job->id, job->job.output_filename,
+                outcome.race_time, outcome.frame_count);
+        }
+    
+        SDL_LockMutex(daemon->lock);
+        daemon->running--;
+        if (ok) {
+            daemon->completed++;
+        } else {
+            daemon->failed++;
+        }
+        SDL_UnlockMutex(daemon->lock);
+    
+        daemon_client_release(daemon, job->client);
+        batch_clear_job(&job->job);
+        free(job);
+    
+        // Warm up ffmpeg for the next job while the queue is idle
+        if (encoder && !SDL_AtomicGet(&daemon->stopping)) {
+            daemon_prepare_spool(worker, encoder);
+        }
+    }
+    
+    // Close the idle ffmpeg and drop its empty spool file
+    if (encoder_is_recording(encoder)) {
+        encoder_stop(encoder);
+        remove(worker->spool_path);
+    }
+    
+    encoder_destroy(encoder);
+    renderer_destroy(renderer);
+    arena_destroy(arena);
+    pool_release_thread();
+    return 0;
+}
+
+// Helper: Start ffmpeg on the worker's spool file
+static bool daemon_prepare_spool(DaemonWorker* worker, VideoEncoder* encoder) {
+    if (!encoder_set_output(encoder, worker->spool_path) || !encoder_start(encoder)) {
+        fprintf(stderr, "Error pre-starting encoder on %s\n", worker->spool_path);
+        return false;
+    }
+    return true;
+}
+
+// Helper: Move a finished video to its output path, copying across filesystems
+static bool daemon_move_file(const char* from, const char* to) {
+    if (rename(from, to) == 0) return true;
+    if (errno != EXDEV) {
+        fprintf(stderr, "Error moving %s to %s: %s\n", from, to, strerror(errno));
+        remove(from);
+        return false;
+    }
+    
+    FILE* in = fopen(from, "rb");
+    FILE* out = in ? fopen(to, "wb") : NULL;
+    bool ok = in && out;
+    
+    char buffer[64 * 1024];
+    size_t length;
+    while (ok && (length = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+        ok = fwrite(buffer, 1, length, out) == length;
+    }
+    
+    if (in) fclose(in);
+    if (out && fclose(out) != 0) ok = false;
+    remove(from);
+    
+    if (!ok) {
+        fprintf(stderr, "Error copying %s to %s\n", from, to);
+    }
+    return ok;
+}
+
+// Helper: Report rendering progress of a job to its client
+static void daemon_on_progress(void* user_data, int frame, float race_time) {
+    DaemonProgress* progress = (DaemonProgress*)user_data;
+    daemon_send(progress->client, "progress %d %d %.2f\n", progress->id, frame, race_time);
+}
+
+// Helper: Handle one request line from a client
+static void daemon_handle_line(Daemon* daemon, DaemonClient* client, char* line) {
+    // Accept CRLF line endings from interactive clients
+    size_t length = strlen(line);
+    if (length > 0 && line[length - 1] == '\r') line[--length] = '\0';
+    
+    char* start = line;
+    while (*start == ' ' || *start == '\t') start++;
+    if (*start == '\0' || *start == '#') return;
+    
+    if (strcmp(start, "ping") == 0) {
+        daemon_send(client, "pong\n");
+        return;
+    }
+    
+    if (strcmp(start, "status") == 0) {
+        SDL_LockMutex(daemon->lock);
+        int queued = daemon->queued;
+        int running = daemon->running;
+        int completed = daemon->completed;
+        int failed = daemon->failed;
+        SDL_UnlockMutex(daemon->lock);
+        daemon_send(client, "status %d %d %d %d\n", queued, running, completed, failed);
+        return;
+    }
+    
+    if (strcmp(start, "shutdown") == 0) {
+        daemon_send(client, "bye\n");
+        SDL_AtomicSet(&daemon->stopping, 1);
+        return;
+    }
+    
+    DaemonJob* job = (DaemonJob*)calloc(1, sizeof(DaemonJob));
+    if (!job || !batch_parse_job(start, &job->job)) {
+        daemon_send(client, "error 0 invalid job: %s\n", start);
+        free(job);
+        return;
+    }
+    
+    // The job keeps its client alive until the reply is sent
+    SDL_LockMutex(daemon->lock);
+    job->id = daemon->next_id++;
+    job->client = client;
+    client->refcount++;
+    if (daemon->tail) {
+        daemon->tail->next = job;
+    } else {
+        daemon->head = job;
+    }
+    daemon->tail = job;
+    daemon->queued++;
+    int id = job->id;
+    SDL_CondSignal(daemon->job_ready);
+    SDL_UnlockMutex(daemon->lock);
+    
+    daemon_send(client, "queued %d\n", id);
+}
+
+// Helper: Write one reply line; replies to a closed client are dropped
+static void daemon_send(DaemonClient* client, const char* format, ...) {
+    char line[DAEMON_LINE_MAX];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    if (length < 0) return;
+    if (length >= (int)sizeof(line)) length = (int)sizeof(line) - 1;
+    
+    SDL_LockMutex(client->write_lock);
+    int sent = 0;
+    while (!client->closed && sent < length) {
+        ssize_t written = send(client->fd, line + sent, (size_t)(length - sent), 0);
+        if (written < 0 && errno == EINTR) continue;
+        if (written <= 0) break;
+        sent += (int)written;
+    }
+    SDL_UnlockMutex(client->write_lock);
+}
+
+// Helper: Wrap an accepted connection
+static DaemonClient* daemon_client_create(int fd) {
+    DaemonClient* client = (DaemonClient*)calloc(1, sizeof(DaemonClient));
+    if (!client) return NULL;
+    
+    client->write_lock = SDL_CreateMutex();
+    if (!client->write_lock) {
+        free(client);
+        return NULL;
+    }
+    
+    client->fd = fd;
+    client->refcount = 1; // Held by the accept loop
+    return client;
+}
+
+// Helper: Close the connection; workers may still hold the struct
+static void daemon_client_close(DaemonClient* client) {
+    SDL_LockMutex(client->write_lock);
+    if (!client->closed) {
+        close(client->fd);
+        client->closed = true;
+    }
+    SDL_UnlockMutex(client->write_lock);
+}
+
+// Helper: Drop a reference and free the client with the last one
+static void daemon_client_release(Daemon* daemon, DaemonClient* client) {
+    SDL_LockMutex(daemon->lock);
+    bool last = --client->refcount == 0;
+    SDL_UnlockMutex(daemon->lock);
+    
+    if (last) {
+        daemon_client_close(client);
+        SDL_DestroyMutex(client->write_lock);
+        free(client);
+    }
+}
+
+#endif // _WIN32
@@ -1,4 +1,8 @@
 #include "maze_escape.h"
+#include "batch/batch.h"
+#include "search/search.h"
+#include "replay/replay.h"
+#include "daemon/daemon.h"
 
 // Global variables
 AppSettings app_settings = {
@@ -8,24 +12,52 @@ AppSettings app_settings = {
     .character_types = "runner,smasher,climber,teleporter",
     .simulation_duration = 30,
     .random_seed = 0,
+    .maze_algorithm = MAZE_ALGORITHM_BACKTRACKER,
+    .braid_fraction = 0.0f,
+    .cooperative = false,
+    .fog_radius = 0,
+    .dynamic_maze = false,
+    .terrain_fraction = 0.0f,
+    .early_stop = false,
     .output_filename = "maze_escape.mp4",
     .video_width = 720,
     .video_height = 1280, // 9:16 aspect ratio for TikTok
     .fps = 60,
+    .view_count = 0,
     .zoom_level = 1.0f,
-    .debug_mode = false
+    .debug_mode = false,
+    .offline_mode = false,
+    .timelapse_speedup = 1,
+    .batch_file = NULL,
+    .worker_count = 0,
+    .search_count = 0,
+    .top_count = 10,
+    .min_solution = 0,
+    .min_shortcuts = 0,
+    .max_spawn_spread = -1,
+    .record_file = NULL,
+    .replay_file = NULL,
+    .trace_file = NULL,
+    .daemon_socket = NULL,
+    .spool_dir = NULL
 };
 
 // Local variables
-static Maze* maze = NULL;
-static Character** characters = NULL;
-static int character_count = 0;
+static Simulation* simulation = NULL;
 static Renderer* renderer = NULL;
 static VideoEncoder* encoder = NULL;
-static cpSpace* physics_space = NULL;
-static bool simulation_running = true;
-static Character* winner = NULL;
-static float simulation_time = 0.0f;
+static TrajectoryWriter* recorder = NULL;
+static TimeLapse* timelapse = NULL;
+static VideoEncoder* view_encoders[APP_MAX_VIEWS];
+static SDL_Rect main_crop;
+static SDL_Rect view_crops[APP_MAX_VIEWS];
+
+// Helper: Region of a frame_width x frame_height frame centred like it, so
+// every output is a crop around the same camera
+static SDL_Rect centered_crop(int frame_width, int frame_height, int width, int height) {
+    SDL_Rect crop = {(frame_width - width) / 2, (frame_height - height) / 2, width, height};
+    return crop;
+}
 
 // Function to parse command-line arguments
 void parse_arguments(int argc, char* argv[]) {
@@ -40,10 +72,79 @@ void parse_arguments(int argc, char* argv[]) {
             app_settings.simulation_duration = atoi(argv[++i]);
         } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
             app_settings.random_seed = (unsigned int)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--algorithm") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            if (!maze_algorithm_parse(name, &app_settings.maze_algorithm)) {
+                fprintf(stderr, "Unknown maze algorithm '%s', using %s\n", name,
+                    maze_algorithm_name(app_settings.maze_algorithm));
+            }
+        } else if (strcmp(argv[i], "--braid") == 0 && i + 1 < argc) {
+            app_settings.braid_fraction = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--cooperative") == 0) {
+            app_settings.cooperative = true;
+        } else if (strcmp(argv[i], "--fog") == 0 && i + 1 < argc) {
+            app_settings.fog_radius = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--dynamic") == 0) {
+            app_settings.dynamic_maze = true;
+        } else if (strcmp(argv[i], "--terrain") == 0 && i + 1 < argc) {
+            app_settings.terrain_fraction = (float)atof(argv[++i]);
+        } else if (strcmp(argv[i], "--early-stop") == 0) {
+            app_settings.early_stop = true;
         } else if (strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
             app_settings.output_filename = argv[++i];
         } else if (strcmp(argv[i], "--debug") == 0) {
             app_settings.debug_mode = true;
+        } else if (strcmp(argv[i], "--offline") == 0) {
+            app_settings.offline_mode = true;
+        } else if (strcmp(argv[i], "--timelapse") == 0 && i + 1 < argc) {
+            app_settings.timelapse_speedup = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            app_settings.batch_file = argv[++i];
+        } else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            app_settings.worker_count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--search") == 0 && i + 1 < argc) {
+            app_settings.search_count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--top") == 0 && i + 1 < argc) {
+            app_settings.top_count = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--min-solution") == 0 && i + 1 < argc) {
+            app_settings.min_solution = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--min-shortcuts") == 0 && i + 1 < argc) {
+            app_settings.min_shortcuts = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--max-spawn-spread") == 0 && i + 1 < argc) {
+            app_settings.max_spawn_spread = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            app_settings.record_file = argv[++i];
+        } else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            app_settings.replay_file = argv[++i];
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            app_settings.trace_file = argv[++i];
+        } else if (strcmp(argv[i], "--daemon") == 0 && i + 1 < argc) {
+            app_settings.daemon_socket = argv[++i];
+        } else if (strcmp(argv[i], "--spool-dir") == 0 && i + 1 < argc) {
+            app_settings.spool_dir = argv[++i];
+        } else if (strcmp(argv[i], "--view") == 0 && i + 1 < argc) {
+            // <width>x<height>:<file>
+            const char* spec = argv[++i];
+            int width, height, offset = 0;
+            if (sscanf(spec, "%dx%d:%n", &width, &height, &offset) == 2 && offset > 0 &&
+                width > 0 && height > 0 && spec[offset] != '\0') {
+                if (app_settings.view_count < APP_MAX_VIEWS) {
+                    AppView* view = &app_settings.views[app_settings.view_count++];
+                    view->output_filename = spec + offset;
+                    view->width = width;
+                    view->height = height;
+                } else {
+                    fprintf(stderr, "Ignoring view '%s': at most %d extra outputs\n", spec, APP_MAX_VIEWS);
+                }
+            } else {
+                fprintf(stderr, "Invalid view '%s', expected <width>x<height>:<file>\n", spec);
+            }
+        } else if (strcmp(argv[i], "--resolution") == 0 && i + 1 < argc) {
+            int width, height;
+            if (sscanf(argv[++i], "%dx%d", &width, &height) == 2 && width > 0 && height > 0) {
+                app_settings.video_width = width;
+                app_settings.video_height = height;
+            }
         }
     }
     
@@ -61,68 +162,51 @@ void initialize_simulation(void) {
         exit(EXIT_FAILURE);
     }
     
-    // Create physics space
-    physics_space = physics_create_space(0.0f, 100.0f); // Low gravity for interesting physics
-    
-    // Create and generate maze
-    maze = maze_create(app_settings.maze_width, app_settings.maze_height, app_settings.cell_size);
-    maze_generate(maze, app_settings.random_seed);
-    maze->physics_space = physics_space;
-    
-    // Add physics bodies for maze walls
-    maze_add_physics_bodies(maze, physics_space);
-    
-    // Create characters based on specified types
-    char* types_copy = strdup(app_settings.character_types);
-    char* token = strtok(types_copy, ",");
-    
-    // Count how many characters we'll need
-    while (token) {
-        character_count++;
-        token = strtok(NULL, ",");
-    }
-    
-    // Allocate character array
-    characters = (Character**)malloc(character_count * sizeof(Character*));
-    
-    // Reset and create characters
-    strcpy(types_copy, app_settings.character_types);
-    token = strtok(types_copy, ",");
-    
-    int char_index = 0;
-    while (token && char_index < character_count) {
-        // Get start position from maze
-        int start_x = maze->start_positions[char_index * 2];
-        int start_y = maze->start_positions[char_index * 2 + 1];
-        
-        // Convert grid coords to pixel coords
-        float pixel_x = (start_x + 0.5f) * app_settings.cell_size;
-        float pixel_y = (start_y + 0.5f) * app_settings.cell_size;
-        
-        // Create appropriate character type
-        if (strcmp(token, "runner") == 0) {
-            characters[char_index] = runner_create("Runner", pixel_x, pixel_y);
-        } else if (strcmp(token, "smasher") == 0) {
-            characters[char_index] = smasher_create("Smasher", pixel_x, pixel_y);
-        } else if (strcmp(token, "climber") == 0) {
-            characters[char_index] = climber_create("Climber", pixel_x, pixel_y);
-        } else if (strcmp(token, "teleporter") == 0) {
-            characters[char_index] = teleporter_create("Teleporter", pixel_x, pixel_y);
-        }
-        
-        char_index++;
-        token = strtok(NULL, ",");
+    // Create the race
+    SimulationConfig config = {
+        .maze_width = app_settings.maze_width,
+        .maze_height = app_settings.maze_height,
+        .cell_size = app_settings.cell_size,
+        .character_types = app_settings.character_types,
+        .simulation_duration = app_settings.simulation_duration,
+        .random_seed = app_settings.random_seed,
+        .maze_algorithm = app_settings.maze_algorithm,
+        .braid_fraction = app_settings.braid_fraction,
+        .cooperative = app_settings.cooperative,
+        .fog_radius = app_settings.fog_radius,
+        .dynamic_maze = app_settings.dynamic_maze,
+        .terrain_fraction = app_settings.terrain_fraction
+    };
+    simulation = simulation_create(&config);
+    
+    // One frame big enough for every output, drawn once and cropped per video
+    int frame_width = app_settings.video_width;
+    int frame_height = app_settings.video_height;
+    for (int i = 0; i < app_settings.view_count; i++) {
+        if (app_settings.views[i].width > frame_width) frame_width = app_settings.views[i].width;
+        if (app_settings.views[i].height > frame_height) frame_height = app_settings.views[i].height;
     }
     
-    free(types_copy);
-    
-    // Create renderer
+    // Create renderer (offline renders never wait for the display, so skip vsync)
     renderer = renderer_create(
-        app_settings.video_width, 
-        app_settings.video_height, 
-        "Maze Escape Simulation"
+        frame_width, 
+        frame_height, 
+        "Maze Escape Simulation",
+        !app_settings.offline_mode
     );
     renderer_load_textures(renderer);
+    renderer_reset(renderer, app_settings.random_seed);
+    renderer->show_debug = app_settings.debug_mode;
+    
+    // Banners go where every output can show them
+    main_crop = centered_crop(frame_width, frame_height, app_settings.video_width, app_settings.video_height);
+    SDL_Rect hud_area = main_crop;
+    for (int i = 0; i < app_settings.view_count; i++) {
+        AppView* view = &app_settings.views[i];
+        view_crops[i] = centered_crop(frame_width, frame_height, view->width, view->height);
+        SDL_IntersectRect(&hud_area, &view_crops[i], &hud_area);
+    }
+    renderer_set_hud_area(renderer, &hud_area);
     
     // Create video encoder
     encoder = encoder_create(
@@ -133,97 +217,49 @@ void initialize_simulation(void) {
         5000000 // 5 Mbps bitrate
     );
     
-    // Register collision handlers
-    physics_register_collision_handlers(physics_space);
-    
     // Start video recording
     encoder_start(encoder);
-}
-
-// Function to update simulation
-void update_simulation(float dt) {
-    // Update physics
-    physics_update(physics_space, dt);
-    
-    // Update maze
-    maze_update(maze, dt);
     
-    // Update characters
-    for (int i = 0; i < character_count; i++) {
-        character_update(characters[i], maze, dt);
-        
-        // Check if character has escaped
-        character_check_escaped(characters[i], maze);
-        
-        // Check for winner
-        if (characters[i]->has_escaped && !winner) {
-            winner = characters[i];
-            printf("Winner: %s escaped in %.2f seconds!\n", winner->name, winner->escape_time);
-        }
+    // Extra outputs share the race, the renderer and every drawn frame
+    for (int i = 0; i < app_settings.view_count; i++) {
+        AppView* view = &app_settings.views[i];
+        view_encoders[i] = encoder_create(view->output_filename, view->width, view->height,
+                                          app_settings.fps, 5000000);
+        encoder_start(view_encoders[i]);
     }
     
-    // Update simulation time
-    simulation_time += dt;
+    // Start trajectory recording
+    if (app_settings.record_file) {
+        recorder = trajectory_writer_open(app_settings.record_file, simulation, app_settings.fps);
+    }
     
-    // Check if simulation should end
-    if (winner || simulation_time >= app_settings.simulation_duration) {
-        if (!winner) {
-            printf("Simulation ended with no winner after %.2f seconds.\n", simulation_time);
-        }
-        simulation_running = false;
+    // Speed through dull stretches of offline renders, mapping video time to race time
+    if (app_settings.offline_mode && app_settings.timelapse_speedup > 1) {
+        char map_path[1024];
+        snprintf(map_path, sizeof(map_path), "%s.timemap", app_settings.output_filename);
+        timelapse = timelapse_open(app_settings.timelapse_speedup, app_settings.fps, map_path);
     }
 }
 
 // Function to render simulation
 void render_simulation(void) {
-    // Clear screen
-    Color bg_color = {30, 30, 50, 255}; // Dark blue-ish background
-    renderer_clear(renderer, bg_color);
-    
-    // Set camera to follow characters (average position)
-    float avg_x = 0, avg_y = 0;
-    int active_chars = 0;
-    
-    for (int i = 0; i < character_count; i++) {
-        if (!characters[i]->has_escaped) {
-            avg_x += characters[i]->x;
-            avg_y += characters[i]->y;
-            active_chars++;
-        }
-    }
-    
-    if (active_chars > 0) {
-        avg_x /= active_chars;
-        avg_y /= active_chars;
-        renderer_set_camera(renderer, avg_x, avg_y, app_settings.zoom_level);
-    }
+    renderer_draw_simulation(renderer, simulation, app_settings.zoom_level, app_settings.fps);
     
-    // Draw maze
-    renderer_draw_maze(renderer, maze);
-    
-    // Draw characters
-    for (int i = 0; i < character_count; i++) {
-        renderer_draw_character(renderer, characters[i]);
+    // Present rendering (offline renders only go to the encoder)
+    if (!app_settings.offline_mode) {
+        renderer_present(renderer);
     }
     
-    // Draw particles
-    renderer_draw_particles(renderer);
-    
-    // Draw debug info if enabled
-    if (app_settings.debug_mode) {
-        renderer_draw_debug_info(renderer, app_settings.fps, character_count);
-    }
-    
-    // Draw celebration if there's a winner
-    if (winner) {
-        renderer_draw_celebration(renderer, winner);
+    // Encode frame to video (with extra outputs, read back once and crop for each)
+    if (app_settings.view_count == 0) {
+        encoder_encode_renderer(encoder, renderer->sdl_renderer);
+    } else {
+        SDL_Surface* frame = renderer_read_frame(renderer);
+        encoder_encode_region(encoder, frame, &main_crop);
+        for (int i = 0; i < app_settings.view_count; i++) {
+            encoder_encode_region(view_encoders[i], frame, &view_crops[i]);
+        }
     }
-    
-    // Present rendering
-    renderer_present(renderer);
-    
-    // Encode frame to video
-    encoder_encode_renderer(encoder, renderer->sdl_renderer);
 }
 
 // Function to run the simulation
@@ -231,88 +267,254 @@ void run_simulation(void) {
     Uint32 last_time = SDL_GetTicks();
     Uint32 current_time;
     float dt;
+    float frame_dt = 1.0f / app_settings.fps;
     
     // Main simulation loop
     SDL_Event event;
-    while (simulation_running) {
+    while (simulation->running) {
         // Handle SDL events
         while (SDL_PollEvent(&event)) {
             if (event.type == SDL_QUIT) {
-                simulation_running = false;
+                simulation->running = false;
             } else if (event.type == SDL_KEYDOWN) {
                 if (event.key.keysym.sym == SDLK_ESCAPE) {
-                    simulation_running = false;
+                    simulation->running = false;
                 }
             }
         }
         
         // Calculate delta time
-        current_time = SDL_GetTicks();
-        dt = (current_time - last_time) / 1000.0f;
-        last_time = current_time;
-        
-        // Limit dt to prevent physics issues
-        if (dt > 0.05f) dt = 0.05f;
+        if (app_settings.offline_mode) {
+            // Exactly one output frame of simulated time per iteration
+            dt = frame_dt;
+        } else {
+            current_time = SDL_GetTicks();
+            dt = (current_time - last_time) / 1000.0f;
+            last_time = current_time;
+            
+            // Limit dt to prevent physics issues
+            if (dt > 0.05f) dt = 0.05f;
+        }
         
-        // Update simulation
-        update_simulation(dt);
+        // Update simulation (a time-lapse runs several steps per dull frame)
+        TRACE_BEGIN(frame_zone, "frame");
+        int steps = timelapse_next_speedup(timelapse);
+        for (int step = 0; step < steps && simulation->running; step++) {
+            simulation_step(simulation, dt);
+            renderer_add_simulation_effects(renderer, simulation);
+            renderer_update_animations(renderer, simulation, dt);
+            trajectory_write_frame(recorder, simulation, true);
+            timelapse_measure(timelapse, simulation, dt);
+        }
         
         // Render simulation
+        timelapse_write_frame(timelapse, simulation->time);
         render_simulation();
+        TRACE_END(frame_zone);
         
         // Cap frame rate
-        SDL_Delay(1000 / app_settings.fps);
+        if (!app_settings.offline_mode) {
+            SDL_Delay(1000 / app_settings.fps);
+        }
     }
     
     // Render a few more frames of celebration if there's a winner
-    if (winner) {
+    if (simulation->winner) {
         for (int i = 0; i < 5 * app_settings.fps; i++) { // 5 seconds of celebration
+            simulation->time += frame_dt;
+            renderer_update_animations(renderer, simulation, frame_dt);
+            timelapse_write_frame(timelapse, simulation->time);
             render_simulation();
-            SDL_Delay(1000 / app_settings.fps);
+            trajectory_write_frame(recorder, simulation, false);
+            if (!app_settings.offline_mode) {
+                SDL_Delay(1000 / app_settings.fps);
+            }
         }
     }
     
     // Stop video recording
     encoder_stop(encoder);
+    for (int i = 0; i < app_settings.view_count; i++) {
+        encoder_stop(view_encoders[i]);
+    }
+    
+    // Finish trajectory recording
+    if (recorder) {
+        if (!trajectory_writer_close(recorder)) {
+            fprintf(stderr, "Error writing trajectory %s\n", app_settings.record_file);
+        }
+        recorder = NULL;
+    }
+    
+    // Finish the time map
+    if (timelapse) {
+        if (!timelapse_close(timelapse)) {
+            fprintf(stderr, "Error writing time map for %s\n", app_settings.output_filename);
+        }
+        timelapse = NULL;
+    }
 }
 
 // Function to clean up resources
 void cleanup_simulation(void) {
-    // Clean up characters
-    for (int i = 0; i < character_count; i++) {
-        character_destroy(characters[i]);
-    }
-    free(characters);
-    
-    // Clean up maze
-    maze_destroy(maze);
-    
-    // Clean up physics
-    physics_destroy_space(physics_space);
+    // Clean up the race
+    simulation_destroy(simulation);
     
     // Clean up renderer
     renderer_destroy(renderer);
     
-    // Clean up encoder
+    // Clean up encoders
     encoder_destroy(encoder);
+    for (int i = 0; i < app_settings.view_count; i++) {
+        encoder_destroy(view_encoders[i]);
+        view_encoders[i] = NULL;
+    }
     
     // Quit SDL
     SDL_Quit();
 }
 
+// Function to render every job in the batch file
+bool run_batch(void) {
+    if (SDL_Init(SDL_INIT_TIMER) != 0) {
+        fprintf(stderr, "Error initializing SDL: %s\n", SDL_GetError());
+        return false;
+    }
+    
+    int job_count = 0;
+    BatchJob* jobs = batch_load_jobs(app_settings.batch_file, &job_count);
+    if (!jobs || job_count == 0) {
+        fprintf(stderr, "No jobs found in %s\n", app_settings.batch_file);
+        batch_free_jobs(jobs, job_count);
+        SDL_Quit();
+        return false;
+    }
+    
+    int workers = app_settings.worker_count > 0 ? app_settings.worker_count : SDL_GetCPUCount();
+    bool ok = batch_run(jobs, job_count, &app_settings, workers);
+    
+    batch_free_jobs(jobs, job_count);
+    SDL_Quit();
+    return ok;
+}
+
+// Function to score a range of seeds headless and print the most exciting ones
+bool run_search(void) {
+    if (SDL_Init(SDL_INIT_TIMER) != 0) {
+        fprintf(stderr, "Error initializing SDL: %s\n", SDL_GetError());
+        return false;
+    }
+    
+    SimulationConfig config = {
+        .maze_width = app_settings.maze_width,
+        .maze_height = app_settings.maze_height,
+        .cell_size = app_settings.cell_size,
+        .character_types = app_settings.character_types,
+        .simulation_duration = app_settings.simulation_duration,
+        .random_seed = app_settings.random_seed,
+        .maze_algorithm = app_settings.maze_algorithm,
+        .braid_fraction = app_settings.braid_fraction,
+        .cooperative = app_settings.cooperative,
+        .fog_radius = app_settings.fog_radius,
+        .dynamic_maze = app_settings.dynamic_maze,
+        .terrain_fraction = app_settings.terrain_fraction,
+        .stop_when_decided = app_settings.early_stop
+    };
+    
+    // Layout limits checked before any physics runs
+    SearchFilter filter = {
+        .min_solution_length = app_settings.min_solution,
+        .min_useful_breakables = app_settings.min_shortcuts,
+        .max_spawn_spread = app_settings.max_spawn_spread
+    };
+    
+    int workers = app_settings.worker_count > 0 ? app_settings.worker_count : SDL_GetCPUCount();
+    printf("Scoring seeds %u..%u on %d workers\n",
+        config.random_seed, config.random_seed + app_settings.search_count - 1, workers);
+    
+    int result_count = 0;
+    SearchResult* results = search_run(&config, &filter, app_settings.search_count, (float)app_settings.fps,
+                                       workers, &result_count);
+    if (results) {
+        search_print_top(results, result_count, app_settings.top_count);
+        free(results);
+    }
+    
+    SDL_Quit();
+    return results != NULL;
+}
+
+// Function to render a recorded trajectory headless (no physics)
+bool run_replay(void) {
+    if (SDL_Init(SDL_INIT_TIMER) != 0) {
+        fprintf(stderr, "Error initializing SDL: %s\n", SDL_GetError());
+        return false;
+    }
+    
+    // Frames are independent given the trajectory, so split them across workers
+    int workers = app_settings.worker_count > 0 ? app_settings.worker_count : SDL_GetCPUCount();
+    bool ok = replay_render(app_settings.replay_file, app_settings.output_filename, &app_settings, workers);
+    
+    SDL_Quit();
+    return ok;
+}
+
+// Function to serve render jobs on a UNIX socket until shut down
+bool run_daemon(void) {
+    if (SDL_Init(SDL_INIT_TIMER) != 0) {
+        fprintf(stderr, "Error initializing SDL: %s\n", SDL_GetError());
+        return false;
+    }
+    
+    int workers = app_settings.worker_count > 0 ? app_settings.worker_count : SDL_GetCPUCount();
+    bool ok = daemon_run(app_settings.daemon_socket, app_settings.spool_dir, &app_settings, workers);
+    
+    SDL_Quit();
+    return ok;
+}
+
 // Main function
 int main(int argc, char* argv[]) {
     // Parse command-line arguments
     parse_arguments(argc, argv);
     
-    // Initialize simulation
-    initialize_simulation();
+    // Record timing zones from every thread when tracing
+    if (app_settings.trace_file) {
+        trace_enable(true);
+        trace_set_thread_name("main");
+    }
     
-    // Run simulation
-    run_simulation();
+    int status = EXIT_SUCCESS;
+    
+    if (app_settings.daemon_socket) {
+        // Daemon mode keeps warm workers and renders jobs sent over the socket
+        status = run_daemon() ? EXIT_SUCCESS : EXIT_FAILURE;
+    } else if (app_settings.batch_file) {
+        // Batch mode renders every job headless and exits
+        status = run_batch() ? EXIT_SUCCESS : EXIT_FAILURE;
+    } else if (app_settings.replay_file) {
+        // Replay mode renders a recorded trajectory without running physics
+        status = run_replay() ? EXIT_SUCCESS : EXIT_FAILURE;
+    } else if (app_settings.search_count > 0) {
+        // Search mode only simulates, it never renders or encodes
+        status = run_search() ? EXIT_SUCCESS : EXIT_FAILURE;
+    } else {
+        // Initialize simulation
+        initialize_simulation();
+        
+        // Run simulation
+        run_simulation();
+        
+        // Clean up resources
+        cleanup_simulation();
+    }
     
-    // Clean up resources
-    cleanup_simulation();
+    // Export the trace and print per-phase timings
+    if (app_settings.trace_file) {
+        trace_write_chrome(app_settings.trace_file);
+        trace_print_summary();
+        trace_shutdown();
+    }
     
-    return EXIT_SUCCESS;
+    return status;
 }
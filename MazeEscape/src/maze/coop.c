@@ -0,0 +1,361 @@
+#include "maze/coop.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Space-time moves: north, east, south, west, then wait in place
+static const int COOP_DX[5] = {0, 1, 0, -1, 0};
+static const int COOP_DY[5] = {-1, 0, 1, 0, 0};
+
+// Local function prototypes
+static bool coop_needs_plan(MazeCoop* coop, CoopAgent* agent);
+static int coop_plan_index(MazeCoop* coop, CoopAgent* agent);
+static int coop_plan(MazeCoop* coop, int agent_index);
+static void coop_reserve_all(MazeCoop* coop);
+static void coop_reserve(MazeCoop* coop, int cell, int time, int agent);
+static int coop_reserved_by(MazeCoop* coop, int cell, int time);
+static unsigned int coop_hash(int cell, int time);
+static int coop_visit(MazeCoop* coop, int cell, int time, bool* created);
+static void coop_heap_push(MazeCoop* coop, int estimate, int node);
+static CoopHeapEntry coop_heap_pop(MazeCoop* coop);
+
+// Create a planner for agent_count agents on a generated maze
+MazeCoop* coop_create(Maze* maze, int agent_count, int window) {
+    if (window < 1) window = COOP_DEFAULT_WINDOW;
+    if (window > COOP_MAX_WINDOW) window = COOP_MAX_WINDOW;
+    
+    MazeCoop* coop = (MazeCoop*)calloc(1, sizeof(MazeCoop));
+    if (!coop) return NULL;
+    
+    coop->maze = maze;
+    coop->window = window;
+    coop->agent_count = agent_count;
+    
+    // Every agent reserves at most window + 1 cells; keep the table a quarter full
+    int table_size = 16;
+    while (table_size < agent_count * (window + 1) * 4) table_size *= 2;
+    coop->table_mask = table_size - 1;
+    
+    int visit_size = 16;
+    while (visit_size < COOP_MAX_NODES * 2) visit_size *= 2;
+    coop->visit_mask = visit_size - 1;
+    
+    coop->agents = (CoopAgent*)calloc(agent_count > 0 ? agent_count : 1, sizeof(CoopAgent));
+    coop->table = (CoopReservation*)calloc(table_size, sizeof(CoopReservation));
+    coop->node_cell = (int*)malloc(COOP_MAX_NODES * sizeof(int));
+    coop->node_time = (int*)malloc(COOP_MAX_NODES * sizeof(int));
+    coop->node_parent = (int*)malloc(COOP_MAX_NODES * sizeof(int));
+    coop->visit_key = (int*)malloc(visit_size * sizeof(int));
+    coop->visit_node = (int*)malloc(visit_size * sizeof(int));
+    coop->visit_stamp = (unsigned int*)calloc(visit_size, sizeof(unsigned int));
+    coop->heap = (CoopHeapEntry*)malloc(COOP_MAX_NODES * sizeof(CoopHeapEntry));
+    
+    if (!coop->agents || !coop->table || !coop->node_cell || !coop->node_time || !coop->node_parent ||
+        !coop->visit_key || !coop->visit_node || !coop->visit_stamp || !coop->heap) {
+        coop_destroy(coop);
+        return NULL;
+    }
+    
+    for (int i = 0; i < agent_count; i++) {
+        coop->agents[i].cell = -1;
+        coop->agents[i].plan_time = -1;
+    }
+    
+    return coop;
+}
+
+// Free the planner
+void coop_destroy(MazeCoop* coop) {
+    if (!coop) return;
+    
+    free(coop->agents);
+    free(coop->table);
+    free(coop->node_cell);
+    free(coop->node_time);
+    free(coop->node_parent);
+    free(coop->visit_key);
+    free(coop->visit_node);
+    free(coop->visit_stamp);
+    free(coop->heap);
+    free(coop);
+}
+
+// Report an agent's current cell (x < 0 takes it out of planning, e.g. once escaped)
+void coop_set_agent(MazeCoop* coop, int agent, int x, int y) {
+    if (agent < 0 || agent >= coop->agent_count) return;
+    
+    Maze* maze = coop->maze;
+    CoopAgent* state = &coop->agents[agent];
+    if (x < 0 || x >= maze->width || y < 0 || y >= maze->height) {
+        state->cell = -1;
+        state->plan_time = -1;
+        return;
+    }
+    state->cell = x * maze->height + y;
+}
+
+// Move the planning clock one step forward (about one cell of travel)
+void coop_advance(MazeCoop* coop) {
+    coop->clock++;
+}
+
+// Replan agents round-robin until the expansion budget is spent. At least
+// one agent that needs a plan gets one per call, so nobody starves; the
+// rest wait for later calls. Returns the expansions used.
+int coop_update(MazeCoop* coop, int budget) {
+    int used = 0;
+    
+    for (int visited = 0; visited < coop->agent_count && used < budget; visited++) {
+        int agent_index = coop->next_agent;
+        coop->next_agent = (coop->next_agent + 1) % coop->agent_count;
+        
+        CoopAgent* agent = &coop->agents[agent_index];
+        if (agent->cell < 0 || !coop_needs_plan(coop, agent)) continue;
+        
+        // Reservations reflect every plan made so far, including this call's
+        coop_reserve_all(coop);
+        used += coop_plan(coop, agent_index);
+    }
+    
+    return used;
+}
+
+// Get the cell an agent should head for next (its own cell when it should
+// wait). False when it has no usable plan and should steer on its own.
+bool coop_next_cell(MazeCoop* coop, int agent, int* x, int* y) {
+    if (agent < 0 || agent >= coop->agent_count) return false;
+    
+    CoopAgent* state = &coop->agents[agent];
+    int index = coop_plan_index(coop, state);
+    if (index < 0 || index >= coop->window) return false;
+    
+    int cell = state->path[index + 1];
+    *x = cell / coop->maze->height;
+    *y = cell % coop->maze->height;
+    return true;
+}
+
+// Helper: Whether an agent's plan is missing, left behind, or half used up
+static bool coop_needs_plan(MazeCoop* coop, CoopAgent* agent) {
+    if (agent->plan_time < 0) return true;
+    if (coop->clock - agent->plan_time >= coop->window / 2) return true;
+    
+    int index = coop_plan_index(coop, agent);
+    return index < 0 || index >= coop->window / 2;
+}
+
+// Helper: Position of the agent's cell on its plan (last occurrence, since
+// waits repeat a cell), or -1 if it has left the plan
+static int coop_plan_index(MazeCoop* coop, CoopAgent* agent) {
+    if (agent->plan_time < 0 || agent->cell < 0) return -1;
+    
+    for (int k = coop->window; k >= 0; k--) {
+        if (agent->path[k] == agent->cell) return k;
+    }
+    return -1;
+}
+
+// Helper: Space-time A* for one agent over (cell, step) with moves and waits.
+// Every action costs one step, so a node's cost is its step and f = step +
+// exit distance. The search ends at the window's edge or at the exit; if
+// every route is blocked the agent is left without a plan. Returns the
+// expansions used.
+static int coop_plan(MazeCoop* coop, int agent_index) {
+    Maze* maze = coop->maze;
+    CoopAgent* agent = &coop->agents[agent_index];
+    int height = maze->height;
+    int exit_cell = maze->exit_x * height + maze->exit_y;
+    int start_distance = maze->exit_distance[agent->cell];
+    
+    agent->plan_time = -1;
+    coop->replans++;
+    if (start_distance == MAZE_UNREACHABLE) return 0;
+    
+    coop->stamp++;
+    coop->node_count = 0;
+    coop->heap_size = 0;
+    
+    bool created;
+    int start = coop_visit(coop, agent->cell, 0, &created);
+    coop->node_parent[start] = -1;
+    coop_heap_push(coop, start_distance * (COOP_MAX_WINDOW + 1), start);
+    
+    int goal = -1;
+    int expansions = 0;
+    
+    while (coop->heap_size > 0) {
+        int node = coop_heap_pop(coop).node;
+        int cell = coop->node_cell[node];
+        int time = coop->node_time[node];
+        expansions++;
+        
+        if (time == coop->window || cell == exit_cell) {
+            goal = node;
+            break;
+        }
+        
+        int x = cell / height;
+        int y = cell % height;
+        int arrive = coop->clock + time + 1;
+        
+        for (int move = 0; move < 5; move++) {
+            int nx = x + COOP_DX[move];
+            int ny = y + COOP_DY[move];
+            if (maze_is_wall(maze, nx, ny)) continue;
+            
+            int next = nx * height + ny;
+            int distance = maze->exit_distance[next];
+            if (distance == MAZE_UNREACHABLE) continue;
+            
+            // Someone else holds the cell then
+            int holder = coop_reserved_by(coop, next, arrive);
+            if (holder >= 0 && holder != agent_index) continue;
+            
+            // Or is coming the other way through us
+            if (move < 4) {
+                int oncoming = coop_reserved_by(coop, next, arrive - 1);
+                if (oncoming >= 0 && oncoming != agent_index && coop_reserved_by(coop, cell, arrive) == oncoming) {
+                    continue;
+                }
+            }
+            
+            int child = coop_visit(coop, next, time + 1, &created);
+            if (child < 0 || !created) continue;
+            
+            coop->node_parent[child] = node;
+            // Ties go to the deeper node, which is closer to finishing
+            coop_heap_push(coop, (time + 1 + distance) * (COOP_MAX_WINDOW + 1) + (COOP_MAX_WINDOW - time - 1), child);
+        }
+    }
+    
+    if (goal < 0) return expansions;
+    
+    // Walk back to the start; a plan that reaches the exit early stays there
+    int goal_time = coop->node_time[goal];
+    for (int k = goal_time + 1; k <= coop->window; k++) {
+        agent->path[k] = coop->node_cell[goal];
+    }
+    for (int node = goal; node >= 0; node = coop->node_parent[node]) {
+        agent->path[coop->node_time[node]] = coop->node_cell[node];
+    }
+    agent->plan_time = coop->clock;
+    
+    return expansions;
+}
+
+// Helper: Rebuild the reservation table from every agent's plan. Agents
+// without a plan hold their current cell for the next step. The exit is
+// never reserved: racers leave the maze there, so it does not fill up.
+static void coop_reserve_all(MazeCoop* coop) {
+    int exit_cell = coop->maze->exit_x * coop->maze->height + coop->maze->exit_y;
+    coop->table_stamp++;
+    
+    for (int i = 0; i < coop->agent_count; i++) {
+        CoopAgent* agent = &coop->agents[i];
+        if (agent->cell < 0) continue;
+        
+        if (agent->plan_time < 0) {
+            coop_reserve(coop, agent->cell, coop->clock, i);
+            coop_reserve(coop, agent->cell, coop->clock + 1, i);
+            continue;
+        }
+        
+        for (int k = 0; k <= coop->window; k++) {
+            int time = agent->plan_time + k;
+            if (time >= coop->clock && agent->path[k] != exit_cell) {
+                coop_reserve(coop, agent->path[k], time, i);
+            }
+        }
+    }
+}
+
+// Helper: Claim a cell at a step (the first claim wins)
+static void coop_reserve(MazeCoop* coop, int cell, int time, int agent) {
+    unsigned int slot = coop_hash(cell, time) & coop->table_mask;
+    
+    for (;;) {
+        CoopReservation* entry = &coop->table[slot];
+        if (entry->stamp != coop->table_stamp) {
+            entry->cell = cell;
+            entry->time = time;
+            entry->agent = agent;
+            entry->stamp = coop->table_stamp;
+            return;
+        }
+        if (entry->cell == cell && entry->time == time) return;
+        slot = (slot + 1) & coop->table_mask;
+    }
+}
+
+// Helper: Agent holding a cell at a step, or -1
+static int coop_reserved_by(MazeCoop* coop, int cell, int time) {
+    unsigned int slot = coop_hash(cell, time) & coop->table_mask;
+    
+    for (;;) {
+        CoopReservation* entry = &coop->table[slot];
+        if (entry->stamp != coop->table_stamp) return -1;
+        if (entry->cell == cell && entry->time == time) return entry->agent;
+        slot = (slot + 1) & coop->table_mask;
+    }
+}
+
+// Helper: Mix a cell and a step into a table slot
+static unsigned int coop_hash(int cell, int time) {
+    return ((unsigned int)cell * 73856093u) ^ ((unsigned int)time * 19349663u);
+}
+
+// Helper: Find or create the search node of (cell, time). Returns -1 when
+// the node pool is exhausted; *created tells whether the node is new.
+static int coop_visit(MazeCoop* coop, int cell, int time, bool* created) {
+    int key = cell * (COOP_MAX_WINDOW + 1) + time;
+    unsigned int slot = coop_hash(cell, time) & coop->visit_mask;
+    *created = false;
+    
+    while (coop->visit_stamp[slot] == coop->stamp) {
+        if (coop->visit_key[slot] == key) return coop->visit_node[slot];
+        slot = (slot + 1) & coop->visit_mask;
+    }
+    
+    if (coop->node_count == COOP_MAX_NODES) return -1;
+    
+    int node = coop->node_count++;
+    coop->node_cell[node] = cell;
+    coop->node_time[node] = time;
+    coop->visit_stamp[slot] = coop->stamp;
+    coop->visit_key[slot] = key;
+    coop->visit_node[slot] = node;
+    *created = true;
+    return node;
+}
+
+// Helper: Push onto the binary min-heap of the open list (one entry per node at most)
+static void coop_heap_push(MazeCoop* coop, int estimate, int node) {
+    int index = coop->heap_size++;
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (coop->heap[parent].estimate <= estimate) break;
+        coop->heap[index] = coop->heap[parent];
+        index = parent;
+    }
+    coop->heap[index].estimate = estimate;
+    coop->heap[index].node = node;
+}
+
+// Helper: Pop the entry with the lowest estimate
+static CoopHeapEntry coop_heap_pop(MazeCoop* coop) {
+    CoopHeapEntry top = coop->heap[0];
+    CoopHeapEntry last = coop->heap[--coop->heap_size];
+    
+    int index = 0;
+    for (;;) {
+        int child = index * 2 + 1;
+        if (child >= coop->heap_size) break;
+        if (child + 1 < coop->heap_size && coop->heap[child + 1].estimate < coop->heap[child].estimate) child++;
+        if (last.estimate <= coop->heap[child].estimate) break;
+        coop->heap[index] = coop->heap[child];
+        index = child;
+    }
+    if (coop->heap_size > 0) {
+        coop->heap[index] = last;
+    }
+    return top;
+}
@@ -0,0 +1,326 @@
+#include "maze/dynamic.h"
+#include "maze/generators.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Cells per scheduled piece placed by maze_dynamic_populate
+#define DYNAMIC_CELLS_PER_DOOR 120
+#define DYNAMIC_CELLS_PER_MOVER 240
+#define DYNAMIC_CELLS_PER_ROTOR 480
+
+// Placement attempts per requested piece
+#define DYNAMIC_PLACEMENT_TRIES 20
+
+// Local function prototypes
+static bool dynamic_add_element(MazeDynamic* dynamic, const MazeDynamicElement* element);
+static bool dynamic_push_edit(MazeDynamic* dynamic, int x, int y, CellType type);
+static bool dynamic_closes(MazeDynamic* dynamic, int x, int y, CellType type, bool* blocked);
+static bool dynamic_fire(MazeDynamic* dynamic, MazeDynamicElement* element);
+static bool dynamic_is_corridor(Maze* maze, int x, int y, bool* horizontal);
+static bool dynamic_claim(Maze* maze, int x0, int y0, int x1, int y1);
+
+// Create an empty dynamic layer; attach it with maze->dynamic so maze_update drives it
+MazeDynamic* maze_dynamic_create(Maze* maze) {
+    MazeDynamic* dynamic = (MazeDynamic*)calloc(1, sizeof(MazeDynamic));
+    if (!dynamic) return NULL;
+    
+    dynamic->maze = maze;
+    return dynamic;
+}
+
+// Free a dynamic layer (detaching it from its maze)
+void maze_dynamic_destroy(MazeDynamic* dynamic) {
+    if (!dynamic) return;
+    
+    if (dynamic->maze->dynamic == dynamic) {
+        dynamic->maze->dynamic = NULL;
+    }
+    free(dynamic->elements);
+    free(dynamic->edits);
+    free(dynamic);
+}
+
+// Set the check that postpones closing an occupied cell
+void maze_dynamic_set_blocked(MazeDynamic* dynamic, MazeBlockedFunc func, void* user_data) {
+    dynamic->blocked = func;
+    dynamic->blocked_data = user_data;
+}
+
+// Add a door on an open cell: it closes `phase` seconds in and then toggles every period
+bool maze_dynamic_add_door(MazeDynamic* dynamic, int x, int y, float period, float phase) {
+    if (maze_is_wall(dynamic->maze, x, y) || period <= 0.0f) return false;
+    
+    MazeDynamicElement door = {MAZE_DYNAMIC_DOOR, x, y, 0, 0, 1, period, phase, 0, 0};
+    return dynamic_add_element(dynamic, &door);
+}
+
+// Add a wall block that starts on the wall cell (x, y) and slides one cell
+// per period along the open cells that follow it in direction (dx, dy)
+bool maze_dynamic_add_mover(MazeDynamic* dynamic, int x, int y, int dx, int dy, int length, float period, float phase) {
+    Maze* maze = dynamic->maze;
+    if (length < 2 || period <= 0.0f || abs(dx) + abs(dy) != 1) return false;
+    if (maze_get_cell(maze, x, y) != CELL_WALL) return false;
+    
+    for (int i = 1; i < length; i++) {
+        if (maze_get_cell(maze, x + dx * i, y + dy * i) != CELL_EMPTY) return false;
+    }
+    
+    MazeDynamicElement mover = {MAZE_DYNAMIC_MOVER, x, y, dx, dy, length, period, phase, 0, 1};
+    return dynamic_add_element(dynamic, &mover);
+}
+
+// Add a square section of plain walls and floor, turned a quarter every period
+bool maze_dynamic_add_rotor(MazeDynamic* dynamic, int x, int y, int size, float period, float phase) {
+    Maze* maze = dynamic->maze;
+    if (size < 2 || period <= 0.0f) return false;
+    if (x < 0 || y < 0 || x + size > maze->width || y + size > maze->height) return false;
+    
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            CellType type = maze->cells[x + i][y + j];
+            if (type != CELL_WALL && type != CELL_EMPTY) return false;
+        }
+    }
+    
+    MazeDynamicElement rotor = {MAZE_DYNAMIC_ROTOR, x, y, 0, 0, size, period, phase, 0, 0};
+    return dynamic_add_element(dynamic, &rotor);
+}
+
+// Scatter doors across straight corridors, sliding wall panels beside them
+// and rotating junctions (3x3 sections around a passage node), away from
+// the exit and each other. Deterministic for a seed. Returns the piece count.
+int maze_dynamic_populate(MazeDynamic* dynamic, unsigned int seed) {
+    Maze* maze = dynamic->maze;
+    int cell_count = maze->width * maze->height;
+    int wanted[3] = {
+        cell_count / DYNAMIC_CELLS_PER_DOOR,
+        cell_count / DYNAMIC_CELLS_PER_MOVER,
+        cell_count / DYNAMIC_CELLS_PER_ROTOR
+    };
+    
+    // The scratch buffer marks claimed cells while placing
+    memset(maze->scratch, 0, cell_count * sizeof(int));
+    
+    // Own stream, far from the one that carved the maze
+    unsigned int state = maze_random_jump(seed, 1u << 29);
+    int placed = 0;
+    
+    for (int type = 0; type < 3; type++) {
+        int count = 0;
+        for (int attempt = 0; attempt < wanted[type] * DYNAMIC_PLACEMENT_TRIES && count < wanted[type]; attempt++) {
+            int x = maze_random_below(&state, maze->width);
+            int y = maze_random_below(&state, maze->height);
+            float period = 0.0f;
+            float phase = 0.0f;
+            bool added = false;
+            bool horizontal;
+            
+            if (type == MAZE_DYNAMIC_ROTOR) {
+                // Centre on a passage node so the corners stay solid
+                x |= 1;
+                y |= 1;
+                if (x < 3 || y < 3 || x > maze->width - 4 || y > maze->height - 4) continue;
+                if (maze_get_exit_distance(maze, x, y) <= 3) continue;
+                if (!dynamic_claim(maze, x - 1, y - 1, x + 1, y + 1)) continue;
+                
+                period = 3.0f + maze_random_below(&state, 200) / 100.0f;
+                phase = maze_random_below(&state, (int)(period * 100.0f)) / 100.0f;
+                added = maze_dynamic_add_rotor(dynamic, x - 1, y - 1, 3, period, phase);
+            } else {
+                if (maze_get_cell(maze, x, y) != CELL_EMPTY || !dynamic_is_corridor(maze, x, y, &horizontal)) continue;
+                if (maze_get_exit_distance(maze, x, y) <= 2) continue;
+                
+                if (type == MAZE_DYNAMIC_DOOR) {
+                    if (!dynamic_claim(maze, x - 1, y - 1, x + 1, y + 1)) continue;
+                    period = 2.0f + maze_random_below(&state, 200) / 100.0f;
+                    phase = maze_random_below(&state, (int)(period * 100.0f)) / 100.0f;
+                    added = maze_dynamic_add_door(dynamic, x, y, period, phase);
+                } else {
+                    // Panel parked in a side wall, sliding across the corridor
+                    int side = maze_random_below(&state, 2) ? 1 : -1;
+                    int dx = horizontal ? 0 : side;
+                    int dy = horizontal ? side : 0;
+                    int wall_x = x - dx;
+                    int wall_y = y - dy;
+                    if (wall_x < 1 || wall_y < 1 || wall_x > maze->width - 2 || wall_y > maze->height - 2) continue;
+                    if (!dynamic_claim(maze, x - 1 - abs(dx), y - 1 - abs(dy), x + 1 + abs(dx), y + 1 + abs(dy))) continue;
+                    
+                    period = 1.5f + maze_random_below(&state, 150) / 100.0f;
+                    phase = maze_random_below(&state, (int)(period * 100.0f)) / 100.0f;
+                    added = maze_dynamic_add_mover(dynamic, wall_x, wall_y, dx, dy, 2, period, phase);
+                }
+            }
+            
+            if (added) {
+                count++;
+                placed++;
+            }
+        }
+    }
+    
+    return placed;
+}
+
+// Advance the clock and apply every change that is due as one batch of
+// maze edits. Returns the number of cells changed.
+int maze_dynamic_update(MazeDynamic* dynamic, float dt) {
+    dynamic->time += dt;
+    dynamic->edit_count = 0;
+    
+    for (int i = 0; i < dynamic->element_count; i++) {
+        MazeDynamicElement* element = &dynamic->elements[i];
+        if (dynamic->time < element->next_time) continue;
+        
+        // A blocked change stays due and is retried next tick
+        int first_edit = dynamic->edit_count;
+        if (!dynamic_fire(dynamic, element)) {
+            dynamic->edit_count = first_edit;
+            dynamic->postponed++;
+            continue;
+        }
+        
+        element->next_time += element->period;
+    }
+    
+    if (dynamic->edit_count == 0) return 0;
+    return maze_set_cells(dynamic->maze, dynamic->edits, dynamic->edit_count);
+}
+
+// Helper: Append an element to the schedule
+static bool dynamic_add_element(MazeDynamic* dynamic, const MazeDynamicElement* element) {
+    if (dynamic->element_count == dynamic->element_capacity) {
+        int capacity = dynamic->element_capacity ? dynamic->element_capacity * 2 : 16;
+        MazeDynamicElement* grown = (MazeDynamicElement*)realloc(dynamic->elements,
+            capacity * sizeof(MazeDynamicElement));
+        if (!grown) {
+            fprintf(stderr, "Failed to grow the dynamic maze schedule\n");
+            return false;
+        }
+        dynamic->elements = grown;
+        dynamic->element_capacity = capacity;
+    }
+    
+    dynamic->elements[dynamic->element_count++] = *element;
+    return true;
+}
+
+// Helper: Append an edit to the current tick's batch
+static bool dynamic_push_edit(MazeDynamic* dynamic, int x, int y, CellType type) {
+    if (dynamic->edit_count == dynamic->edit_capacity) {
+        int capacity = dynamic->edit_capacity ? dynamic->edit_capacity * 2 : 32;
+        MazeCellChange* grown = (MazeCellChange*)realloc(dynamic->edits, capacity * sizeof(MazeCellChange));
+        if (!grown) return false;
+        dynamic->edits = grown;
+        dynamic->edit_capacity = capacity;
+    }
+    
+    MazeCellChange* edit = &dynamic->edits[dynamic->edit_count++];
+    edit->x = x;
+    edit->y = y;
+    edit->old_type = dynamic->maze->cells[x][y];
+    edit->new_type = type;
+    return true;
+}
+
+// Helper: Whether setting a cell to `type` closes an open cell, flagging
+// `blocked` when the occupancy check vetoes it
+static bool dynamic_closes(MazeDynamic* dynamic, int x, int y, CellType type, bool* blocked) {
+    bool closes = type == CELL_WALL && !maze_is_wall(dynamic->maze, x, y);
+    if (closes && dynamic->blocked && dynamic->blocked(dynamic->blocked_data, x, y)) {
+        *blocked = true;
+    }
+    return closes;
+}
+
+// Helper: Queue the edits of one element's next change and advance its
+// state; false (nothing committed) when a cell it would close is blocked
+static bool dynamic_fire(MazeDynamic* dynamic, MazeDynamicElement* element) {
+    Maze* maze = dynamic->maze;
+    bool blocked = false;
+    
+    switch (element->type) {
+        case MAZE_DYNAMIC_DOOR: {
+            CellType type = element->state ? CELL_EMPTY : CELL_WALL;
+            dynamic_closes(dynamic, element->x, element->y, type, &blocked);
+            if (blocked || !dynamic_push_edit(dynamic, element->x, element->y, type)) return false;
+            element->state = !element->state;
+            return true;
+        }
+        
+        case MAZE_DYNAMIC_MOVER: {
+            int next = element->state + element->step;
+            if (next < 0 || next >= element->size) {
+                element->step = -element->step;
+                next = element->state + element->step;
+            }
+            int from_x = element->x + element->dx * element->state;
+            int from_y = element->y + element->dy * element->state;
+            int to_x = element->x + element->dx * next;
+            int to_y = element->y + element->dy * next;
+            
+            dynamic_closes(dynamic, to_x, to_y, CELL_WALL, &blocked);
+            if (blocked || !dynamic_push_edit(dynamic, to_x, to_y, CELL_WALL) ||
+                !dynamic_push_edit(dynamic, from_x, from_y, CELL_EMPTY)) return false;
+            element->state = next;
+            return true;
+        }
+        
+        case MAZE_DYNAMIC_ROTOR: {
+            // Quarter turn: the cell at local (a, b) takes the type at (b, size - 1 - a)
+            int size = element->size;
+            for (int a = 0; a < size; a++) {
+                for (int b = 0; b < size; b++) {
+                    CellType type = maze->cells[element->x + b][element->y + size - 1 - a];
+                    int x = element->x + a;
+                    int y = element->y + b;
+                    if (maze->cells[x][y] == type) continue;
+                    
+                    dynamic_closes(dynamic, x, y, type, &blocked);
+                    if (blocked || !dynamic_push_edit(dynamic, x, y, type)) return false;
+                }
+            }
+            element->state = (element->state + 1) % 4;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+// Helper: Whether an open cell is a straight corridor piece (walls on both
+// sides, open ahead and behind); `horizontal` tells its direction
+static bool dynamic_is_corridor(Maze* maze, int x, int y, bool* horizontal) {
+    bool walls_x = maze_is_wall(maze, x - 1, y) && maze_is_wall(maze, x + 1, y);
+    bool walls_y = maze_is_wall(maze, x, y - 1) && maze_is_wall(maze, x, y + 1);
+    bool open_x = !maze_is_wall(maze, x - 1, y) && !maze_is_wall(maze, x + 1, y);
+    bool open_y = !maze_is_wall(maze, x, y - 1) && !maze_is_wall(maze, x, y + 1);
+    
+    if (walls_y && open_x) {
+        *horizontal = true;
+        return true;
+    }
+    if (walls_x && open_y) {
+        *horizontal = false;
+        return true;
+    }
+    return false;
+}
+
+// Helper: Claim a rectangle of cells in the scratch buffer; false if any
+// cell is outside the maze or already claimed
+static bool dynamic_claim(Maze* maze, int x0, int y0, int x1, int y1) {
+    if (x0 < 0 || y0 < 0 || x1 >= maze->width || y1 >= maze->height) return false;
+    
+    for (int x = x0; x <= x1; x++) {
+        for (int y = y0; y <= y1; y++) {
+            if (maze->scratch[x * maze->height + y]) return false;
+        }
+    }
+    for (int x = x0; x <= x1; x++) {
+        for (int y = y0; y <= y1; y++) {
+            maze->scratch[x * maze->height + y] = 1;
+        }
+    }
+    return true;
+}
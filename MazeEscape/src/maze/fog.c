@@ -0,0 +1,197 @@
+#include "maze/fog.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Octant transforms: (xx, xy, yx, yy) map a row/column in octant space to a grid offset
+static const int FOG_OCTANTS[8][4] = {
+    { 1,  0,  0,  1}, { 0,  1,  1,  0}, { 0, -1,  1,  0}, {-1,  0,  0,  1},
+    {-1,  0,  0, -1}, { 0, -1, -1,  0}, { 0,  1, -1,  0}, { 1,  0,  0, -1}
+};
+
+// Local function prototypes
+static void fog_reveal(MazeFog* fog, uint64_t* map, int x, int y);
+static void fog_cast_light(MazeFog* fog, uint64_t* map, int cx, int cy, int row,
+                           float start, float end, const int* octant);
+
+// Create fog for a maze with the given number of viewers and sight radius
+MazeFog* fog_create(Maze* maze, int viewer_count, int radius) {
+    MazeFog* fog = (MazeFog*)malloc(sizeof(MazeFog));
+    if (!fog) return NULL;
+    
+    int cell_count = maze->width * maze->height;
+    fog->maze = maze;
+    fog->radius = radius > 0 ? radius : FOG_DEFAULT_RADIUS;
+    fog->viewer_count = viewer_count;
+    fog->words_per_map = (cell_count + 63) / 64;
+    fog->revealed_count = 0;
+    fog->tiles_x = (maze->width + FOG_TILE_SIZE - 1) / FOG_TILE_SIZE;
+    fog->tiles_y = (maze->height + FOG_TILE_SIZE - 1) / FOG_TILE_SIZE;
+    fog->dirty_count = 0;
+    
+    int tile_count = fog->tiles_x * fog->tiles_y;
+    fog->revealed = (uint64_t*)calloc(fog->words_per_map, sizeof(uint64_t));
+    fog->viewer_maps = (uint64_t*)calloc((size_t)fog->words_per_map * viewer_count, sizeof(uint64_t));
+    fog->viewer_cells = (int*)malloc(viewer_count * sizeof(int));
+    fog->tile_dirty = (unsigned char*)calloc(tile_count, 1);
+    fog->dirty_tiles = (int*)malloc(tile_count * sizeof(int));
+    
+    if (!fog->revealed || !fog->viewer_maps || !fog->viewer_cells || !fog->tile_dirty || !fog->dirty_tiles) {
+        fprintf(stderr, "Failed to allocate fog of war for %dx%d maze\n", maze->width, maze->height);
+        fog_destroy(fog);
+        return NULL;
+    }
+    
+    fog_invalidate(fog);
+    
+    // A fresh fog replaces whatever a renderer showed before
+    fog_mark_all_dirty(fog);
+    
+    return fog;
+}
+
+// Free fog
+void fog_destroy(MazeFog* fog) {
+    if (!fog) return;
+    
+    free(fog->revealed);
+    free(fog->viewer_maps);
+    free(fog->viewer_cells);
+    free(fog->tile_dirty);
+    free(fog->dirty_tiles);
+    free(fog);
+}
+
+// Report a viewer's cell; its field of view is recast only if the cell
+// changed since the last call. Returns whether it was recast.
+bool fog_move_viewer(MazeFog* fog, int viewer, int x, int y) {
+    Maze* maze = fog->maze;
+    if (viewer < 0 || viewer >= fog->viewer_count) return false;
+    if (x < 0 || x >= maze->width || y < 0 || y >= maze->height) return false;
+    
+    int cell = x * maze->height + y;
+    if (fog->viewer_cells[viewer] == cell) return false;
+    fog->viewer_cells[viewer] = cell;
+    
+    uint64_t* map = fog->viewer_maps + (size_t)viewer * fog->words_per_map;
+    fog_reveal(fog, map, x, y);
+    for (int i = 0; i < 8; i++) {
+        fog_cast_light(fog, map, x, y, 1, 1.0f, 0.0f, FOG_OCTANTS[i]);
+    }
+    
+    return true;
+}
+
+// Force every viewer's field of view to be recast on its next move (call
+// after walls change, since sight lines may have opened)
+void fog_invalidate(MazeFog* fog) {
+    for (int i = 0; i < fog->viewer_count; i++) {
+        fog->viewer_cells[i] = -1;
+    }
+}
+
+// Check whether any viewer has seen a cell
+bool fog_is_revealed(const MazeFog* fog, int x, int y) {
+    Maze* maze = fog->maze;
+    if (x < 0 || x >= maze->width || y < 0 || y >= maze->height) return false;
+    
+    int cell = x * maze->height + y;
+    return (fog->revealed[cell >> 6] >> (cell & 63)) & 1;
+}
+
+// Check whether one viewer has seen a cell
+bool fog_viewer_revealed(const MazeFog* fog, int viewer, int x, int y) {
+    Maze* maze = fog->maze;
+    if (viewer < 0 || viewer >= fog->viewer_count) return false;
+    if (x < 0 || x >= maze->width || y < 0 || y >= maze->height) return false;
+    
+    int cell = x * maze->height + y;
+    const uint64_t* map = fog->viewer_maps + (size_t)viewer * fog->words_per_map;
+    return (map[cell >> 6] >> (cell & 63)) & 1;
+}
+
+// Queue every tile (e.g. for a renderer that has not drawn this fog yet)
+void fog_mark_all_dirty(MazeFog* fog) {
+    int tile_count = fog->tiles_x * fog->tiles_y;
+    for (int i = 0; i < tile_count; i++) {
+        fog->tile_dirty[i] = 1;
+        fog->dirty_tiles[i] = i;
+    }
+    fog->dirty_count = tile_count;
+}
+
+// Empty the dirty tile queue once a renderer has caught up
+void fog_clear_dirty(MazeFog* fog) {
+    for (int i = 0; i < fog->dirty_count; i++) {
+        fog->tile_dirty[fog->dirty_tiles[i]] = 0;
+    }
+    fog->dirty_count = 0;
+}
+
+// Helper: Mark a cell seen by a viewer; first sightings also go into the
+// shared bitmap and queue their tile
+static void fog_reveal(MazeFog* fog, uint64_t* map, int x, int y) {
+    int cell = x * fog->maze->height + y;
+    uint64_t bit = (uint64_t)1 << (cell & 63);
+    map[cell >> 6] |= bit;
+    
+    if (fog->revealed[cell >> 6] & bit) return;
+    fog->revealed[cell >> 6] |= bit;
+    fog->revealed_count++;
+    
+    int tile = (y / FOG_TILE_SIZE) * fog->tiles_x + x / FOG_TILE_SIZE;
+    if (!fog->tile_dirty[tile]) {
+        fog->tile_dirty[tile] = 1;
+        fog->dirty_tiles[fog->dirty_count++] = tile;
+    }
+}
+
+// Helper: Recursive shadowcasting over one octant. Scans rows outward from
+// the viewer between the start and end slopes; a run of walls narrows the
+// visible wedge and recurses for the part beyond it, so each visible cell
+// is visited once and nothing behind a wall is touched.
+static void fog_cast_light(MazeFog* fog, uint64_t* map, int cx, int cy, int row,
+                           float start, float end, const int* octant) {
+    if (start < end) return;
+    
+    Maze* maze = fog->maze;
+    int radius = fog->radius;
+    int radius_squared = radius * radius + radius;
+    float new_start = 0.0f;
+    
+    for (int distance = row; distance <= radius; distance++) {
+        bool blocked = false;
+        int dy = -distance;
+        
+        for (int dx = -distance; dx <= 0; dx++) {
+            float left_slope = (dx - 0.5f) / (dy + 0.5f);
+            float right_slope = (dx + 0.5f) / (dy - 0.5f);
+            if (start < right_slope) continue;
+            if (end > left_slope) break;
+            
+            int x = cx + dx * octant[0] + dy * octant[1];
+            int y = cy + dx * octant[2] + dy * octant[3];
+            bool inside = x >= 0 && x < maze->width && y >= 0 && y < maze->height;
+            
+            if (inside && dx * dx + dy * dy <= radius_squared) {
+                fog_reveal(fog, map, x, y);
+            }
+            
+            bool opaque = maze_is_wall(maze, x, y);
+            if (blocked) {
+                if (opaque) {
+                    new_start = right_slope;
+                } else {
+                    blocked = false;
+                    start = new_start;
+                }
+            } else if (opaque && distance < radius) {
+                blocked = true;
+                fog_cast_light(fog, map, cx, cy, distance + 1, start, left_slope, octant);
+                new_start = right_slope;
+            }
+        }
+        
+        if (blocked) break;
+    }
+}
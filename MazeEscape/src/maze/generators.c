@@ -0,0 +1,388 @@
+#include "maze/generators.h"
+#include <stdlib.h>
+#include <string.h>
+
+// LCG shared by every generator (same constants as the racers and renderer)
+#define RANDOM_MULTIPLIER 1103515245u
+#define RANDOM_INCREMENT  12345u
+#define RANDOM_MASK       0x7fffffffu
+
+// Node grid steps (north, east, south, west)
+static const int NODE_DX[4] = {0, 1, 0, -1};
+static const int NODE_DY[4] = {-1, 0, 1, 0};
+
+// Node grid laid over the cells: node (i, j) is cell (2i + 1, 2j + 1), and
+// node indices run column by column like cell indices
+typedef struct {
+    Maze* maze;
+    int columns;
+    int rows;
+} NodeGrid;
+
+// Names accepted by --algorithm, in MazeAlgorithm order
+static const char* ALGORITHM_NAMES[MAZE_ALGORITHM_COUNT] = {
+    "backtracker", "wilson", "kruskal", "prim", "sidewinder", "binary-tree"
+};
+
+// Local function prototypes
+static bool node_grid_init(NodeGrid* grid, Maze* maze);
+static void node_open(NodeGrid* grid, int node);
+static void node_open_link(NodeGrid* grid, int node, int dir);
+static int node_neighbour(NodeGrid* grid, int node, int dir);
+
+// Get the command line name of an algorithm
+const char* maze_algorithm_name(MazeAlgorithm algorithm) {
+    if (algorithm < 0 || algorithm >= MAZE_ALGORITHM_COUNT) return "unknown";
+    return ALGORITHM_NAMES[algorithm];
+}
+
+// Look up an algorithm by its command line name
+bool maze_algorithm_parse(const char* name, MazeAlgorithm* algorithm) {
+    for (int i = 0; i < MAZE_ALGORITHM_COUNT; i++) {
+        if (strcmp(name, ALGORITHM_NAMES[i]) == 0) {
+            *algorithm = (MazeAlgorithm)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Wilson's algorithm: loop-erased random walks from every node outside the
+// maze until they hit it. Every spanning tree is equally likely. The walk
+// remembers only the last exit direction per node, which erases loops.
+void maze_carve_wilson(Maze* maze, unsigned int* seed) {
+    NodeGrid grid;
+    if (!node_grid_init(&grid, maze)) return;
+    
+    int node_count = grid.columns * grid.rows;
+    int* exit_dir = maze->scratch;
+    int* in_maze = maze->exit_distance;
+    memset(in_maze, 0, node_count * sizeof(int));
+    
+    int first = maze_random_below(seed, node_count);
+    in_maze[first] = 1;
+    node_open(&grid, first);
+    
+    for (int start = 0; start < node_count; start++) {
+        if (in_maze[start]) continue;
+        
+        // Walk until the maze is hit
+        int node = start;
+        while (!in_maze[node]) {
+            int dir;
+            int next;
+            do {
+                dir = maze_random_below(seed, 4);
+                next = node_neighbour(&grid, node, dir);
+            } while (next < 0);
+            exit_dir[node] = dir;
+            node = next;
+        }
+        
+        // Carve the loop-erased walk
+        node = start;
+        while (!in_maze[node]) {
+            in_maze[node] = 1;
+            node_open(&grid, node);
+            node_open_link(&grid, node, exit_dir[node]);
+            node = node_neighbour(&grid, node, exit_dir[node]);
+        }
+    }
+}
+
+// Kruskal's algorithm: open the links between nodes in random order, skipping
+// those whose nodes are already joined
+void maze_carve_kruskal(Maze* maze, unsigned int* seed) {
+    NodeGrid grid;
+    if (!node_grid_init(&grid, maze)) return;
+    
+    // Nodes then links (node * 2 + 0 east, node * 2 + 1 south) fit in the scratch buffer
+    int node_count = grid.columns * grid.rows;
+    int* parent = maze->scratch;
+    int* links = maze->scratch + node_count;
+    int link_count = 0;
+    
+    for (int node = 0; node < node_count; node++) {
+        parent[node] = node;
+        node_open(&grid, node);
+        if (node_neighbour(&grid, node, 1) >= 0) links[link_count++] = node * 2;
+        if (node_neighbour(&grid, node, 2) >= 0) links[link_count++] = node * 2 + 1;
+    }
+    
+    for (int i = link_count - 1; i > 0; i--) {
+        int j = maze_random_below(seed, i + 1);
+        int temp = links[i];
+        links[i] = links[j];
+        links[j] = temp;
+    }
+    
+    for (int i = 0; i < link_count; i++) {
+        int node = links[i] / 2;
+        int dir = links[i] % 2 ? 2 : 1;
+        if (maze_union_find_join(parent, node, node_neighbour(&grid, node, dir))) {
+            node_open_link(&grid, node, dir);
+        }
+    }
+}
+
+// Prim's algorithm: grow the maze from one node by attaching a random
+// frontier node to a random neighbour already in the maze
+void maze_carve_prim(Maze* maze, unsigned int* seed) {
+    NodeGrid grid;
+    if (!node_grid_init(&grid, maze)) return;
+    
+    // State per node: 0 outside, 1 on the frontier, 2 in the maze
+    int node_count = grid.columns * grid.rows;
+    int* frontier = maze->scratch;
+    int* state = maze->exit_distance;
+    int frontier_count = 0;
+    memset(state, 0, node_count * sizeof(int));
+    
+    int node = maze_random_below(seed, node_count);
+    for (;;) {
+        state[node] = 2;
+        node_open(&grid, node);
+        for (int dir = 0; dir < 4; dir++) {
+            int next = node_neighbour(&grid, node, dir);
+            if (next >= 0 && state[next] == 0) {
+                state[next] = 1;
+                frontier[frontier_count++] = next;
+            }
+        }
+        
+        if (frontier_count == 0) break;
+        
+        int pick = maze_random_below(seed, frontier_count);
+        node = frontier[pick];
+        frontier[pick] = frontier[--frontier_count];
+        
+        // Attach to one of its neighbours in the maze
+        int dirs[4];
+        int dir_count = 0;
+        for (int dir = 0; dir < 4; dir++) {
+            int next = node_neighbour(&grid, node, dir);
+            if (next >= 0 && state[next] == 2) dirs[dir_count++] = dir;
+        }
+        node_open_link(&grid, node, dirs[maze_random_below(seed, dir_count)]);
+    }
+}
+
+// Sidewinder: each row is a series of runs; a run is closed at random by
+// linking one of its nodes north. Rows draw from their own jumped stream
+// (at most two draws per node), so they are independent of each other.
+void maze_carve_sidewinder(Maze* maze, unsigned int* seed) {
+    NodeGrid grid;
+    if (!node_grid_init(&grid, maze)) return;
+    
+    unsigned int row_stride = (unsigned int)grid.columns * 2;
+    
+    for (int j = 0; j < grid.rows; j++) {
+        unsigned int row_seed = maze_random_jump(*seed, (unsigned int)j * row_stride);
+        int run_start = 0;
+        
+        for (int i = 0; i < grid.columns; i++) {
+            int node = i * grid.rows + j;
+            node_open(&grid, node);
+            
+            // The top row is one corridor
+            if (j == 0) {
+                if (i > 0) node_open_link(&grid, node, 3);
+                continue;
+            }
+            
+            bool close_run = i == grid.columns - 1 || maze_random_below(&row_seed, 2) == 0;
+            if (close_run) {
+                int pick = run_start + maze_random_below(&row_seed, i - run_start + 1);
+                node_open_link(&grid, pick * grid.rows + j, 0);
+                run_start = i + 1;
+            } else {
+                node_open_link(&grid, node, 1);
+            }
+        }
+    }
+    
+    *seed = maze_random_jump(*seed, (unsigned int)grid.rows * row_stride);
+}
+
+// Binary tree: every node links north or west. Like sidewinder, each row
+// draws from its own jumped stream (one draw per node).
+void maze_carve_binary_tree(Maze* maze, unsigned int* seed) {
+    NodeGrid grid;
+    if (!node_grid_init(&grid, maze)) return;
+    
+    unsigned int row_stride = (unsigned int)grid.columns;
+    
+    for (int j = 0; j < grid.rows; j++) {
+        unsigned int row_seed = maze_random_jump(*seed, (unsigned int)j * row_stride);
+        
+        for (int i = 0; i < grid.columns; i++) {
+            int node = i * grid.rows + j;
+            node_open(&grid, node);
+            
+            if (j > 0 && (i == 0 || maze_random_below(&row_seed, 2) == 0)) {
+                node_open_link(&grid, node, 0);
+            } else if (i > 0) {
+                node_open_link(&grid, node, 3);
+            }
+        }
+    }
+    
+    *seed = maze_random_jump(*seed, (unsigned int)grid.rows * row_stride);
+}
+
+// Open a fraction of the dead ends into loops, for races with more than one
+// viable route. Dead ends are collected in one scan; each chosen one that is
+// still a dead end when its turn comes gets a wall opened toward an open cell
+// beyond it. The distance field is relaxed from each opening rather than
+// recomputed. Returns the number of walls opened.
+int maze_braid(Maze* maze, float fraction, unsigned int seed) {
+    if (fraction <= 0.0f) return 0;
+    if (fraction > 1.0f) fraction = 1.0f;
+    
+    int width = maze->width;
+    int height = maze->height;
+    size_t list_size = (size_t)width * height * sizeof(int);
+    int* dead_ends = maze->arena ? (int*)arena_alloc(maze->arena, list_size) : (int*)malloc(list_size);
+    if (!dead_ends) return 0;
+    
+    int dead_end_count = 0;
+    for (int x = 1; x < width - 1; x++) {
+        for (int y = 1; y < height - 1; y++) {
+            if (maze_is_wall(maze, x, y) || maze->cells[x][y] == CELL_START || maze->cells[x][y] == CELL_EXIT) continue;
+            
+            int degree = !maze_is_wall(maze, x, y - 1) + !maze_is_wall(maze, x + 1, y)
+                       + !maze_is_wall(maze, x, y + 1) + !maze_is_wall(maze, x - 1, y);
+            if (degree == 1) {
+                dead_ends[dead_end_count++] = x * height + y;
+            }
+        }
+    }
+    
+    // Draw from a stream far away from the one the carver used
+    unsigned int state = maze_random_jump(seed, 1u << 30);
+    int chosen = (int)(fraction * dead_end_count + 0.5f);
+    int opened = 0;
+    
+    for (int i = 0; i < chosen; i++) {
+        // Partial shuffle: pick the next dead end at random from the rest
+        int pick = i + maze_random_below(&state, dead_end_count - i);
+        int cell = dead_ends[pick];
+        dead_ends[pick] = dead_ends[i];
+        dead_ends[i] = cell;
+        
+        int x = cell / height;
+        int y = cell % height;
+        int open_sides = !maze_is_wall(maze, x, y - 1) + !maze_is_wall(maze, x + 1, y)
+                       + !maze_is_wall(maze, x, y + 1) + !maze_is_wall(maze, x - 1, y);
+        if (open_sides != 1) continue; // An earlier opening already joined it
+        
+        // Plain interior walls with an open cell behind them
+        int dirs[4];
+        int dir_count = 0;
+        for (int dir = 0; dir < 4; dir++) {
+            int wall_x = x + NODE_DX[dir];
+            int wall_y = y + NODE_DY[dir];
+            if (wall_x < 1 || wall_x >= width - 1 || wall_y < 1 || wall_y >= height - 1) continue;
+            if (maze->cells[wall_x][wall_y] != CELL_WALL) continue;
+            if (maze_is_wall(maze, wall_x + NODE_DX[dir], wall_y + NODE_DY[dir])) continue;
+            dirs[dir_count++] = dir;
+        }
+        if (dir_count == 0) continue;
+        
+        int dir = dirs[maze_random_below(&state, dir_count)];
+        maze->cells[x + NODE_DX[dir]][y + NODE_DY[dir]] = CELL_EMPTY;
+        maze_relax_distance_field(maze, x + NODE_DX[dir], y + NODE_DY[dir]);
+        opened++;
+    }
+    
+    if (!maze->arena) {
+        free(dead_ends);
+    }
+    return opened;
+}
+
+// Generate next random number (the low state bits cycle with short periods, so drop them)
+unsigned int maze_random_next(unsigned int* seed) {
+    *seed = (*seed * RANDOM_MULTIPLIER + RANDOM_INCREMENT) & RANDOM_MASK;
+    return *seed >> 8;
+}
+
+// Random number in [0, bound) from the high bits of the next draw. The low
+// bits of an LCG repeat quickly (bits 8-9 every 1024 draws), which can trap
+// a random walk in a cycle.
+int maze_random_below(unsigned int* seed, int bound) {
+    return (int)(((unsigned long long)maze_random_next(seed) * (unsigned int)bound) >> 23);
+}
+
+// State after `steps` calls of maze_random_next, by squaring the LCG step
+unsigned int maze_random_jump(unsigned int seed, unsigned int steps) {
+    unsigned int multiplier = RANDOM_MULTIPLIER;
+    unsigned int increment = RANDOM_INCREMENT;
+    unsigned int jump_multiplier = 1;
+    unsigned int jump_increment = 0;
+    
+    while (steps > 0) {
+        if (steps & 1) {
+            jump_multiplier *= multiplier;
+            jump_increment = jump_increment * multiplier + increment;
+        }
+        increment *= multiplier + 1;
+        multiplier *= multiplier;
+        steps >>= 1;
+    }
+    
+    return (jump_multiplier * seed + jump_increment) & RANDOM_MASK;
+}
+
+// Root of a union-find set, halving the path on the way up
+int maze_union_find_root(int* parent, int index) {
+    while (parent[index] != index) {
+        parent[index] = parent[parent[index]];
+        index = parent[index];
+    }
+    return index;
+}
+
+// Merge two union-find sets under the lower root; false if already merged
+bool maze_union_find_join(int* parent, int a, int b) {
+    int root_a = maze_union_find_root(parent, a);
+    int root_b = maze_union_find_root(parent, b);
+    if (root_a == root_b) return false;
+    
+    if (root_a < root_b) {
+        parent[root_b] = root_a;
+    } else {
+        parent[root_a] = root_b;
+    }
+    return true;
+}
+
+// Helper: Size the node grid; false if the maze is too small for one node
+static bool node_grid_init(NodeGrid* grid, Maze* maze) {
+    grid->maze = maze;
+    grid->columns = (maze->width - 1) / 2;
+    grid->rows = (maze->height - 1) / 2;
+    return grid->columns > 0 && grid->rows > 0;
+}
+
+// Helper: Open the cell of a node
+static void node_open(NodeGrid* grid, int node) {
+    int x = node / grid->rows * 2 + 1;
+    int y = node % grid->rows * 2 + 1;
+    grid->maze->cells[x][y] = CELL_EMPTY;
+}
+
+// Helper: Open the passage cell between a node and its neighbour in dir
+static void node_open_link(NodeGrid* grid, int node, int dir) {
+    int x = node / grid->rows * 2 + 1 + NODE_DX[dir];
+    int y = node % grid->rows * 2 + 1 + NODE_DY[dir];
+    grid->maze->cells[x][y] = CELL_EMPTY;
+}
+
+// Helper: Neighbouring node in dir, or -1 off the grid
+static int node_neighbour(NodeGrid* grid, int node, int dir) {
+    int i = node / grid->rows + NODE_DX[dir];
+    int j = node % grid->rows + NODE_DY[dir];
+    if (i < 0 || i >= grid->columns || j < 0 || j >= grid->rows) return -1;
+    return i * grid->rows + j;
+}
@@ -0,0 +1,637 @@
+#include "maze/graph.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Neighbour offsets in edge direction order (north, east, south, west)
+static const int GRAPH_DX[4] = {0, 1, 0, -1};
+static const int GRAPH_DY[4] = {-1, 0, 1, 0};
+
+// Parent markers of the nodes a search starts from
+#define GRAPH_FROM_START -1        // The start cell is this node
+#define GRAPH_FROM_SOURCE_SIDE -2  // Reached backwards along the start's corridor
+#define GRAPH_FROM_TARGET_SIDE -3  // Reached forwards along the start's corridor
+
+// How the best route found by a search reaches the goal cell
+typedef enum {
+    GOAL_NONE = 0,
+    GOAL_AT_NODE,          // The goal is a node
+    GOAL_FROM_SOURCE,      // Along the goal's corridor from its source node
+    GOAL_FROM_TARGET,      // Along the goal's corridor from its target node
+    GOAL_DIRECT            // Start and goal share a corridor
+} GraphGoalRoute;
+
+// Best route to the goal cell
+typedef struct {
+    int distance;
+    GraphGoalRoute route;
+    int node;
+} GraphGoal;
+
+// A growing [x0, y0, x1, y1, ...] cell list
+typedef struct {
+    int* cells;
+    int count;
+    int capacity;
+} GraphPath;
+
+// Local function prototypes
+static void graph_on_maze_change(Maze* maze, const MazeCellChange* changes, int change_count, void* user_data);
+static bool graph_rebuild(MazeGraph* graph);
+static bool graph_trace(MazeGraph* graph);
+static bool graph_reserve(MazeGraph* graph, int node_count, int edge_count);
+static bool graph_is_open(Maze* maze, int x, int y);
+static void graph_search(MazeGraph* graph, int start_cell, int goal_cell, GraphGoal* goal);
+static void graph_seed(MazeGraph* graph, int node, int distance, int marker);
+static void graph_heap_push(MazeGraph* graph, int distance, int node);
+static MazeGraphHeapEntry graph_heap_pop(MazeGraph* graph);
+static int* graph_walk(MazeGraph* graph, int edge, int steps);
+static bool graph_path_add(GraphPath* path, int x, int y);
+static bool graph_path_add_walk(MazeGraph* graph, GraphPath* path, int edge, int first, int last);
+
+// Create the junction graph of a generated maze; it follows later edits through a maze listener
+MazeGraph* maze_graph_create(Maze* maze) {
+    MazeGraph* graph = (MazeGraph*)calloc(1, sizeof(MazeGraph));
+    if (!graph) return NULL;
+    
+    int cell_count = maze->width * maze->height;
+    graph->maze = maze;
+    graph->dirty = true;
+    graph->cell_node = (int*)malloc(cell_count * sizeof(int));
+    graph->cell_edge = (int*)malloc(cell_count * sizeof(int));
+    graph->cell_offset = (int*)malloc(cell_count * sizeof(int));
+    
+    if (!graph->cell_node || !graph->cell_edge || !graph->cell_offset ||
+        !maze_add_listener(maze, graph_on_maze_change, graph) || !maze_graph_update(graph)) {
+        maze_graph_destroy(graph);
+        return NULL;
+    }
+    
+    return graph;
+}
+
+// Free the graph and detach it from its maze
+void maze_graph_destroy(MazeGraph* graph) {
+    if (!graph) return;
+    
+    maze_remove_listener(graph->maze, graph_on_maze_change, graph);
+    
+    free(graph->node_cell);
+    free(graph->edge_offsets);
+    free(graph->edge_sources);
+    free(graph->edge_targets);
+    free(graph->edge_weights);
+    free(graph->edge_reverse);
+    free(graph->edge_dirs);
+    free(graph->cell_node);
+    free(graph->cell_edge);
+    free(graph->cell_offset);
+    free(graph->distance);
+    free(graph->parent_edge);
+    free(graph->heap);
+    free(graph);
+}
+
+// Rebuild the graph if the maze changed since the last build (queries call this)
+bool maze_graph_update(MazeGraph* graph) {
+    if (!graph->dirty) return true;
+    if (!graph_rebuild(graph)) return false;
+    
+    graph->dirty = false;
+    return true;
+}
+
+// Steps on a shortest path between two open cells (MAZE_UNREACHABLE if none)
+int maze_graph_distance(MazeGraph* graph, int start_x, int start_y, int goal_x, int goal_y) {
+    Maze* maze = graph->maze;
+    if (!maze_graph_update(graph)) return MAZE_UNREACHABLE;
+    if (!graph_is_open(maze, start_x, start_y) || !graph_is_open(maze, goal_x, goal_y)) return MAZE_UNREACHABLE;
+    
+    GraphGoal goal;
+    graph_search(graph, start_x * maze->height + start_y, goal_x * maze->height + goal_y, &goal);
+    return goal.route == GOAL_NONE ? MAZE_UNREACHABLE : goal.distance;
+}
+
+// Find a shortest path [x0, y0, x1, y1, ...] between two open cells (caller frees).
+// The search runs on the graph; only the corridors of the result are walked.
+bool maze_graph_find_path(MazeGraph* graph, int start_x, int start_y, int goal_x, int goal_y,
+                          int** path, int* path_length) {
+    *path = NULL;
+    *path_length = 0;
+    
+    Maze* maze = graph->maze;
+    if (!maze_graph_update(graph)) return false;
+    if (!graph_is_open(maze, start_x, start_y) || !graph_is_open(maze, goal_x, goal_y)) return false;
+    
+    int start_cell = start_x * maze->height + start_y;
+    int goal_cell = goal_x * maze->height + goal_y;
+    GraphGoal goal;
+    graph_search(graph, start_cell, goal_cell, &goal);
+    if (goal.route == GOAL_NONE) return false;
+    
+    GraphPath result = {NULL, 0, 0};
+    bool ok = graph_path_add(&result, start_x, start_y);
+    
+    int start_edge = graph->cell_edge[start_cell];
+    int start_offset = graph->cell_offset[start_cell];
+    int goal_edge = graph->cell_edge[goal_cell];
+    int goal_offset = graph->cell_offset[goal_cell];
+    
+    if (goal.route == GOAL_DIRECT) {
+        // Along the shared corridor, either way
+        if (goal_offset > start_offset) {
+            ok = ok && graph_path_add_walk(graph, &result, start_edge, start_offset, goal_offset - 1);
+        } else if (goal_offset < start_offset) {
+            ok = ok && graph_path_add_walk(graph, &result, start_edge, start_offset - 2, goal_offset - 1);
+        }
+    } else {
+        // Collect the edges from the goal side back to the node the search started from
+        int edge_count = 0;
+        int node = goal.node;
+        while (graph->parent_edge[node] >= 0) {
+            node = graph->edge_sources[graph->parent_edge[node]];
+            edge_count++;
+        }
+        int marker = graph->parent_edge[node];
+        
+        int* edges = (int*)malloc((edge_count + 1) * sizeof(int));
+        ok = ok && edges;
+        node = goal.node;
+        for (int i = edge_count - 1; ok && i >= 0; i--) {
+            edges[i] = graph->parent_edge[node];
+            node = graph->edge_sources[edges[i]];
+        }
+        
+        // From the start to the first node, backwards along the start's corridor
+        if (ok && marker == GRAPH_FROM_SOURCE_SIDE) {
+            ok = graph_path_add_walk(graph, &result, start_edge, start_offset - 2, -1);
+        } else if (ok && marker == GRAPH_FROM_TARGET_SIDE) {
+            int reverse = graph->edge_reverse[start_edge];
+            int steps = graph->edge_weights[start_edge] - start_offset;
+            ok = graph_path_add_walk(graph, &result, reverse, steps - 2, -1);
+        }
+        
+        // Whole corridors between nodes
+        for (int i = 0; ok && i < edge_count; i++) {
+            ok = graph_path_add_walk(graph, &result, edges[i], 0, graph->edge_weights[edges[i]] - 1);
+        }
+        free(edges);
+        
+        // Into the goal's corridor
+        if (ok && goal.route == GOAL_FROM_SOURCE) {
+            ok = graph_path_add_walk(graph, &result, goal_edge, 0, goal_offset - 1);
+        } else if (ok && goal.route == GOAL_FROM_TARGET) {
+            int steps = graph->edge_weights[goal_edge] - goal_offset;
+            ok = graph_path_add_walk(graph, &result, graph->edge_reverse[goal_edge], 0, steps - 1);
+        }
+    }
+    
+    if (!ok) {
+        free(result.cells);
+        return false;
+    }
+    
+    *path = result.cells;
+    *path_length = result.count;
+    return true;
+}
+
+// Steps from an open cell to every cell (index x * height + y, MAZE_UNREACHABLE
+// for walls and cut-off cells). Distances are found for the nodes only, then
+// corridor cells take the nearer of their two ends in one linear pass.
+void maze_graph_distance_field(MazeGraph* graph, int x, int y, int* cell_distance) {
+    Maze* maze = graph->maze;
+    int cell_count = maze->width * maze->height;
+    for (int i = 0; i < cell_count; i++) {
+        cell_distance[i] = MAZE_UNREACHABLE;
+    }
+    if (!maze_graph_update(graph) || !graph_is_open(maze, x, y)) return;
+    
+    int start_cell = x * maze->height + y;
+    graph_search(graph, start_cell, -1, NULL);
+    
+    int start_edge = graph->cell_edge[start_cell];
+    int start_offset = graph->cell_offset[start_cell];
+    
+    for (int cell = 0; cell < cell_count; cell++) {
+        int node = graph->cell_node[cell];
+        if (node >= 0) {
+            if (graph->distance[node] != INT_MAX) cell_distance[cell] = graph->distance[node];
+            continue;
+        }
+        
+        int edge = graph->cell_edge[cell];
+        if (edge < 0) continue;
+        
+        int offset = graph->cell_offset[cell];
+        int best = INT_MAX;
+        int from_source = graph->distance[graph->edge_sources[edge]];
+        int from_target = graph->distance[graph->edge_targets[edge]];
+        if (from_source != INT_MAX) best = from_source + offset;
+        if (from_target != INT_MAX && from_target + graph->edge_weights[edge] - offset < best) {
+            best = from_target + graph->edge_weights[edge] - offset;
+        }
+        if (edge == start_edge && graph->cell_node[start_cell] < 0 && abs(offset - start_offset) < best) {
+            best = abs(offset - start_offset);
+        }
+        if (best != INT_MAX) cell_distance[cell] = best;
+    }
+}
+
+// Helper: Maze listener - any edit may join or split corridors
+static void graph_on_maze_change(Maze* maze, const MazeCellChange* changes, int change_count, void* user_data) {
+    (void)maze;
+    (void)changes;
+    (void)change_count;
+    ((MazeGraph*)user_data)->dirty = true;
+}
+
+// Helper: Find nodes and trace every corridor between them
+static bool graph_rebuild(MazeGraph* graph) {
+    Maze* maze = graph->maze;
+    int height = maze->height;
+    int cell_count = maze->width * height;
+    
+    // Junctions, dead ends and the exit are nodes (marked 0, numbered by graph_trace)
+    for (int cell = 0; cell < cell_count; cell++) {
+        int x = cell / height;
+        int y = cell % height;
+        graph->cell_node[cell] = -1;
+        if (!graph_is_open(maze, x, y)) continue;
+        
+        int degree = 0;
+        for (int dir = 0; dir < 4; dir++) {
+            if (graph_is_open(maze, x + GRAPH_DX[dir], y + GRAPH_DY[dir])) degree++;
+        }
+        if (degree != 2 || (x == maze->exit_x && y == maze->exit_y)) {
+            graph->cell_node[cell] = 0;
+        }
+    }
+    
+    if (!graph_trace(graph)) return false;
+    
+    // Loops made only of corridor cells have no node yet: promote one cell of each
+    bool promoted = false;
+    for (int cell = 0; cell < cell_count; cell++) {
+        int x = cell / height;
+        int y = cell % height;
+        if (graph->cell_node[cell] >= 0 || graph->cell_edge[cell] >= 0 || graph->cell_edge[cell] == -2) continue;
+        if (!graph_is_open(maze, x, y)) continue;
+        
+        graph->cell_node[cell] = 0;
+        promoted = true;
+        
+        // Claim the rest of the loop so it gets no second node
+        int px = x;
+        int py = y;
+        int cx = x;
+        int cy = y;
+        do {
+            for (int dir = 0; dir < 4; dir++) {
+                int nx = cx + GRAPH_DX[dir];
+                int ny = cy + GRAPH_DY[dir];
+                if ((nx != px || ny != py) && graph_is_open(maze, nx, ny)) {
+                    px = cx;
+                    py = cy;
+                    cx = nx;
+                    cy = ny;
+                    break;
+                }
+            }
+            graph->cell_edge[cx * height + cy] = -2;
+        } while (cx != x || cy != y);
+    }
+    
+    return !promoted || graph_trace(graph);
+}
+
+// Helper: Number the marked nodes and fill the CSR edge arrays
+static bool graph_trace(MazeGraph* graph) {
+    Maze* maze = graph->maze;
+    int height = maze->height;
+    int cell_count = maze->width * height;
+    
+    // Number nodes in cell order and count their edges (one per open side)
+    int node_count = 0;
+    int edge_count = 0;
+    for (int cell = 0; cell < cell_count; cell++) {
+        graph->cell_edge[cell] = -1;
+        if (graph->cell_node[cell] < 0) continue;
+        
+        graph->cell_node[cell] = node_count++;
+        for (int dir = 0; dir < 4; dir++) {
+            if (graph_is_open(maze, cell / height + GRAPH_DX[dir], cell % height + GRAPH_DY[dir])) edge_count++;
+        }
+    }
+    
+    if (!graph_reserve(graph, node_count, edge_count)) return false;
+    graph->node_count = node_count;
+    graph->edge_count = edge_count;
+    
+    int edge = 0;
+    for (int cell = 0; cell < cell_count; cell++) {
+        int node = graph->cell_node[cell];
+        if (node < 0) continue;
+        
+        graph->node_cell[node] = cell;
+        graph->edge_offsets[node] = edge;
+        
+        for (int dir = 0; dir < 4; dir++) {
+            int px = cell / height;
+            int py = cell % height;
+            int x = px + GRAPH_DX[dir];
+            int y = py + GRAPH_DY[dir];
+            if (!graph_is_open(maze, x, y)) continue;
+            
+            // Walk the corridor to the next node
+            int last_dir = dir;
+            int steps = 1;
+            while (graph->cell_node[x * height + y] < 0) {
+                int corridor_cell = x * height + y;
+                if (graph->cell_edge[corridor_cell] < 0) {
+                    graph->cell_edge[corridor_cell] = edge;
+                    graph->cell_offset[corridor_cell] = steps;
+                }
+                
+                // Corridor cells have exactly one other open side
+                for (int next = 0; next < 4; next++) {
+                    int nx = x + GRAPH_DX[next];
+                    int ny = y + GRAPH_DY[next];
+                    if ((nx != px || ny != py) && graph_is_open(maze, nx, ny)) {
+                        last_dir = next;
+                        break;
+                    }
+                }
+                px = x;
+                py = y;
+                x += GRAPH_DX[last_dir];
+                y += GRAPH_DY[last_dir];
+                steps++;
+            }
+            
+            graph->edge_sources[edge] = node;
+            graph->edge_targets[edge] = graph->cell_node[x * height + y];
+            graph->edge_weights[edge] = steps;
+            graph->edge_dirs[edge] = (unsigned char)dir;
+            graph->edge_reverse[edge] = last_dir; // Direction of arrival until the pass below
+            edge++;
+        }
+    }
+    graph->edge_offsets[node_count] = edge;
+    
+    // The reverse edge leaves the target opposite to the direction of arrival
+    for (int i = 0; i < edge_count; i++) {
+        int target = graph->edge_targets[i];
+        int target_cell = graph->node_cell[target];
+        int back = (graph->edge_reverse[i] + 2) % 4;
+        int reverse = graph->edge_offsets[target];
+        for (int dir = 0; dir < back; dir++) {
+            if (graph_is_open(maze, target_cell / height + GRAPH_DX[dir], target_cell % height + GRAPH_DY[dir])) {
+                reverse++;
+            }
+        }
+        graph->edge_reverse[i] = reverse;
+    }
+    
+    return true;
+}
+
+// Helper: Grow the node and edge arrays
+static bool graph_reserve(MazeGraph* graph, int node_count, int edge_count) {
+    if (node_count + 1 > graph->node_capacity) {
+        int capacity = node_count + 1;
+        int* node_cell = (int*)realloc(graph->node_cell, capacity * sizeof(int));
+        if (node_cell) graph->node_cell = node_cell;
+        int* offsets = (int*)realloc(graph->edge_offsets, capacity * sizeof(int));
+        if (offsets) graph->edge_offsets = offsets;
+        int* distance = (int*)realloc(graph->distance, capacity * sizeof(int));
+        if (distance) graph->distance = distance;
+        int* parent_edge = (int*)realloc(graph->parent_edge, capacity * sizeof(int));
+        if (parent_edge) graph->parent_edge = parent_edge;
+        if (!node_cell || !offsets || !distance || !parent_edge) return false;
+        graph->node_capacity = capacity;
+    }
+    
+    if (edge_count > graph->edge_capacity) {
+        int capacity = edge_count;
+        int* sources = (int*)realloc(graph->edge_sources, capacity * sizeof(int));
+        if (sources) graph->edge_sources = sources;
+        int* targets = (int*)realloc(graph->edge_targets, capacity * sizeof(int));
+        if (targets) graph->edge_targets = targets;
+        int* weights = (int*)realloc(graph->edge_weights, capacity * sizeof(int));
+        if (weights) graph->edge_weights = weights;
+        int* reverse = (int*)realloc(graph->edge_reverse, capacity * sizeof(int));
+        if (reverse) graph->edge_reverse = reverse;
+        unsigned char* dirs = (unsigned char*)realloc(graph->edge_dirs, capacity);
+        if (dirs) graph->edge_dirs = dirs;
+        if (!sources || !targets || !weights || !reverse || !dirs) return false;
+        graph->edge_capacity = capacity;
+    }
+    
+    return true;
+}
+
+// Helper: Check whether a cell can be walked through
+static bool graph_is_open(Maze* maze, int x, int y) {
+    return !maze_is_wall(maze, x, y);
+}
+
+// Helper: Dijkstra over the nodes from an open cell. With a goal cell the
+// search stops once nothing cheaper than the best route to it can remain.
+static void graph_search(MazeGraph* graph, int start_cell, int goal_cell, GraphGoal* goal) {
+    for (int i = 0; i < graph->node_count; i++) {
+        graph->distance[i] = INT_MAX;
+    }
+    graph->heap_size = 0;
+    
+    // A start on a corridor enters the graph at both of its ends
+    int start_node = graph->cell_node[start_cell];
+    int start_edge = graph->cell_edge[start_cell];
+    if (start_node >= 0) {
+        graph_seed(graph, start_node, 0, GRAPH_FROM_START);
+    } else {
+        int offset = graph->cell_offset[start_cell];
+        graph_seed(graph, graph->edge_sources[start_edge], offset, GRAPH_FROM_SOURCE_SIDE);
+        graph_seed(graph, graph->edge_targets[start_edge], graph->edge_weights[start_edge] - offset,
+                   GRAPH_FROM_TARGET_SIDE);
+    }
+    
+    int goal_node = -1;
+    int goal_edge = -1;
+    int goal_offset = 0;
+    if (goal) {
+        goal->distance = INT_MAX;
+        goal->route = GOAL_NONE;
+        goal->node = -1;
+        goal_node = graph->cell_node[goal_cell];
+        goal_edge = graph->cell_edge[goal_cell];
+        goal_offset = graph->cell_offset[goal_cell];
+        
+        if (start_node < 0 && goal_node < 0 && start_edge == goal_edge) {
+            goal->distance = abs(goal_offset - graph->cell_offset[start_cell]);
+            goal->route = GOAL_DIRECT;
+        }
+    }
+    
+    while (graph->heap_size > 0) {
+        MazeGraphHeapEntry entry = graph_heap_pop(graph);
+        int node = entry.node;
+        if (entry.distance > graph->distance[node]) continue;
+        if (goal && entry.distance >= goal->distance) break;
+        
+        // Reach the goal from this node
+        if (goal && goal_node >= 0 && node == goal_node) {
+            goal->distance = entry.distance;
+            goal->route = GOAL_AT_NODE;
+            goal->node = node;
+            break;
+        }
+        if (goal && goal_node < 0) {
+            if (node == graph->edge_sources[goal_edge] && entry.distance + goal_offset < goal->distance) {
+                goal->distance = entry.distance + goal_offset;
+                goal->route = GOAL_FROM_SOURCE;
+                goal->node = node;
+            }
+            int to_goal = graph->edge_weights[goal_edge] - goal_offset;
+            if (node == graph->edge_targets[goal_edge] && entry.distance + to_goal < goal->distance) {
+                goal->distance = entry.distance + to_goal;
+                goal->route = GOAL_FROM_TARGET;
+                goal->node = node;
+            }
+        }
+        
+        for (int edge = graph->edge_offsets[node]; edge < graph->edge_offsets[node + 1]; edge++) {
+            int target = graph->edge_targets[edge];
+            int distance = entry.distance + graph->edge_weights[edge];
+            if (distance < graph->distance[target]) {
+                graph->distance[target] = distance;
+                graph->parent_edge[target] = edge;
+                graph_heap_push(graph, distance, target);
+            }
+        }
+    }
+}
+
+// Helper: Enter the graph at a node
+static void graph_seed(MazeGraph* graph, int node, int distance, int marker) {
+    if (distance >= graph->distance[node]) return;
+    
+    graph->distance[node] = distance;
+    graph->parent_edge[node] = marker;
+    graph_heap_push(graph, distance, node);
+}
+
+// Helper: Push onto the binary min-heap of the open list
+static void graph_heap_push(MazeGraph* graph, int distance, int node) {
+    if (graph->heap_size == graph->heap_capacity) {
+        int capacity = graph->heap_capacity ? graph->heap_capacity * 2 : 256;
+        MazeGraphHeapEntry* grown = (MazeGraphHeapEntry*)realloc(graph->heap, capacity * sizeof(MazeGraphHeapEntry));
+        if (!grown) return;
+        graph->heap = grown;
+        graph->heap_capacity = capacity;
+    }
+    
+    int index = graph->heap_size++;
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (graph->heap[parent].distance <= distance) break;
+        graph->heap[index] = graph->heap[parent];
+        index = parent;
+    }
+    graph->heap[index].distance = distance;
+    graph->heap[index].node = node;
+}
+
+// Helper: Pop the entry with the lowest distance
+static MazeGraphHeapEntry graph_heap_pop(MazeGraph* graph) {
+    MazeGraphHeapEntry top = graph->heap[0];
+    MazeGraphHeapEntry last = graph->heap[--graph->heap_size];
+    
+    int index = 0;
+    for (;;) {
+        int child = index * 2 + 1;
+        if (child >= graph->heap_size) break;
+        if (child + 1 < graph->heap_size && graph->heap[child + 1].distance < graph->heap[child].distance) child++;
+        if (last.distance <= graph->heap[child].distance) break;
+        graph->heap[index] = graph->heap[child];
+        index = child;
+    }
+    if (graph->heap_size > 0) {
+        graph->heap[index] = last;
+    }
+    return top;
+}
+
+// Helper: Cells [x, y, ...] of the first `steps` steps along an edge (caller frees)
+static int* graph_walk(MazeGraph* graph, int edge, int steps) {
+    Maze* maze = graph->maze;
+    int* cells = (int*)malloc((steps > 0 ? steps : 1) * 2 * sizeof(int));
+    if (!cells) return NULL;
+    
+    int source_cell = graph->node_cell[graph->edge_sources[edge]];
+    int px = source_cell / maze->height;
+    int py = source_cell % maze->height;
+    int x = px + GRAPH_DX[graph->edge_dirs[edge]];
+    int y = py + GRAPH_DY[graph->edge_dirs[edge]];
+    
+    for (int step = 0; step < steps; step++) {
+        cells[step * 2] = x;
+        cells[step * 2 + 1] = y;
+        if (step + 1 == steps) break;
+        
+        for (int dir = 0; dir < 4; dir++) {
+            int nx = x + GRAPH_DX[dir];
+            int ny = y + GRAPH_DY[dir];
+            if ((nx != px || ny != py) && graph_is_open(maze, nx, ny)) {
+                px = x;
+                py = y;
+                x = nx;
+                y = ny;
+                break;
+            }
+        }
+    }
+    
+    return cells;
+}
+
+// Helper: Append one cell to a path
+static bool graph_path_add(GraphPath* path, int x, int y) {
+    if (path->count == path->capacity) {
+        int capacity = path->capacity ? path->capacity * 2 : 64;
+        int* grown = (int*)realloc(path->cells, capacity * 2 * sizeof(int));
+        if (!grown) return false;
+        path->cells = grown;
+        path->capacity = capacity;
+    }
+    
+    path->cells[path->count * 2] = x;
+    path->cells[path->count * 2 + 1] = y;
+    path->count++;
+    return true;
+}
+
+// Helper: Append cells first..last (step indices along an edge, either order;
+// -1 is the source node itself) to a path
+static bool graph_path_add_walk(MazeGraph* graph, GraphPath* path, int edge, int first, int last) {
+    int steps = (first > last ? first : last) + 1;
+    int* cells = graph_walk(graph, edge, steps);
+    if (!cells) return false;
+    
+    int source_cell = graph->node_cell[graph->edge_sources[edge]];
+    int step = first;
+    int direction = first <= last ? 1 : -1;
+    bool ok = true;
+    for (;;) {
+        if (step < 0) {
+            ok = ok && graph_path_add(path, source_cell / graph->maze->height, source_cell % graph->maze->height);
+        } else {
+            ok = ok && graph_path_add(path, cells[step * 2], cells[step * 2 + 1]);
+        }
+        if (step == last) break;
+        step += direction;
+    }
+    
+    free(cells);
+    return ok;
+}
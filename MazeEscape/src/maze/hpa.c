@@ -0,0 +1,572 @@
+#include "maze/hpa.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Neighbour offsets in portal direction order (north, east, south, west)
+static const int HPA_DX[4] = {0, 1, 0, -1};
+static const int HPA_DY[4] = {-1, 0, 1, 0};
+
+// Local function prototypes
+static void hpa_on_maze_change(Maze* maze, const MazeCellChange* changes, int change_count, void* user_data);
+static HpaSector* hpa_get_sector(MazeHpa* hpa, int sector);
+static void hpa_build_sector(MazeHpa* hpa, int sector);
+static void hpa_add_border_portals(MazeHpa* hpa, HpaSector* cache, int x, int y, int step_x, int step_y,
+                                   int length, int dir);
+static void hpa_local_search(MazeHpa* hpa, int sector, int from_x, int from_y);
+static int hpa_local_distance(MazeHpa* hpa, int sector, int x, int y);
+static int hpa_sector_of(MazeHpa* hpa, int x, int y);
+static int hpa_find_partner(MazeHpa* hpa, const HpaPortal* portal, int* partner_sector);
+static void hpa_relax(MazeHpa* hpa, int node, int cost, int parent, int x, int y, int goal_x, int goal_y);
+static bool hpa_heap_push(MazeHpa* hpa, int estimate, int node);
+static HpaHeapEntry hpa_heap_pop(MazeHpa* hpa);
+static bool hpa_append_cells(int** cells, int* count, int* capacity, const int* more, int more_count);
+
+// Create a planner for a generated maze; it follows later edits through a maze listener
+MazeHpa* hpa_create(Maze* maze, int sector_size) {
+    if (sector_size < 2) sector_size = HPA_DEFAULT_SECTOR_SIZE;
+    
+    MazeHpa* hpa = (MazeHpa*)calloc(1, sizeof(MazeHpa));
+    if (!hpa) return NULL;
+    
+    hpa->maze = maze;
+    hpa->sector_size = sector_size;
+    hpa->sectors_x = (maze->width + sector_size - 1) / sector_size;
+    hpa->sectors_y = (maze->height + sector_size - 1) / sector_size;
+    
+    // A border holds at most one portal per two cells (runs are separated by walls)
+    hpa->max_portals = 4 * ((sector_size + 1) / 2);
+    
+    int sector_count = hpa->sectors_x * hpa->sectors_y;
+    int node_count = sector_count * hpa->max_portals + 2; // Plus start and goal
+    
+    hpa->sectors = (HpaSector*)calloc(sector_count, sizeof(HpaSector));
+    hpa->cost = (int*)malloc(node_count * sizeof(int));
+    hpa->parent = (int*)malloc(node_count * sizeof(int));
+    hpa->visit_stamp = (unsigned int*)calloc(node_count, sizeof(unsigned int));
+    hpa->goal_cost = (int*)malloc(hpa->max_portals * sizeof(int));
+    hpa->local_distance = (int*)malloc(sector_size * sector_size * sizeof(int));
+    hpa->local_queue = (int*)malloc(sector_size * sector_size * sizeof(int));
+    hpa->heap_capacity = 256;
+    hpa->heap = (HpaHeapEntry*)malloc(hpa->heap_capacity * sizeof(HpaHeapEntry));
+    
+    if (!hpa->sectors || !hpa->cost || !hpa->parent || !hpa->visit_stamp || !hpa->goal_cost ||
+        !hpa->local_distance || !hpa->local_queue || !hpa->heap ||
+        !maze_add_listener(maze, hpa_on_maze_change, hpa)) {
+        hpa_destroy(hpa);
+        return NULL;
+    }
+    
+    // Sectors are abstracted on first use
+    for (int i = 0; i < sector_count; i++) {
+        hpa->sectors[i].dirty = true;
+    }
+    
+    return hpa;
+}
+
+// Free the planner and detach it from its maze
+void hpa_destroy(MazeHpa* hpa) {
+    if (!hpa) return;
+    
+    maze_remove_listener(hpa->maze, hpa_on_maze_change, hpa);
+    
+    if (hpa->sectors) {
+        for (int i = 0; i < hpa->sectors_x * hpa->sectors_y; i++) {
+            free(hpa->sectors[i].portals);
+            free(hpa->sectors[i].distances);
+        }
+    }
+    
+    free(hpa->sectors);
+    free(hpa->cost);
+    free(hpa->parent);
+    free(hpa->visit_stamp);
+    free(hpa->goal_cost);
+    free(hpa->local_distance);
+    free(hpa->local_queue);
+    free(hpa->heap);
+    free(hpa);
+}
+
+// Mark the sectors whose abstraction depends on a cell as stale. Interior
+// cells only affect their own sector; border cells also change the portals
+// of the neighbouring sector.
+void hpa_invalidate_cell(MazeHpa* hpa, int x, int y) {
+    Maze* maze = hpa->maze;
+    if (x < 0 || x >= maze->width || y < 0 || y >= maze->height) return;
+    
+    int size = hpa->sector_size;
+    int sx = x / size;
+    int sy = y / size;
+    hpa->sectors[sx * hpa->sectors_y + sy].dirty = true;
+    
+    if (x % size == 0 && sx > 0) {
+        hpa->sectors[(sx - 1) * hpa->sectors_y + sy].dirty = true;
+    }
+    if (x % size == size - 1 && x + 1 < maze->width) {
+        hpa->sectors[(sx + 1) * hpa->sectors_y + sy].dirty = true;
+    }
+    if (y % size == 0 && sy > 0) {
+        hpa->sectors[sx * hpa->sectors_y + sy - 1].dirty = true;
+    }
+    if (y % size == size - 1 && y + 1 < maze->height) {
+        hpa->sectors[sx * hpa->sectors_y + sy + 1].dirty = true;
+    }
+}
+
+// Find the cells where a path from start to goal changes sector, as
+// [x0, y0, x1, y1, ...] from the start to the goal (caller frees). Consecutive
+// waypoints are either neighbours or in the same sector; hpa_refine_segment
+// turns each pair into cells when the caller gets there.
+bool hpa_find_waypoints(MazeHpa* hpa, int start_x, int start_y, int goal_x, int goal_y,
+                        int** waypoints, int* waypoint_count) {
+    *waypoints = NULL;
+    *waypoint_count = 0;
+    
+    Maze* maze = hpa->maze;
+    if (maze_is_wall(maze, start_x, start_y) || maze_is_wall(maze, goal_x, goal_y)) return false;
+    
+    // New search generation; on wrap-around forget every old stamp
+    int portal_nodes = hpa->sectors_x * hpa->sectors_y * hpa->max_portals;
+    int start_node = portal_nodes;
+    int goal_node = portal_nodes + 1;
+    if (++hpa->stamp == 0) {
+        memset(hpa->visit_stamp, 0, (portal_nodes + 2) * sizeof(unsigned int));
+        hpa->stamp = 1;
+    }
+    hpa->heap_size = 0;
+    
+    int start_sector = hpa_sector_of(hpa, start_x, start_y);
+    int goal_sector = hpa_sector_of(hpa, goal_x, goal_y);
+    HpaSector* start_cache = hpa_get_sector(hpa, start_sector);
+    HpaSector* goal_cache = hpa_get_sector(hpa, goal_sector);
+    
+    // Connect the goal to the portals of its sector
+    hpa_local_search(hpa, goal_sector, goal_x, goal_y);
+    for (int i = 0; i < goal_cache->portal_count; i++) {
+        hpa->goal_cost[i] = hpa_local_distance(hpa, goal_sector, goal_cache->portals[i].x, goal_cache->portals[i].y);
+    }
+    int direct = start_sector == goal_sector ? hpa_local_distance(hpa, goal_sector, start_x, start_y) : MAZE_UNREACHABLE;
+    
+    // Connect the start to the portals of its sector (and to the goal when they share one)
+    hpa->visit_stamp[start_node] = hpa->stamp;
+    hpa->cost[start_node] = 0;
+    hpa->parent[start_node] = -1;
+    
+    hpa_local_search(hpa, start_sector, start_x, start_y);
+    for (int i = 0; i < start_cache->portal_count; i++) {
+        const HpaPortal* portal = &start_cache->portals[i];
+        int distance = hpa_local_distance(hpa, start_sector, portal->x, portal->y);
+        if (distance != MAZE_UNREACHABLE) {
+            hpa_relax(hpa, start_sector * hpa->max_portals + i, distance, start_node,
+                portal->x, portal->y, goal_x, goal_y);
+        }
+    }
+    if (direct != MAZE_UNREACHABLE) {
+        hpa_relax(hpa, goal_node, direct, start_node, goal_x, goal_y, goal_x, goal_y);
+    }
+    
+    // A* over the portal graph (Manhattan distance is a consistent estimate)
+    bool found = false;
+    while (hpa->heap_size > 0) {
+        HpaHeapEntry entry = hpa_heap_pop(hpa);
+        int node = entry.node;
+        if (node == goal_node) {
+            found = true;
+            break;
+        }
+    
+        int sector = node / hpa->max_portals;
+        int local = node % hpa->max_portals;
+        HpaSector* cache = hpa_get_sector(hpa, sector);
+        const HpaPortal* portal = &cache->portals[local];
+    
+        // Skip entries superseded by a cheaper route
+        int estimate = hpa->cost[node] + abs(portal->x - goal_x) + abs(portal->y - goal_y);
+        if (entry.estimate > estimate) continue;
+        int cost = hpa->cost[node];
+    
+        // Other portals of the same sector
+        for (int i = 0; i < cache->portal_count; i++) {
+            int distance = cache->distances[local * cache->portal_count + i];
+            if (i == local || distance == MAZE_UNREACHABLE) continue;
+            hpa_relax(hpa, sector * hpa->max_portals + i, cost + distance, node,
+                cache->portals[i].x, cache->portals[i].y, goal_x, goal_y);
+        }
+    
+        // The portal across the border
+        int partner_sector;
+        int partner = hpa_find_partner(hpa, portal, &partner_sector);
+        if (partner >= 0) {
+            HpaSector* partner_cache = &hpa->sectors[partner_sector];
+            hpa_relax(hpa, partner_sector * hpa->max_portals + partner, cost + 1, node,
+                partner_cache->portals[partner].x, partner_cache->portals[partner].y, goal_x, goal_y);
+        }
+    
+        // The goal itself
+        if (sector == goal_sector && hpa->goal_cost[local] != MAZE_UNREACHABLE) {
+            hpa_relax(hpa, goal_node, cost + hpa->goal_cost[local], node, goal_x, goal_y, goal_x, goal_y);
+        }
+    }
+    
+    if (!found) return false;
+    
+    // Walk the parents back from the goal, then reverse
+    int count = 0;
+    for (int node = goal_node; node != -1; node = hpa->parent[node]) {
+        count++;
+    }
+    
+    int* points = (int*)malloc(count * 2 * sizeof(int));
+    if (!points) return false;
+    
+    int index = count;
+    for (int node = goal_node; node != -1; node = hpa->parent[node]) {
+        int x, y;
+        if (node == goal_node) {
+            x = goal_x;
+            y = goal_y;
+        } else if (node == start_node) {
+            x = start_x;
+            y = start_y;
+        } else {
+            const HpaPortal* portal = &hpa->sectors[node / hpa->max_portals].portals[node % hpa->max_portals];
+            x = portal->x;
+            y = portal->y;
+        }
+    
+        // A start on a portal or a corner portal listed twice repeats a cell
+        if (index < count && points[index * 2] == x && points[index * 2 + 1] == y) continue;
+    
+        index--;
+        points[index * 2] = x;
+        points[index * 2 + 1] = y;
+    }
+    
+    *waypoint_count = count - index;
+    memmove(points, points + index * 2, *waypoint_count * 2 * sizeof(int));
+    *waypoints = points;
+    return true;
+}
+
+// Expand one waypoint pair into cells: [x, y, ...] after `from` up to and
+// including `to` (caller frees). Both cells must be neighbours or share a sector.
+bool hpa_refine_segment(MazeHpa* hpa, int from_x, int from_y, int to_x, int to_y,
+                        int** cells, int* cell_count) {
+    *cells = NULL;
+    *cell_count = 0;
+    
+    int steps = abs(to_x - from_x) + abs(to_y - from_y);
+    if (steps == 0) return true;
+    
+    int sector = hpa_sector_of(hpa, from_x, from_y);
+    if (steps > 1 && sector != hpa_sector_of(hpa, to_x, to_y)) return false;
+    
+    // Distances to the target inside the sector; neighbours are one step apart anyway
+    int distance = 1;
+    if (steps > 1) {
+        hpa_local_search(hpa, sector, to_x, to_y);
+        distance = hpa_local_distance(hpa, sector, from_x, from_y);
+        if (distance == MAZE_UNREACHABLE) return false;
+    }
+    
+    int* path = (int*)malloc(distance * 2 * sizeof(int));
+    if (!path) return false;
+    
+    if (steps == 1) {
+        path[0] = to_x;
+        path[1] = to_y;
+    } else {
+        // Walk down the local distances
+        int x = from_x;
+        int y = from_y;
+        for (int step = 0; step < distance; step++) {
+            for (int dir = 0; dir < 4; dir++) {
+                int nx = x + HPA_DX[dir];
+                int ny = y + HPA_DY[dir];
+                if (hpa_sector_of(hpa, nx, ny) != sector) continue;
+                if (hpa_local_distance(hpa, sector, nx, ny) == distance - step - 1) {
+                    x = nx;
+                    y = ny;
+                    break;
+                }
+            }
+            path[step * 2] = x;
+            path[step * 2 + 1] = y;
+        }
+    }
+    
+    *cells = path;
+    *cell_count = distance;
+    return true;
+}
+
+// Find a full cell path [x0, y0, ...] from start to goal (caller frees)
+bool hpa_find_path(MazeHpa* hpa, int start_x, int start_y, int goal_x, int goal_y,
+                   int** path, int* path_length) {
+    *path = NULL;
+    *path_length = 0;
+    
+    int* waypoints;
+    int waypoint_count;
+    if (!hpa_find_waypoints(hpa, start_x, start_y, goal_x, goal_y, &waypoints, &waypoint_count)) {
+        return false;
+    }
+    
+    int* cells = NULL;
+    int count = 0;
+    int capacity = 0;
+    bool ok = hpa_append_cells(&cells, &count, &capacity, waypoints, 1);
+    
+    for (int i = 0; ok && i + 1 < waypoint_count; i++) {
+        int* segment;
+        int segment_length;
+        ok = hpa_refine_segment(hpa, waypoints[i * 2], waypoints[i * 2 + 1],
+                                waypoints[i * 2 + 2], waypoints[i * 2 + 3], &segment, &segment_length);
+        if (ok) {
+            ok = hpa_append_cells(&cells, &count, &capacity, segment, segment_length);
+            free(segment);
+        }
+    }
+    
+    free(waypoints);
+    if (!ok) {
+        free(cells);
+        return false;
+    }
+    
+    *path = cells;
+    *path_length = count;
+    return true;
+}
+
+// maze_get_path_to_exit equivalent (path is NULL with length 0 when unreachable)
+void hpa_get_path_to_exit(MazeHpa* hpa, int start_x, int start_y, int** path, int* path_length) {
+    hpa_find_path(hpa, start_x, start_y, hpa->maze->exit_x, hpa->maze->exit_y, path, path_length);
+}
+
+// Helper: Maze listener - drop the caches an edit touches
+static void hpa_on_maze_change(Maze* maze, const MazeCellChange* changes, int change_count, void* user_data) {
+    (void)maze;
+    MazeHpa* hpa = (MazeHpa*)user_data;
+    for (int i = 0; i < change_count; i++) {
+        hpa_invalidate_cell(hpa, changes[i].x, changes[i].y);
+    }
+}
+
+// Helper: Get a sector cache, rebuilding it if it is stale
+static HpaSector* hpa_get_sector(MazeHpa* hpa, int sector) {
+    if (hpa->sectors[sector].dirty) {
+        hpa_build_sector(hpa, sector);
+    }
+    return &hpa->sectors[sector];
+}
+
+// Helper: Find the sector's portals and the distances between them
+static void hpa_build_sector(MazeHpa* hpa, int sector) {
+    Maze* maze = hpa->maze;
+    HpaSector* cache = &hpa->sectors[sector];
+    int size = hpa->sector_size;
+    int x0 = (sector / hpa->sectors_y) * size;
+    int y0 = (sector % hpa->sectors_y) * size;
+    int x1 = x0 + size < maze->width ? x0 + size : maze->width;
+    int y1 = y0 + size < maze->height ? y0 + size : maze->height;
+    
+    if (!cache->portals) {
+        cache->portals = (HpaPortal*)malloc(hpa->max_portals * sizeof(HpaPortal));
+        if (!cache->portals) return;
+    }
+    
+    // Portals on each border that has a sector behind it
+    cache->portal_count = 0;
+    if (y0 > 0) hpa_add_border_portals(hpa, cache, x0, y0, 1, 0, x1 - x0, 0);
+    if (x1 < maze->width) hpa_add_border_portals(hpa, cache, x1 - 1, y0, 0, 1, y1 - y0, 1);
+    if (y1 < maze->height) hpa_add_border_portals(hpa, cache, x0, y1 - 1, 1, 0, x1 - x0, 2);
+    if (x0 > 0) hpa_add_border_portals(hpa, cache, x0, y0, 0, 1, y1 - y0, 3);
+    
+    // Steps between every pair of portals without leaving the sector
+    int count = cache->portal_count;
+    int* distances = (int*)realloc(cache->distances, (count * count + 1) * sizeof(int));
+    if (!distances) {
+        cache->portal_count = 0;
+        return;
+    }
+    cache->distances = distances;
+    
+    for (int i = 0; i < count; i++) {
+        hpa_local_search(hpa, sector, cache->portals[i].x, cache->portals[i].y);
+        for (int j = 0; j < count; j++) {
+            distances[i * count + j] = hpa_local_distance(hpa, sector, cache->portals[j].x, cache->portals[j].y);
+        }
+    }
+    
+    cache->dirty = false;
+    hpa->sector_rebuilds++;
+}
+
+// Helper: Add one portal per run of open cell pairs across a border. Both
+// sectors scan the same pairs, so they agree on where the portals are.
+static void hpa_add_border_portals(MazeHpa* hpa, HpaSector* cache, int x, int y, int step_x, int step_y,
+                                   int length, int dir) {
+    Maze* maze = hpa->maze;
+    int run_start = -1;
+    
+    for (int i = 0; i <= length; i++) {
+        int cx = x + step_x * i;
+        int cy = y + step_y * i;
+        bool open = i < length &&
+                    !maze_is_wall(maze, cx, cy) &&
+                    !maze_is_wall(maze, cx + HPA_DX[dir], cy + HPA_DY[dir]);
+    
+        if (open && run_start < 0) {
+            run_start = i;
+        } else if (!open && run_start >= 0) {
+            // The middle of the run
+            int middle = (run_start + i - 1) / 2;
+            HpaPortal* portal = &cache->portals[cache->portal_count++];
+            portal->x = x + step_x * middle;
+            portal->y = y + step_y * middle;
+            portal->dir = dir;
+            run_start = -1;
+        }
+    }
+}
+
+// Helper: Breadth-first search from a cell, confined to one sector
+static void hpa_local_search(MazeHpa* hpa, int sector, int from_x, int from_y) {
+    Maze* maze = hpa->maze;
+    int size = hpa->sector_size;
+    int x0 = (sector / hpa->sectors_y) * size;
+    int y0 = (sector % hpa->sectors_y) * size;
+    
+    for (int i = 0; i < size * size; i++) {
+        hpa->local_distance[i] = MAZE_UNREACHABLE;
+    }
+    if (maze_is_wall(maze, from_x, from_y)) return;
+    
+    int* queue = hpa->local_queue;
+    int head = 0;
+    int tail = 0;
+    int first = (from_x - x0) * size + (from_y - y0);
+    hpa->local_distance[first] = 0;
+    queue[tail++] = first;
+    
+    while (head < tail) {
+        int index = queue[head++];
+        int lx = index / size;
+        int ly = index % size;
+    
+        for (int dir = 0; dir < 4; dir++) {
+            int nx = lx + HPA_DX[dir];
+            int ny = ly + HPA_DY[dir];
+            if (nx < 0 || nx >= size || ny < 0 || ny >= size) continue;
+            if (maze_is_wall(maze, x0 + nx, y0 + ny)) continue;
+    
+            int next = nx * size + ny;
+            if (hpa->local_distance[next] != MAZE_UNREACHABLE) continue;
+    
+            hpa->local_distance[next] = hpa->local_distance[index] + 1;
+            queue[tail++] = next;
+        }
+    }
+}
+
+// Helper: Read the last local search result for a cell of that sector
+static int hpa_local_distance(MazeHpa* hpa, int sector, int x, int y) {
+    int size = hpa->sector_size;
+    int x0 = (sector / hpa->sectors_y) * size;
+    int y0 = (sector % hpa->sectors_y) * size;
+    return hpa->local_distance[(x - x0) * size + (y - y0)];
+}
+
+// Helper: Sector index of a cell (-1 outside the maze)
+static int hpa_sector_of(MazeHpa* hpa, int x, int y) {
+    if (x < 0 || x >= hpa->maze->width || y < 0 || y >= hpa->maze->height) return -1;
+    return (x / hpa->sector_size) * hpa->sectors_y + y / hpa->sector_size;
+}
+
+// Helper: Find the portal facing this one in the neighbouring sector
+static int hpa_find_partner(MazeHpa* hpa, const HpaPortal* portal, int* partner_sector) {
+    int x = portal->x + HPA_DX[portal->dir];
+    int y = portal->y + HPA_DY[portal->dir];
+    int opposite = (portal->dir + 2) % 4;
+    
+    *partner_sector = hpa_sector_of(hpa, x, y);
+    if (*partner_sector < 0) return -1;
+    
+    HpaSector* cache = hpa_get_sector(hpa, *partner_sector);
+    for (int i = 0; i < cache->portal_count; i++) {
+        if (cache->portals[i].x == x && cache->portals[i].y == y && cache->portals[i].dir == opposite) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Helper: Record a cheaper route to a node and queue it
+static void hpa_relax(MazeHpa* hpa, int node, int cost, int parent, int x, int y, int goal_x, int goal_y) {
+    if (hpa->visit_stamp[node] == hpa->stamp && hpa->cost[node] <= cost) return;
+    
+    hpa->visit_stamp[node] = hpa->stamp;
+    hpa->cost[node] = cost;
+    hpa->parent[node] = parent;
+    hpa_heap_push(hpa, cost + abs(x - goal_x) + abs(y - goal_y), node);
+}
+
+// Helper: Push onto the binary min-heap of the open list
+static bool hpa_heap_push(MazeHpa* hpa, int estimate, int node) {
+    if (hpa->heap_size == hpa->heap_capacity) {
+        int capacity = hpa->heap_capacity * 2;
+        HpaHeapEntry* grown = (HpaHeapEntry*)realloc(hpa->heap, capacity * sizeof(HpaHeapEntry));
+        if (!grown) return false;
+        hpa->heap = grown;
+        hpa->heap_capacity = capacity;
+    }
+    
+    int index = hpa->heap_size++;
+    while (index > 0) {
+        int parent = (index - 1) / 2;
+        if (hpa->heap[parent].estimate <= estimate) break;
+        hpa->heap[index] = hpa->heap[parent];
+        index = parent;
+    }
+    hpa->heap[index].estimate = estimate;
+    hpa->heap[index].node = node;
+    return true;
+}
+
+// Helper: Pop the entry with the lowest estimate
+static HpaHeapEntry hpa_heap_pop(MazeHpa* hpa) {
+    HpaHeapEntry top = hpa->heap[0];
+    HpaHeapEntry last = hpa->heap[--hpa->heap_size];
+    
+    int index = 0;
+    for (;;) {
+        int child = index * 2 + 1;
+        if (child >= hpa->heap_size) break;
+        if (child + 1 < hpa->heap_size && hpa->heap[child + 1].estimate < hpa->heap[child].estimate) child++;
+        if (last.estimate <= hpa->heap[child].estimate) break;
+        hpa->heap[index] = hpa->heap[child];
+        index = child;
+    }
+    if (hpa->heap_size > 0) {
+        hpa->heap[index] = last;
+    }
+    return top;
+}
+
+// Helper: Append cell coordinates to a growing path
+static bool hpa_append_cells(int** cells, int* count, int* capacity, const int* more, int more_count) {
+    if (*count + more_count > *capacity) {
+        int grown_capacity = *capacity ? *capacity : 64;
+        while (grown_capacity < *count + more_count) grown_capacity *= 2;
+        int* grown = (int*)realloc(*cells, grown_capacity * 2 * sizeof(int));
+        if (!grown) return false;
+        *cells = grown;
+        *capacity = grown_capacity;
+    }
+    
+    memcpy(*cells + *count * 2, more, more_count * 2 * sizeof(int));
+    *count += more_count;
+    return true;
+}
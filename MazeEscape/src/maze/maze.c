@@ -1,4 +1,8 @@
 #include "maze/maze.h"
+#include "maze/generators.h"
+#include "maze/dynamic.h"
+#include "maze/terrain.h"
+#include "physics/physics.h"
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
@@ -17,38 +21,88 @@ const int DIR_Y[4] = {-1, 0, 1, 0};
 
 // Local function prototypes
 static void carve_passages_from(Maze* maze, int cx, int cy, unsigned int* seed);
-static unsigned int random_next(unsigned int* seed);
+static void maze_notify(Maze* maze, const MazeCellChange* changes, int change_count);
 static void shuffle_directions(int directions[4], unsigned int* seed);
+static int carve_frame_create(unsigned int* seed);
+static void maze_record_change(Maze* maze, int x, int y, CellType new_type);
+static void* maze_alloc(Arena* arena, size_t size);
+static cpShape* maze_add_cell_shape(Maze* maze, cpSpace* space, cpBody* body, int x, int y);
+static int maze_odd_column(Maze* maze, int x);
 
 // Create a new maze
 Maze* maze_create(int width, int height, int cell_size) {
-    Maze* maze = (Maze*)malloc(sizeof(Maze));
+    return maze_create_in_arena(NULL, width, height, cell_size);
+}
+
+// Create a new maze whose memory comes from an arena (NULL for the heap).
+// Arena mazes are released with the arena; maze_destroy leaves them alone.
+Maze* maze_create_in_arena(Arena* arena, int width, int height, int cell_size) {
+    Maze* maze = (Maze*)maze_alloc(arena, sizeof(Maze));
     if (!maze) return NULL;
     
     // Initialize maze properties
     maze->width = width;
     maze->height = height;
     maze->cell_size = cell_size;
+    maze->repaired_cells = 0;
     maze->physics_space = NULL;
+    maze->cell_shapes = NULL;
+    maze->dynamic = NULL;
+    maze->terrain = NULL;
+    maze->arena = arena;
+    
+    // Allocate cell grid: one block, with column pointers into it
+    maze->cells = (CellType**)maze_alloc(arena, width * sizeof(CellType*));
+    CellType* cell_block = (CellType*)maze_alloc(arena, width * height * sizeof(CellType));
+    
+    // Allocate start positions for characters (maximum 4 characters)
+    maze->start_positions = (int*)maze_alloc(arena, 8 * sizeof(int)); // x,y for 4 characters
+    
+    // Allocate exit distance field (filled by maze_generate) and search scratch
+    maze->exit_distance = (int*)maze_alloc(arena, width * height * sizeof(int));
+    maze->scratch = (int*)maze_alloc(arena, width * height * sizeof(int));
+    
+    if (!maze->cells || !cell_block || !maze->start_positions || !maze->exit_distance || !maze->scratch) {
+        if (!arena) {
+            free(maze->cells);
+            free(cell_block);
+            free(maze->start_positions);
+            free(maze->exit_distance);
+            free(maze->scratch);
+            free(maze);
+        }
+        return NULL;
+    }
     
-    // Allocate cell grid
-    maze->cells = (CellType**)malloc(width * sizeof(CellType*));
     for (int x = 0; x < width; x++) {
-        maze->cells[x] = (CellType*)malloc(height * sizeof(CellType));
+        maze->cells[x] = cell_block + x * height;
         // Initialize all cells as walls
         for (int y = 0; y < height; y++) {
             maze->cells[x][y] = CELL_WALL;
         }
     }
     
-    // Allocate start positions for characters (maximum 4 characters)
-    maze->start_positions = (int*)malloc(8 * sizeof(int)); // x,y for 4 characters
+    for (int i = 0; i < width * height; i++) {
+        maze->exit_distance[i] = MAZE_UNREACHABLE;
+    }
+    
+    // Change journal grows on demand
+    maze->changes = NULL;
+    maze->change_count = 0;
+    maze->change_capacity = 0;
+    maze->listener_count = 0;
     
     return maze;
 }
 
 // Generate a maze using recursive backtracking algorithm
 void maze_generate(Maze* maze, unsigned int seed) {
+    maze_generate_with(maze, seed, MAZE_ALGORITHM_BACKTRACKER);
+}
+
+// Generate a maze with the given carving algorithm, then add the entrance,
+// exit, start positions, breakable walls and special cells
+void maze_generate_with(Maze* maze, unsigned int seed, MazeAlgorithm algorithm) {
     // If seed is 0, use current time
     if (seed == 0) {
         seed = (unsigned int)time(NULL);
@@ -61,20 +115,47 @@ void maze_generate(Maze* maze, unsigned int seed) {
         }
     }
     
-    // Carve passages starting from a random point
-    int start_x = random_next(&seed) % (maze->width / 2) + maze->width / 4;
-    int start_y = random_next(&seed) % (maze->height / 2) + maze->height / 4;
-    carve_passages_from(maze, start_x, start_y, &seed);
+    switch (algorithm) {
+        case MAZE_ALGORITHM_WILSON:
+            maze_carve_wilson(maze, &seed);
+            break;
+        case MAZE_ALGORITHM_KRUSKAL:
+            maze_carve_kruskal(maze, &seed);
+            break;
+        case MAZE_ALGORITHM_PRIM:
+            maze_carve_prim(maze, &seed);
+            break;
+        case MAZE_ALGORITHM_SIDEWINDER:
+            maze_carve_sidewinder(maze, &seed);
+            break;
+        case MAZE_ALGORITHM_BINARY_TREE:
+            maze_carve_binary_tree(maze, &seed);
+            break;
+        default: {
+            // Carve passages starting from a random point
+            int start_x = maze_random_next(&seed) % (maze->width / 2) + maze->width / 4;
+            int start_y = maze_random_next(&seed) % (maze->height / 2) + maze->height / 4;
+            carve_passages_from(maze, start_x, start_y, &seed);
+            break;
+        }
+    }
     
     // Place entrance at the top of the maze
-    int entrance_x = random_next(&seed) % (maze->width - 4) + 2;
+    int entrance_x = maze_random_next(&seed) % (maze->width - 4) + 2;
     int entrance_y = 0;
-    maze->cells[entrance_x][entrance_y] = CELL_START;
-    maze->cells[entrance_x][entrance_y + 1] = CELL_EMPTY;
     
     // Place exit at the bottom of the maze
-    int exit_x = random_next(&seed) % (maze->width - 4) + 2;
+    int exit_x = maze_random_next(&seed) % (maze->width - 4) + 2;
     int exit_y = maze->height - 1;
+    
+    // Node-grid carvers only open odd columns: keep both stubs on one
+    if (algorithm != MAZE_ALGORITHM_BACKTRACKER) {
+        entrance_x = maze_odd_column(maze, entrance_x);
+        exit_x = maze_odd_column(maze, exit_x);
+    }
+    
+    maze->cells[entrance_x][entrance_y] = CELL_START;
+    maze->cells[entrance_x][entrance_y + 1] = CELL_EMPTY;
     maze->cells[exit_x][exit_y] = CELL_EXIT;
     maze->cells[exit_x][exit_y - 1] = CELL_EMPTY;
     
@@ -96,11 +177,15 @@ void maze_generate(Maze* maze, unsigned int seed) {
         maze->cells[entrance_x + offset_x][entrance_y + 1 + offset_y] = CELL_EMPTY;
     }
     
+    // Depending on parity the entrance or exit corridor can miss the carved
+    // region; join them here instead of rejecting the seed
+    maze->repaired_cells = maze_connect_to_exit(maze, entrance_x, entrance_y);
+    
     // Add some breakable walls
     int breakable_count = (maze->width * maze->height) / 20; // 5% of cells are breakable
     for (int i = 0; i < breakable_count; i++) {
-        int x = random_next(&seed) % (maze->width - 2) + 1;
-        int y = random_next(&seed) % (maze->height - 2) + 1;
+        int x = maze_random_next(&seed) % (maze->width - 2) + 1;
+        int y = maze_random_next(&seed) % (maze->height - 2) + 1;
         
         // Only replace walls with breakable walls
         if (maze->cells[x][y] == CELL_WALL) {
@@ -111,28 +196,130 @@ void maze_generate(Maze* maze, unsigned int seed) {
     // Add some special cells
     int special_count = (maze->width * maze->height) / 40; // 2.5% of cells are special
     for (int i = 0; i < special_count; i++) {
-        int x = random_next(&seed) % (maze->width - 2) + 1;
-        int y = random_next(&seed) % (maze->height - 2) + 1;
+        int x = maze_random_next(&seed) % (maze->width - 2) + 1;
+        int y = maze_random_next(&seed) % (maze->height - 2) + 1;
         
         // Only place special cells in empty spaces
         if (maze->cells[x][y] == CELL_EMPTY) {
             maze->cells[x][y] = CELL_SPECIAL;
         }
     }
+    
+    // Distances to the exit drive the AI and race scoring
+    maze_compute_distance_field(maze);
+}
+
+// Make sure the cell (x, y) can reach the exit. One union-find pass over the
+// cells labels the open regions; if (x, y) and the exit differ, a breadth-first
+// search through walls from every cell of the smaller of the two regions
+// (usually a short entrance or exit stub) opens the fewest walls that join it
+// to the other. Returns the number of cells opened (0 if already connected).
+// Cells are written directly, like generation does, and the exit distance
+// field is used as the search queue: callers recompute it afterwards.
+int maze_connect_to_exit(Maze* maze, int x, int y) {
+    int width = maze->width;
+    int height = maze->height;
+    if (x < 0 || x >= width || y < 0 || y >= height) return 0;
+    if (maze_is_wall(maze, x, y)) return 0;
+    
+    // Label open regions (walls get -1), joining each cell to its west and north neighbours
+    int* parent = maze->scratch;
+    for (int cx = 0; cx < width; cx++) {
+        for (int cy = 0; cy < height; cy++) {
+            int index = cx * height + cy;
+            if (maze_is_wall(maze, cx, cy)) {
+                parent[index] = -1;
+                continue;
+            }
+            
+            parent[index] = index;
+            if (cx > 0 && parent[index - height] >= 0) maze_union_find_join(parent, index, index - height);
+            if (cy > 0 && parent[index - 1] >= 0) maze_union_find_join(parent, index, index - 1);
+        }
+    }
+    
+    int cell_count = width * height;
+    int exit_index = maze->exit_x * height + maze->exit_y;
+    if (parent[exit_index] < 0) return 0;
+    int exit_root = maze_union_find_root(parent, exit_index);
+    int start_root = maze_union_find_root(parent, x * height + y);
+    if (start_root == exit_root) return 0;
+    
+    // Relabel: which region each cell is in, then size the two that matter
+    int exit_size = 0;
+    int start_size = 0;
+    for (int i = 0; i < cell_count; i++) {
+        int root = parent[i] >= 0 ? maze_union_find_root(parent, i) : -1;
+        if (root == exit_root) exit_size++;
+        if (root == start_root) start_size++;
+        parent[i] = root;
+    }
+    int source_root = start_size <= exit_size ? start_root : exit_root;
+    int target_root = source_root == start_root ? exit_root : start_root;
+    
+    // Codes from here on: walls and other regions, both ends, then visited
+    // walls as CONNECT_VISITED + the cell they were reached from
+    enum { CONNECT_WALL, CONNECT_OTHER, CONNECT_SOURCE, CONNECT_TARGET, CONNECT_VISITED };
+    int* queue = maze->exit_distance;
+    int head = 0;
+    int tail = 0;
+    for (int i = 0; i < cell_count; i++) {
+        int root = parent[i];
+        if (root < 0) {
+            parent[i] = CONNECT_WALL;
+        } else if (root == source_root) {
+            parent[i] = CONNECT_SOURCE;
+            queue[tail++] = i;
+        } else {
+            parent[i] = root == target_root ? CONNECT_TARGET : CONNECT_OTHER;
+        }
+    }
+    
+    // Dig through interior walls only, so the border stays closed
+    while (head < tail) {
+        int current = queue[head++];
+        int cx = current / height;
+        int cy = current % height;
+        for (int dir = 0; dir < 4; dir++) {
+            int nx = cx + DIR_X[dir];
+            int ny = cy + DIR_Y[dir];
+            if (nx < 1 || nx >= width - 1 || ny < 1 || ny >= height - 1) continue;
+            
+            int next = nx * height + ny;
+            if (parent[next] == CONNECT_TARGET) {
+                // Open the walls on the way back to the source region
+                int opened = 0;
+                for (int cell = current; parent[cell] >= CONNECT_VISITED; cell = parent[cell] - CONNECT_VISITED) {
+                    maze->cells[cell / height][cell % height] = CELL_EMPTY;
+                    opened++;
+                }
+                return opened;
+            }
+            if (parent[next] != CONNECT_WALL) continue;
+            
+            parent[next] = CONNECT_VISITED + current;
+            queue[tail++] = next;
+        }
+    }
+    
+    return 0;
 }
 
 // Free maze resources
 void maze_destroy(Maze* maze) {
-    if (!maze) return;
+    // Arena mazes are freed with their arena
+    if (!maze || maze->arena) return;
     
-    // Free the cell grid
-    for (int x = 0; x < maze->width; x++) {
-        free(maze->cells[x]);
-    }
+    // Free the cell grid (a single block behind the column pointers)
+    free(maze->cells[0]);
     free(maze->cells);
     
-    // Free start positions
+    // Free start positions, distance field and scratch
     free(maze->start_positions);
+    free(maze->exit_distance);
+    free(maze->scratch);
+    free(maze->changes);
+    free(maze->cell_shapes);
     
     // Free maze structure
     free(maze);
@@ -150,12 +337,52 @@ bool maze_is_wall(Maze* maze, int x, int y) {
 
 // Set the type of a cell
 void maze_set_cell(Maze* maze, int x, int y, CellType type) {
-    // Check bounds
-    if (x < 0 || x >= maze->width || y < 0 || y >= maze->height) {
-        return;
+    MazeCellChange edit = {x, y, CELL_EMPTY, type};
+    maze_set_cells(maze, &edit, 1);
+}
+
+// Apply several cell edits as one batch (old_type of the edits is ignored).
+// Every real change is journaled, the exit distance field is updated
+// incrementally (closings first, then openings, so it stays exact after
+// each edit), the terrain cost field is refreshed and listeners are
+// notified once with the whole batch.
+// Returns the number of cells that changed.
+int maze_set_cells(Maze* maze, const MazeCellChange* edits, int edit_count) {
+    int first = maze->change_count;
+    
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < edit_count; i++) {
+            int x = edits[i].x;
+            int y = edits[i].y;
+            if (x < 0 || x >= maze->width || y < 0 || y >= maze->height) continue;
+            
+            CellType type = edits[i].new_type;
+            if (maze->cells[x][y] == type) continue;
+            
+            bool closes = !maze_is_wall(maze, x, y) && (type == CELL_WALL || type == CELL_BREAKABLE);
+            if (closes != (pass == 0)) continue;
+            
+            bool was_wall = maze_is_wall(maze, x, y);
+            maze_record_change(maze, x, y, type);
+            maze->cells[x][y] = type;
+            
+            if (closes) {
+                maze_raise_distance_field(maze, x, y);
+            } else if (was_wall && !maze_is_wall(maze, x, y)) {
+                maze_relax_distance_field(maze, x, y);
+            }
+        }
     }
     
-    maze->cells[x][y] = type;
+    int changed = maze->change_count - first;
+    if (changed > 0) {
+        // Weighted costs are recomputed once per batch
+        if (maze->terrain) {
+            maze_terrain_compute_costs(maze->terrain);
+        }
+        maze_notify(maze, &maze->changes[first], changed);
+    }
+    return changed;
 }
 
 // Get the type of a cell
@@ -173,53 +400,40 @@ void maze_add_physics_bodies(Maze* maze, cpSpace* space) {
     // Create static body for all walls
     cpBody* static_body = physics_create_static_body(space);
     
-    // Add each wall as a box shape
+    // Remember every cell's collider so edits can replace just that one
+    if (!maze->cell_shapes) {
+        maze->cell_shapes = (cpShape**)maze_alloc(maze->arena, maze->width * maze->height * sizeof(cpShape*));
+    }
+    
+    // Add each wall as a box shape at its cell position
     for (int x = 0; x < maze->width; x++) {
         for (int y = 0; y < maze->height; y++) {
-            if (maze->cells[x][y] == CELL_WALL || maze->cells[x][y] == CELL_BREAKABLE) {
-                float px = x * maze->cell_size;
-                float py = y * maze->cell_size;
-                
-                // Add collision based on cell type
-                CollisionType type = (maze->cells[x][y] == CELL_WALL) 
-                    ? COLLISION_WALL 
-                    : COLLISION_BREAKABLE_WALL;
-                
-                physics_add_box(
-                    space, static_body, 
-                    maze->cell_size, maze->cell_size,
-                    1.0f, type
-                );
-                
-                // Position the shape
-                cpBodySetPosition(static_body, cpv(
-                    px + maze->cell_size / 2.0f,
-                    py + maze->cell_size / 2.0f
-                ));
-            } else if (maze->cells[x][y] == CELL_EXIT) {
-                float px = x * maze->cell_size;
-                float py = y * maze->cell_size;
-                
-                // Add exit sensor
-                cpShape* sensor = physics_add_box(
-                    space, static_body,
-                    maze->cell_size, maze->cell_size,
-                    0.0f, COLLISION_EXIT
-                );
-                
-                // Mark as sensor (doesn't block movement)
-                cpShapeSetSensor(sensor, true);
-                
-                // Position the shape
-                cpBodySetPosition(static_body, cpv(
-                    px + maze->cell_size / 2.0f,
-                    py + maze->cell_size / 2.0f
-                ));
+            cpShape* shape = maze_add_cell_shape(maze, space, static_body, x, y);
+            if (maze->cell_shapes) {
+                maze->cell_shapes[x * maze->height + y] = shape;
             }
         }
     }
 }
 
+// Bring the colliders of the journaled cells in line with their current
+// types (broken walls, doors, moving walls); untouched cells keep theirs
+void maze_sync_physics(Maze* maze, const MazeCellChange* changes, int change_count) {
+    cpSpace* space = maze->physics_space;
+    if (!space || !maze->cell_shapes) return;
+    
+    cpBody* static_body = physics_create_static_body(space);
+    for (int i = 0; i < change_count; i++) {
+        int index = changes[i].x * maze->height + changes[i].y;
+        cpShape* shape = maze->cell_shapes[index];
+        if (shape) {
+            cpSpaceRemoveShape(space, shape);
+            cpShapeFree(shape);
+        }
+        maze->cell_shapes[index] = maze_add_cell_shape(maze, space, static_body, changes[i].x, changes[i].y);
+    }
+}
+
 // Break a wall in the maze
 void maze_break_wall(Maze* maze, int x, int y) {
     // Check bounds
@@ -229,71 +443,380 @@ void maze_break_wall(Maze* maze, int x, int y) {
     
     // Only breakable walls can be broken
     if (maze->cells[x][y] == CELL_BREAKABLE) {
+        MazeCellChange change = {x, y, CELL_BREAKABLE, CELL_EMPTY};
+        maze_record_change(maze, x, y, CELL_EMPTY);
         maze->cells[x][y] = CELL_EMPTY;
         
-        // TODO: Remove physics body for this wall
+        // The opening may create a shortcut to the exit
+        maze_relax_distance_field(maze, x, y);
+        if (maze->terrain) {
+            maze_terrain_compute_costs(maze->terrain);
+        }
+        maze_notify(maze, &change, 1);
+        
+        // The collider goes when the journal is synced (maze_sync_physics)
     }
 }
 
-// Update maze state
+// Update maze state: apply the scheduled changes that are due (their edits
+// land in the change journal like any other)
 void maze_update(Maze* maze, float dt) {
-    // Currently no dynamic updates needed
-    (void)dt;
-    (void)maze;
+    if (maze->dynamic) {
+        maze_dynamic_update(maze->dynamic, dt);
+    }
 }
 
-// Find path to exit using A* algorithm
+// Find a shortest path to the exit by walking down the distance field.
+// The path is returned as [x0, y0, x1, y1, ...] from the start cell to the exit
+// (caller frees); it is NULL with length 0 when the exit cannot be reached.
 void maze_get_path_to_exit(Maze* maze, int start_x, int start_y, int** path, int* path_length) {
-    // TODO: Implement A* pathfinding algorithm
-    // This is a placeholder that would need to be implemented for AI behavior
-    
-    // Just to avoid compiler warnings
-    (void)maze;
-    (void)start_x;
-    (void)start_y;
     *path = NULL;
     *path_length = 0;
+    
+    int distance = maze_get_exit_distance(maze, start_x, start_y);
+    if (distance == MAZE_UNREACHABLE) return;
+    
+    int* cells = (int*)malloc((distance + 1) * 2 * sizeof(int));
+    if (!cells) return;
+    
+    int x = start_x;
+    int y = start_y;
+    for (int step = 0; step <= distance; step++) {
+        cells[step * 2] = x;
+        cells[step * 2 + 1] = y;
+        
+        // Every cell but the exit has a neighbour one step closer
+        for (int dir = 0; dir < 4; dir++) {
+            int nx = x + DIR_X[dir];
+            int ny = y + DIR_Y[dir];
+            if (maze_get_exit_distance(maze, nx, ny) == distance - step - 1) {
+                x = nx;
+                y = ny;
+                break;
+            }
+        }
+    }
+    
+    *path = cells;
+    *path_length = distance + 1;
+}
+
+// Compute steps to the exit for every open cell (breadth-first from the exit)
+void maze_compute_distance_field(Maze* maze) {
+    int cell_count = maze->width * maze->height;
+    for (int i = 0; i < cell_count; i++) {
+        maze->exit_distance[i] = MAZE_UNREACHABLE;
+    }
+    
+    // Every cell is queued at most once, so the scratch buffer is big enough
+    int* queue = maze->scratch;
+    int head = 0;
+    int tail = 0;
+    maze->exit_distance[maze->exit_x * maze->height + maze->exit_y] = 0;
+    queue[tail++] = maze->exit_x * maze->height + maze->exit_y;
+    
+    while (head < tail) {
+        int index = queue[head++];
+        int cx = index / maze->height;
+        int cy = index % maze->height;
+        
+        for (int dir = 0; dir < 4; dir++) {
+            int nx = cx + DIR_X[dir];
+            int ny = cy + DIR_Y[dir];
+            if (maze_is_wall(maze, nx, ny)) continue;
+            
+            int next = nx * maze->height + ny;
+            if (maze->exit_distance[next] != MAZE_UNREACHABLE) continue;
+            
+            maze->exit_distance[next] = maze->exit_distance[index] + 1;
+            queue[tail++] = next;
+        }
+    }
 }
 
-// Helper: Carve passages using recursive backtracking
+// Lower exit distances after the cell (x, y) was opened. An opening only
+// shortens routes, so a breadth-first wave from it corrects every distance
+// it improves and stops where the old distances are already as short; the
+// rest of the field is never touched.
+void maze_relax_distance_field(Maze* maze, int x, int y) {
+    if (maze_is_wall(maze, x, y)) return;
+    
+    int* distance = maze->exit_distance;
+    int index = x * maze->height + y;
+    
+    // Best route through an open neighbour
+    int best = (x == maze->exit_x && y == maze->exit_y) ? 0 : MAZE_UNREACHABLE;
+    for (int dir = 0; dir < 4; dir++) {
+        int around = maze_get_exit_distance(maze, x + DIR_X[dir], y + DIR_Y[dir]);
+        if (around != MAZE_UNREACHABLE && (best == MAZE_UNREACHABLE || around + 1 < best)) {
+            best = around + 1;
+        }
+    }
+    if (best == MAZE_UNREACHABLE) return;
+    if (distance[index] != MAZE_UNREACHABLE && distance[index] <= best) return;
+    
+    // A single source reaches every cell first along its shortest route, so each is queued at most once
+    int* queue = maze->scratch;
+    int head = 0;
+    int tail = 0;
+    distance[index] = best;
+    queue[tail++] = index;
+    
+    while (head < tail) {
+        int current = queue[head++];
+        int cx = current / maze->height;
+        int cy = current % maze->height;
+        
+        for (int dir = 0; dir < 4; dir++) {
+            int nx = cx + DIR_X[dir];
+            int ny = cy + DIR_Y[dir];
+            if (maze_is_wall(maze, nx, ny)) continue;
+            
+            int next = nx * maze->height + ny;
+            int shorter = distance[current] + 1;
+            if (distance[next] != MAZE_UNREACHABLE && distance[next] <= shorter) continue;
+            
+            distance[next] = shorter;
+            queue[tail++] = next;
+        }
+    }
+}
+
+// Raise exit distances after the cell (x, y) was closed. Only cells whose
+// shortest-path tree parent chain ran through it can get longer, so that
+// subtree is cleared and refilled by relaxing from its surviving border.
+// When the subtree covers most of the maze a full recompute is cheaper.
+void maze_raise_distance_field(Maze* maze, int x, int y) {
+    if (x < 0 || x >= maze->width || y < 0 || y >= maze->height) return;
+    
+    int* distance = maze->exit_distance;
+    int cell_count = maze->width * maze->height;
+    int index = x * maze->height + y;
+    if (distance[index] == MAZE_UNREACHABLE) return;
+    
+    // Collect the subtree: a cell's parent is its first neighbour one step
+    // closer. Collected cells are marked by encoding their old distance d
+    // as -d - 2, which keeps it readable while telling them apart.
+    int* queue = maze->scratch;
+    int head = 0;
+    int tail = 0;
+    distance[index] = -distance[index] - 2;
+    queue[tail++] = index;
+    
+    while (head < tail) {
+        int current = queue[head++];
+        int cx = current / maze->height;
+        int cy = current % maze->height;
+        int child_distance = -distance[current] - 2 + 1;
+        
+        for (int dir = 0; dir < 4; dir++) {
+            int nx = cx + DIR_X[dir];
+            int ny = cy + DIR_Y[dir];
+            if (maze_is_wall(maze, nx, ny)) continue;
+            
+            int next = nx * maze->height + ny;
+            if (distance[next] != child_distance) continue;
+            
+            // Is `current` the first neighbour of `next` at child_distance - 1?
+            int parent = -1;
+            for (int back = 0; back < 4 && parent < 0; back++) {
+                int px = nx + DIR_X[back];
+                int py = ny + DIR_Y[back];
+                if (px < 0 || px >= maze->width || py < 0 || py >= maze->height) continue;
+                
+                int around = distance[px * maze->height + py];
+                if (around <= -2) around = -around - 2;
+                if (around == child_distance - 1) parent = px * maze->height + py;
+            }
+            if (parent != current) continue;
+            
+            distance[next] = -distance[next] - 2;
+            queue[tail++] = next;
+        }
+    }
+    
+    for (int i = 0; i < tail; i++) {
+        distance[queue[i]] = MAZE_UNREACHABLE;
+    }
+    
+    if (tail > cell_count / 2) {
+        maze_compute_distance_field(maze);
+        return;
+    }
+    
+    // Park the subtree at the top of the scratch buffer; relaxing only lowers
+    // subtree cells, so its queue never reaches them
+    int* cleared = maze->scratch + cell_count - tail;
+    memmove(cleared, queue, tail * sizeof(int));
+    for (int i = 0; i < tail; i++) {
+        maze_relax_distance_field(maze, cleared[i] / maze->height, cleared[i] % maze->height);
+    }
+}
+
+// Get steps to the exit from a cell (MAZE_UNREACHABLE for walls and cut-off cells)
+int maze_get_exit_distance(Maze* maze, int x, int y) {
+    // Check bounds
+    if (x < 0 || x >= maze->width || y < 0 || y >= maze->height) {
+        return MAZE_UNREACHABLE;
+    }
+    
+    return maze->exit_distance[x * maze->height + y];
+}
+
+// Forget journaled cell edits once they have been consumed
+void maze_clear_changes(Maze* maze) {
+    maze->change_count = 0;
+}
+
+// Register a callback for cell edits (at most MAZE_MAX_LISTENERS)
+bool maze_add_listener(Maze* maze, MazeChangeFunc func, void* user_data) {
+    if (maze->listener_count == MAZE_MAX_LISTENERS) return false;
+    
+    maze->listeners[maze->listener_count].func = func;
+    maze->listeners[maze->listener_count].user_data = user_data;
+    maze->listener_count++;
+    return true;
+}
+
+// Unregister a callback added with maze_add_listener
+void maze_remove_listener(Maze* maze, MazeChangeFunc func, void* user_data) {
+    for (int i = 0; i < maze->listener_count; i++) {
+        if (maze->listeners[i].func == func && maze->listeners[i].user_data == user_data) {
+            maze->listeners[i] = maze->listeners[--maze->listener_count];
+            return;
+        }
+    }
+}
+
+// Helper: Nearest odd column to x within the entrance / exit range [2, width - 3]
+static int maze_odd_column(Maze* maze, int x) {
+    if (x % 2 != 0) return x;
+    return x + 1 <= maze->width - 3 ? x + 1 : x - 1;
+}
+
+// Helper: Tell every listener about a batch of cell edits
+static void maze_notify(Maze* maze, const MazeCellChange* changes, int change_count) {
+    for (int i = 0; i < maze->listener_count; i++) {
+        maze->listeners[i].func(maze, changes, change_count, maze->listeners[i].user_data);
+    }
+}
+
+// Helper: Append a cell edit to the journal
+static void maze_record_change(Maze* maze, int x, int y, CellType new_type) {
+    if (maze->change_count == maze->change_capacity) {
+        int capacity = maze->change_capacity ? maze->change_capacity * 2 : 16;
+        MazeCellChange* grown = maze->arena
+            ? (MazeCellChange*)arena_grow(maze->arena, maze->changes,
+                  maze->change_capacity * sizeof(MazeCellChange), capacity * sizeof(MazeCellChange))
+            : (MazeCellChange*)realloc(maze->changes, capacity * sizeof(MazeCellChange));
+        if (!grown) return;
+        maze->changes = grown;
+        maze->change_capacity = capacity;
+    }
+    
+    MazeCellChange* change = &maze->changes[maze->change_count++];
+    change->x = x;
+    change->y = y;
+    change->old_type = maze->cells[x][y];
+    change->new_type = new_type;
+}
+
+// Helper: Carve passages using recursive backtracking. The recursion is kept
+// on an explicit stack in the scratch buffer (two ints per carved cell: cell
+// index, and the shuffled directions with the next one to try), since a
+// million-cell maze is far deeper than the call stack. Cells are visited in
+// the same order as the recursive form, so seeds produce the same mazes.
 static void carve_passages_from(Maze* maze, int cx, int cy, unsigned int* seed) {
-    // Mark current cell as empty
-    maze->cells[cx][cy] = CELL_EMPTY;
+    int* stack = maze->scratch;
+    int depth = 0;
     
-    // Shuffle directions
-    int directions[4] = {DIR_NORTH, DIR_EAST, DIR_SOUTH, DIR_WEST};
-    shuffle_directions(directions, seed);
+    maze->cells[cx][cy] = CELL_EMPTY;
+    stack[0] = cx * maze->height + cy;
+    stack[1] = carve_frame_create(seed);
+    depth = 1;
     
-    // Try each direction
-    for (int i = 0; i < 4; i++) {
-        int nx = cx + DIR_X[directions[i]] * 2;
-        int ny = cy + DIR_Y[directions[i]] * 2;
+    while (depth > 0) {
+        int* frame = &stack[(depth - 1) * 2];
+        int next = frame[1] >> 8;
+        if (next == 4) {
+            depth--;
+            continue;
+        }
+        frame[1] += 1 << 8;
+        
+        int dir = (frame[1] >> (next * 2)) & 3;
+        int x = frame[0] / maze->height;
+        int y = frame[0] % maze->height;
+        int nx = x + DIR_X[dir] * 2;
+        int ny = y + DIR_Y[dir] * 2;
         
         // Check if new position is valid
         if (nx >= 0 && nx < maze->width && ny >= 0 && ny < maze->height 
             && maze->cells[nx][ny] == CELL_WALL) {
             
             // Carve passage by making intermediate cell empty
-            maze->cells[cx + DIR_X[directions[i]]][cy + DIR_Y[directions[i]]] = CELL_EMPTY;
+            maze->cells[x + DIR_X[dir]][y + DIR_Y[dir]] = CELL_EMPTY;
             
-            // Recursively carve from new position
-            carve_passages_from(maze, nx, ny, seed);
+            // "Recurse" into the new cell
+            maze->cells[nx][ny] = CELL_EMPTY;
+            stack[depth * 2] = nx * maze->height + ny;
+            stack[depth * 2 + 1] = carve_frame_create(seed);
+            depth++;
         }
     }
 }
 
-// Helper: Generate next random number
-static unsigned int random_next(unsigned int* seed) {
-    *seed = (*seed * 1103515245 + 12345) & 0x7fffffff;
-    return *seed;
+// Helper: Shuffle the directions of a new carve frame and pack them two bits
+// each into the low byte (the next direction index lives above them)
+static int carve_frame_create(unsigned int* seed) {
+    int directions[4] = {DIR_NORTH, DIR_EAST, DIR_SOUTH, DIR_WEST};
+    shuffle_directions(directions, seed);
+    return directions[0] | directions[1] << 2 | directions[2] << 4 | directions[3] << 6;
 }
 
 // Helper: Shuffle array of directions
 static void shuffle_directions(int directions[4], unsigned int* seed) {
     for (int i = 3; i > 0; i--) {
-        int j = random_next(seed) % (i + 1);
+        int j = maze_random_next(seed) % (i + 1);
         int temp = directions[i];
         directions[i] = directions[j];
         directions[j] = temp;
     }
 }
+
+// Helper: Allocate from the arena, or the heap when there is none
+static void* maze_alloc(Arena* arena, size_t size) {
+    return arena ? arena_alloc(arena, size) : malloc(size);
+}
+
+// Helper: Create the collider a cell of the current type needs, if any
+static cpShape* maze_add_cell_shape(Maze* maze, cpSpace* space, cpBody* body, int x, int y) {
+    float px = x * maze->cell_size;
+    float py = y * maze->cell_size;
+    
+    if (maze->cells[x][y] == CELL_WALL || maze->cells[x][y] == CELL_BREAKABLE) {
+        // Add collision based on cell type
+        CollisionType type = (maze->cells[x][y] == CELL_WALL) 
+            ? COLLISION_WALL 
+            : COLLISION_BREAKABLE_WALL;
+        
+        return physics_add_box_at(
+            space, body,
+            px, py, maze->cell_size, maze->cell_size,
+            1.0f, type
+        );
+    } else if (maze->cells[x][y] == CELL_EXIT) {
+        // Add exit sensor
+        cpShape* sensor = physics_add_box_at(
+            space, body,
+            px, py, maze->cell_size, maze->cell_size,
+            0.0f, COLLISION_EXIT
+        );
+        
+        // Mark as sensor (doesn't block movement)
+        cpShapeSetSensor(sensor, true);
+        return sensor;
+    }
+    
+    return NULL;
+}
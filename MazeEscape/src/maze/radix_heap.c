@@ -0,0 +1,111 @@
+#include "maze/radix_heap.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Local function prototypes
+static int radix_bucket(unsigned int key, unsigned int last);
+static bool radix_append(RadixHeap* heap, int bucket, RadixHeapEntry entry);
+
+// Set up an empty heap (buckets are allocated on first use)
+void radix_heap_init(RadixHeap* heap) {
+    for (int i = 0; i < RADIX_HEAP_BUCKETS; i++) {
+        heap->buckets[i] = NULL;
+        heap->sizes[i] = 0;
+        heap->capacities[i] = 0;
+    }
+    heap->last = 0;
+    heap->count = 0;
+}
+
+// Free the heap's buckets
+void radix_heap_free(RadixHeap* heap) {
+    for (int i = 0; i < RADIX_HEAP_BUCKETS; i++) {
+        free(heap->buckets[i]);
+    }
+    radix_heap_init(heap);
+}
+
+// Empty the heap for a new search, keeping its buckets
+void radix_heap_clear(RadixHeap* heap) {
+    for (int i = 0; i < RADIX_HEAP_BUCKETS; i++) {
+        heap->sizes[i] = 0;
+    }
+    heap->last = 0;
+    heap->count = 0;
+}
+
+// Add an entry; its key must not be below the last key popped. Returns false
+// if a bucket could not grow.
+bool radix_heap_push(RadixHeap* heap, unsigned int key, int value) {
+    if (key < heap->last) {
+        fprintf(stderr, "Radix heap key %u below last popped key %u\n", key, heap->last);
+        return false;
+    }
+    
+    RadixHeapEntry entry = {key, value};
+    if (!radix_append(heap, radix_bucket(key, heap->last), entry)) return false;
+    heap->count++;
+    return true;
+}
+
+// Remove an entry with the smallest key. Returns false when the heap is empty.
+bool radix_heap_pop(RadixHeap* heap, RadixHeapEntry* entry) {
+    if (heap->count == 0) return false;
+    
+    // Refill bucket 0 from the first non-empty bucket: its smallest key becomes
+    // the new last key, and every entry there lands in a lower bucket
+    if (heap->sizes[0] == 0) {
+        int bucket = 1;
+        while (heap->sizes[bucket] == 0) bucket++;
+        
+        RadixHeapEntry* entries = heap->buckets[bucket];
+        int size = heap->sizes[bucket];
+        unsigned int smallest = entries[0].key;
+        for (int i = 1; i < size; i++) {
+            if (entries[i].key < smallest) smallest = entries[i].key;
+        }
+        
+        heap->last = smallest;
+        heap->sizes[bucket] = 0;
+        for (int i = 0; i < size; i++) {
+            // An entry that cannot be moved is dropped (already reported)
+            if (!radix_append(heap, radix_bucket(entries[i].key, smallest), entries[i])) {
+                heap->count--;
+            }
+        }
+        if (heap->sizes[0] == 0) return false;
+    }
+    
+    *entry = heap->buckets[0][--heap->sizes[0]];
+    heap->count--;
+    return true;
+}
+
+// Helper: Bucket of a key relative to the last popped key (0 when equal,
+// otherwise the bit length of their difference)
+static int radix_bucket(unsigned int key, unsigned int last) {
+    unsigned int difference = key ^ last;
+    int bucket = 0;
+    while (difference) {
+        bucket++;
+        difference >>= 1;
+    }
+    return bucket;
+}
+
+// Helper: Append an entry to a bucket, doubling it when full
+static bool radix_append(RadixHeap* heap, int bucket, RadixHeapEntry entry) {
+    if (heap->sizes[bucket] == heap->capacities[bucket]) {
+        int capacity = heap->capacities[bucket] ? heap->capacities[bucket] * 2 : 64;
+        RadixHeapEntry* grown = (RadixHeapEntry*)realloc(heap->buckets[bucket], capacity * sizeof(RadixHeapEntry));
+        if (!grown) {
+            fprintf(stderr, "Failed to grow radix heap bucket to %d entries\n", capacity);
+            return false;
+        }
+        heap->buckets[bucket] = grown;
+        heap->capacities[bucket] = capacity;
+    }
+    
+    heap->buckets[bucket][heap->sizes[bucket]++] = entry;
+    return true;
+}
@@ -0,0 +1,129 @@
+#include "maze/raycast.h"
+#include <math.h>
+
+// Local function prototypes
+static bool raycast_walk(Maze* maze, float origin_x, float origin_y, float dir_x, float dir_y,
+                         float max_distance, bool stop_at_wall, int* cells, int max_cells, MazeRayHit* hit);
+
+// Cast a ray through the cell grid and stop at the first wall (breakable
+// walls and the maze edge included). The open cells passed on the way are
+// written to cells as [x0, y0, x1, y1, ...] when given (up to max_cells).
+// Returns whether a wall was hit within max_distance.
+bool maze_raycast(Maze* maze, float origin_x, float origin_y, float dir_x, float dir_y, float max_distance,
+                  MazeRayHit* hit, int* cells, int max_cells) {
+    return raycast_walk(maze, origin_x, origin_y, dir_x, dir_y, max_distance, true, cells, max_cells, hit);
+}
+
+// Cast many rays against the same maze (e.g. a visibility fan for the AI)
+void maze_raycast_batch(Maze* maze, const MazeRay* rays, int ray_count, MazeRayHit* hits) {
+    for (int i = 0; i < ray_count; i++) {
+        const MazeRay* ray = &rays[i];
+        raycast_walk(maze, ray->origin_x, ray->origin_y, ray->dir_x, ray->dir_y, ray->max_distance,
+                     true, NULL, 0, &hits[i]);
+    }
+}
+
+// List every cell a segment crosses, walls included, in order from the
+// origin (for targets that may lie beyond walls). Returns the cell count.
+int maze_trace_cells(Maze* maze, float origin_x, float origin_y, float dir_x, float dir_y, float max_distance,
+                     int* cells, int max_cells) {
+    MazeRayHit hit;
+    raycast_walk(maze, origin_x, origin_y, dir_x, dir_y, max_distance, false, cells, max_cells, &hit);
+    return hit.cell_count;
+}
+
+// Check whether two world points see each other (no wall cell in between)
+bool maze_line_of_sight(Maze* maze, float from_x, float from_y, float to_x, float to_y) {
+    float dx = to_x - from_x;
+    float dy = to_y - from_y;
+    float distance = sqrtf(dx * dx + dy * dy);
+    
+    MazeRayHit hit;
+    return !raycast_walk(maze, from_x, from_y, dx, dy, distance, true, NULL, 0, &hit);
+}
+
+// Helper: Grid DDA (Amanatides-Woo). The ray steps into whichever
+// neighbouring cell's boundary it crosses first, so every cell it touches
+// is visited exactly once with no sampling gaps.
+static bool raycast_walk(Maze* maze, float origin_x, float origin_y, float dir_x, float dir_y,
+                         float max_distance, bool stop_at_wall, int* cells, int max_cells, MazeRayHit* hit) {
+    float cell_size = (float)maze->cell_size;
+    int cx = (int)floorf(origin_x / cell_size);
+    int cy = (int)floorf(origin_y / cell_size);
+    
+    hit->hit = false;
+    hit->cell_x = cx;
+    hit->cell_y = cy;
+    hit->normal_x = 0;
+    hit->normal_y = 0;
+    hit->distance = max_distance;
+    hit->cell_count = 0;
+    
+    float length = sqrtf(dir_x * dir_x + dir_y * dir_y);
+    if (length < 1e-6f) {
+        dir_x = 0.0f;
+        dir_y = 0.0f;
+    } else {
+        dir_x /= length;
+        dir_y /= length;
+    }
+    
+    // Distance along the ray to the next vertical / horizontal cell boundary
+    int step_x = dir_x > 0.0f ? 1 : (dir_x < 0.0f ? -1 : 0);
+    int step_y = dir_y > 0.0f ? 1 : (dir_y < 0.0f ? -1 : 0);
+    float next_x = step_x > 0 ? ((cx + 1) * cell_size - origin_x) / dir_x
+                 : step_x < 0 ? (cx * cell_size - origin_x) / dir_x : INFINITY;
+    float next_y = step_y > 0 ? ((cy + 1) * cell_size - origin_y) / dir_y
+                 : step_y < 0 ? (cy * cell_size - origin_y) / dir_y : INFINITY;
+    float delta_x = step_x != 0 ? cell_size / fabsf(dir_x) : INFINITY;
+    float delta_y = step_y != 0 ? cell_size / fabsf(dir_y) : INFINITY;
+    float travelled = 0.0f;
+    int normal_x = 0;
+    int normal_y = 0;
+    
+    for (;;) {
+        bool inside = cx >= 0 && cx < maze->width && cy >= 0 && cy < maze->height;
+        
+        if (stop_at_wall && maze_is_wall(maze, cx, cy)) {
+            hit->hit = true;
+            hit->cell_x = cx;
+            hit->cell_y = cy;
+            hit->normal_x = normal_x;
+            hit->normal_y = normal_y;
+            hit->distance = travelled;
+            return true;
+        }
+        if (!inside) break;
+        
+        if (cells && hit->cell_count < max_cells) {
+            cells[hit->cell_count * 2] = cx;
+            cells[hit->cell_count * 2 + 1] = cy;
+        }
+        hit->cell_count++;
+        hit->cell_x = cx;
+        hit->cell_y = cy;
+        
+        if (step_x == 0 && step_y == 0) break;
+        
+        if (next_x < next_y) {
+            travelled = next_x;
+            if (travelled > max_distance) break;
+            cx += step_x;
+            next_x += delta_x;
+            normal_x = -step_x;
+            normal_y = 0;
+        } else {
+            travelled = next_y;
+            if (travelled > max_distance) break;
+            cy += step_y;
+            next_y += delta_y;
+            normal_x = 0;
+            normal_y = -step_y;
+        }
+    }
+    
+    if (max_cells > 0 && hit->cell_count > max_cells) {
+        hit->cell_count = max_cells;
+    }
+    return false;
+}
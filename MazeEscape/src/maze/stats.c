@@ -0,0 +1,100 @@
+#include "maze/stats.h"
+#include <stdio.h>
+
+// Compute layout analytics in one pass over the cells. Distances come from
+// the exit distance field (the one BFS, kept current by maze_generate and
+// maze_break_wall); the maze's scratch buffer holds the per-row run lengths,
+// so nothing is allocated.
+void maze_compute_stats(Maze* maze, MazeStats* stats) {
+    int* row_run = maze->scratch;
+    int junction_choices = 0;
+    
+    stats->open_cells = 0;
+    stats->solution_length = MAZE_UNREACHABLE;
+    stats->dead_ends = 0;
+    stats->junctions = 0;
+    stats->longest_corridor = 0;
+    stats->useful_breakables = 0;
+    
+    for (int y = 0; y < maze->height; y++) {
+        row_run[y] = 0;
+    }
+    
+    for (int x = 0; x < maze->width; x++) {
+        int column_run = 0;
+        
+        for (int y = 0; y < maze->height; y++) {
+            CellType cell = maze->cells[x][y];
+            
+            if (cell == CELL_BREAKABLE) {
+                // Useful if it joins cells whose routes to the exit differ by more than the two steps through it
+                int nearest = MAZE_UNREACHABLE;
+                int farthest = MAZE_UNREACHABLE;
+                int around[4] = {
+                    maze_get_exit_distance(maze, x, y - 1),
+                    maze_get_exit_distance(maze, x + 1, y),
+                    maze_get_exit_distance(maze, x, y + 1),
+                    maze_get_exit_distance(maze, x - 1, y)
+                };
+                for (int i = 0; i < 4; i++) {
+                    if (around[i] == MAZE_UNREACHABLE) continue;
+                    if (nearest == MAZE_UNREACHABLE || around[i] < nearest) nearest = around[i];
+                    if (farthest == MAZE_UNREACHABLE || around[i] > farthest) farthest = around[i];
+                }
+                if (nearest != MAZE_UNREACHABLE && farthest - nearest > 2) {
+                    stats->useful_breakables++;
+                }
+            }
+            
+            if (maze_is_wall(maze, x, y)) {
+                column_run = 0;
+                row_run[y] = 0;
+                continue;
+            }
+            
+            stats->open_cells++;
+            
+            // Straight runs down the column and along the row
+            column_run++;
+            row_run[y]++;
+            if (column_run > stats->longest_corridor) stats->longest_corridor = column_run;
+            if (row_run[y] > stats->longest_corridor) stats->longest_corridor = row_run[y];
+            
+            int degree = !maze_is_wall(maze, x, y - 1) + !maze_is_wall(maze, x + 1, y)
+                       + !maze_is_wall(maze, x, y + 1) + !maze_is_wall(maze, x - 1, y);
+            if (degree == 1) {
+                stats->dead_ends++;
+            } else if (degree >= 3) {
+                stats->junctions++;
+                junction_choices += degree - 1;
+            }
+            
+            if (cell == CELL_START) {
+                stats->solution_length = maze_get_exit_distance(maze, x, y);
+            }
+        }
+    }
+    
+    stats->branching_factor = stats->junctions > 0 ? (float)junction_choices / stats->junctions : 0.0f;
+    
+    for (int i = 0; i < MAZE_STATS_SPAWNS; i++) {
+        int spawn_x = maze->start_positions[i * 2];
+        int spawn_y = maze->start_positions[i * 2 + 1];
+        stats->spawn_distance[i] = maze_get_exit_distance(maze, spawn_x, spawn_y);
+    }
+}
+
+// Print the analytics as a short report
+void maze_print_stats(const MazeStats* stats) {
+    printf("Open cells: %d\n", stats->open_cells);
+    printf("Solution length: %d steps\n", stats->solution_length);
+    printf("Dead ends: %d\n", stats->dead_ends);
+    printf("Junctions: %d (branching factor %.2f)\n", stats->junctions, stats->branching_factor);
+    printf("Longest corridor: %d cells\n", stats->longest_corridor);
+    printf("Useful breakable walls: %d\n", stats->useful_breakables);
+    printf("Spawn distances to exit:");
+    for (int i = 0; i < MAZE_STATS_SPAWNS; i++) {
+        printf(" %d", stats->spawn_distance[i]);
+    }
+    printf("\n");
+}
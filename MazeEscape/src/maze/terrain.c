@@ -0,0 +1,262 @@
+#include "maze/terrain.h"
+#include "maze/generators.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+// Open cells per mud or ice patch, and belt length
+#define TERRAIN_PATCH_CELLS 6
+
+// Placement attempts per requested terrain cell
+#define TERRAIN_PLACEMENT_TRIES 4
+
+// Neighbour offsets, in the same order as the conveyor types
+static const int TERRAIN_DX[4] = {0, 1, 0, -1};
+static const int TERRAIN_DY[4] = {-1, 0, 1, 0};
+
+// Properties per TerrainType
+static const TerrainInfo TERRAIN_INFO[TERRAIN_COUNT] = {
+    {"normal",         TERRAIN_BASE_COST,     1.0f, 1.0f, 1.0f,  0,  0},
+    {"mud",            TERRAIN_BASE_COST * 3, 0.5f, 1.0f, 1.5f,  0,  0},
+    {"ice",            TERRAIN_BASE_COST - 1, 1.2f, 0.2f, 0.1f,  0,  0},
+    {"conveyor-up",    TERRAIN_BASE_COST,     1.0f, 1.0f, 1.0f,  0, -1},
+    {"conveyor-right", TERRAIN_BASE_COST,     1.0f, 1.0f, 1.0f,  1,  0},
+    {"conveyor-down",  TERRAIN_BASE_COST,     1.0f, 1.0f, 1.0f,  0,  1},
+    {"conveyor-left",  TERRAIN_BASE_COST,     1.0f, 1.0f, 1.0f, -1,  0}
+};
+
+// Local function prototypes
+static int terrain_entry_cost(MazeTerrain* terrain, int index, int move_x, int move_y);
+static bool terrain_is_free(MazeTerrain* terrain, int x, int y);
+static int terrain_grow_patch(MazeTerrain* terrain, int x, int y, TerrainType type, unsigned int* seed);
+static int terrain_lay_belt(MazeTerrain* terrain, int x, int y, unsigned int* seed);
+
+// Create an all-normal terrain layer and attach it as maze->terrain, so
+// cell edits keep its cost field up to date
+MazeTerrain* maze_terrain_create(Maze* maze) {
+    MazeTerrain* terrain = (MazeTerrain*)calloc(1, sizeof(MazeTerrain));
+    if (!terrain) return NULL;
+    
+    int cell_count = maze->width * maze->height;
+    terrain->maze = maze;
+    terrain->types = (unsigned char*)calloc((size_t)cell_count * 2, 1);
+    terrain->exit_cost = (int*)malloc(cell_count * sizeof(int));
+    radix_heap_init(&terrain->heap);
+    
+    if (!terrain->types || !terrain->exit_cost) {
+        fprintf(stderr, "Failed to allocate terrain for %dx%d maze\n", maze->width, maze->height);
+        maze_terrain_destroy(terrain);
+        return NULL;
+    }
+    
+    terrain->costs = terrain->types + cell_count;
+    for (int i = 0; i < cell_count; i++) {
+        terrain->costs[i] = TERRAIN_BASE_COST;
+    }
+    
+    maze->terrain = terrain;
+    maze_terrain_compute_costs(terrain);
+    return terrain;
+}
+
+// Free a terrain layer (detaching it from its maze)
+void maze_terrain_destroy(MazeTerrain* terrain) {
+    if (!terrain) return;
+    
+    if (terrain->maze->terrain == terrain) {
+        terrain->maze->terrain = NULL;
+    }
+    radix_heap_free(&terrain->heap);
+    free(terrain->types);
+    free(terrain->exit_cost);
+    free(terrain);
+}
+
+// Get the properties of a floor type
+const TerrainInfo* maze_terrain_info(TerrainType type) {
+    if (type < 0 || type >= TERRAIN_COUNT) type = TERRAIN_NORMAL;
+    return &TERRAIN_INFO[type];
+}
+
+// Change a cell's floor type. Costs are not recomputed, so several cells can
+// be set before one maze_terrain_compute_costs.
+void maze_terrain_set(MazeTerrain* terrain, int x, int y, TerrainType type) {
+    Maze* maze = terrain->maze;
+    if (x < 0 || x >= maze->width || y < 0 || y >= maze->height) return;
+    if (type < 0 || type >= TERRAIN_COUNT) return;
+    
+    int index = x * maze->height + y;
+    if (terrain->types[index] != TERRAIN_NORMAL) terrain->terrain_cells--;
+    if (type != TERRAIN_NORMAL) terrain->terrain_cells++;
+    terrain->types[index] = (unsigned char)type;
+    terrain->costs[index] = TERRAIN_INFO[type].cost;
+}
+
+// Cover about `fraction` of the open floor with mud and ice patches and
+// short conveyor belts along corridors, then compute the cost field.
+// Returns the number of cells given a terrain type.
+int maze_terrain_populate(MazeTerrain* terrain, unsigned int seed, float fraction) {
+    Maze* maze = terrain->maze;
+    if (fraction <= 0.0f) return 0;
+    if (fraction > 1.0f) fraction = 1.0f;
+    
+    // Independent of the generator's, dynamic layer's and triggers' streams
+    seed = maze_random_jump(seed, 5u << 28);
+    
+    int open_cells = 0;
+    for (int x = 0; x < maze->width; x++) {
+        for (int y = 0; y < maze->height; y++) {
+            if (maze->cells[x][y] == CELL_EMPTY) open_cells++;
+        }
+    }
+    
+    int target = (int)(open_cells * fraction);
+    int placed = 0;
+    for (int attempt = 0; placed < target && attempt < target * TERRAIN_PLACEMENT_TRIES; attempt++) {
+        int x = maze_random_below(&seed, maze->width);
+        int y = maze_random_below(&seed, maze->height);
+        if (!terrain_is_free(terrain, x, y)) continue;
+        
+        switch (maze_random_below(&seed, 3)) {
+            case 0:
+                placed += terrain_grow_patch(terrain, x, y, TERRAIN_MUD, &seed);
+                break;
+            case 1:
+                placed += terrain_grow_patch(terrain, x, y, TERRAIN_ICE, &seed);
+                break;
+            default:
+                placed += terrain_lay_belt(terrain, x, y, &seed);
+                break;
+        }
+    }
+    
+    maze_terrain_compute_costs(terrain);
+    return placed;
+}
+
+// Recompute the weighted cost to the exit of every open cell: Dijkstra
+// backwards from the exit, where moving into a cell costs that cell's cost
+// byte (adjusted for belts by the direction of travel)
+void maze_terrain_compute_costs(MazeTerrain* terrain) {
+    Maze* maze = terrain->maze;
+    int* cost = terrain->exit_cost;
+    int cell_count = maze->width * maze->height;
+    for (int i = 0; i < cell_count; i++) {
+        cost[i] = MAZE_UNREACHABLE;
+    }
+    
+    RadixHeap* heap = &terrain->heap;
+    radix_heap_clear(heap);
+    int exit_index = maze->exit_x * maze->height + maze->exit_y;
+    cost[exit_index] = 0;
+    radix_heap_push(heap, 0, exit_index);
+    
+    RadixHeapEntry entry;
+    while (radix_heap_pop(heap, &entry)) {
+        int current = entry.value;
+        
+        // Skip entries superseded by a cheaper route
+        if ((int)entry.key != cost[current]) continue;
+        
+        int cx = current / maze->height;
+        int cy = current % maze->height;
+        for (int dir = 0; dir < 4; dir++) {
+            int nx = cx + TERRAIN_DX[dir];
+            int ny = cy + TERRAIN_DY[dir];
+            if (maze_is_wall(maze, nx, ny)) continue;
+            
+            // A racer in the neighbour reaches this cell moving against dir
+            int next = nx * maze->height + ny;
+            int total = cost[current] + terrain_entry_cost(terrain, current, -TERRAIN_DX[dir], -TERRAIN_DY[dir]);
+            if (cost[next] != MAZE_UNREACHABLE && cost[next] <= total) continue;
+            
+            cost[next] = total;
+            radix_heap_push(heap, (unsigned int)total, next);
+        }
+    }
+}
+
+// Get a cell's floor type (normal for mazes without terrain)
+TerrainType maze_get_terrain(Maze* maze, int x, int y) {
+    if (!maze->terrain) return TERRAIN_NORMAL;
+    if (x < 0 || x >= maze->width || y < 0 || y >= maze->height) return TERRAIN_NORMAL;
+    
+    return (TerrainType)maze->terrain->types[x * maze->height + y];
+}
+
+// Get the weighted cost to the exit from a cell. Without terrain every step
+// costs the same, so this is the exit distance.
+int maze_get_exit_cost(Maze* maze, int x, int y) {
+    if (!maze->terrain) return maze_get_exit_distance(maze, x, y);
+    if (x < 0 || x >= maze->width || y < 0 || y >= maze->height) return MAZE_UNREACHABLE;
+    
+    return maze->terrain->exit_cost[x * maze->height + y];
+}
+
+// Helper: Cost of moving into a cell in direction (move_x, move_y). Riding a
+// belt halves it and going against one doubles it.
+static int terrain_entry_cost(MazeTerrain* terrain, int index, int move_x, int move_y) {
+    const TerrainInfo* info = &TERRAIN_INFO[terrain->types[index]];
+    int cost = terrain->costs[index];
+    
+    if (info->push_x == move_x && info->push_y == move_y && (move_x || move_y)) {
+        cost = cost > 1 ? cost / 2 : 1;
+    } else if (info->push_x == -move_x && info->push_y == -move_y && (move_x || move_y)) {
+        cost *= 2;
+    }
+    return cost;
+}
+
+// Helper: Whether a cell is plain open floor without terrain yet
+static bool terrain_is_free(MazeTerrain* terrain, int x, int y) {
+    Maze* maze = terrain->maze;
+    if (x < 0 || x >= maze->width || y < 0 || y >= maze->height) return false;
+    
+    return maze->cells[x][y] == CELL_EMPTY && terrain->types[x * maze->height + y] == TERRAIN_NORMAL;
+}
+
+// Helper: Random walk over free cells from (x, y), giving each the type.
+// Returns the number of cells covered.
+static int terrain_grow_patch(MazeTerrain* terrain, int x, int y, TerrainType type, unsigned int* seed) {
+    int covered = 0;
+    
+    while (covered < TERRAIN_PATCH_CELLS) {
+        maze_terrain_set(terrain, x, y, type);
+        covered++;
+        
+        // First free neighbour from a random direction
+        int first = maze_random_below(seed, 4);
+        int dir = -1;
+        for (int i = 0; i < 4 && dir < 0; i++) {
+            int candidate = (first + i) % 4;
+            if (terrain_is_free(terrain, x + TERRAIN_DX[candidate], y + TERRAIN_DY[candidate])) dir = candidate;
+        }
+        if (dir < 0) break;
+        
+        x += TERRAIN_DX[dir];
+        y += TERRAIN_DY[dir];
+    }
+    
+    return covered;
+}
+
+// Helper: Lay a straight belt from (x, y) along a random open direction,
+// every cell pushing the same way. Returns the number of cells covered.
+static int terrain_lay_belt(MazeTerrain* terrain, int x, int y, unsigned int* seed) {
+    int first = maze_random_below(seed, 4);
+    int dir = first;
+    for (int i = 0; i < 4; i++) {
+        dir = (first + i) % 4;
+        if (terrain_is_free(terrain, x + TERRAIN_DX[dir], y + TERRAIN_DY[dir])) break;
+    }
+    
+    TerrainType type = (TerrainType)(TERRAIN_CONVEYOR_UP + dir);
+    int covered = 0;
+    while (covered < TERRAIN_PATCH_CELLS && terrain_is_free(terrain, x, y)) {
+        maze_terrain_set(terrain, x, y, type);
+        covered++;
+        x += TERRAIN_DX[dir];
+        y += TERRAIN_DY[dir];
+    }
+    
+    return covered;
+}
@@ -0,0 +1,183 @@
+#include "maze/triggers.h"
+#include "maze/generators.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Local function prototypes
+static void* triggers_alloc(Maze* maze, size_t size);
+static int triggers_add(MazeTriggers* triggers, MazeTriggerType type, int x, int y);
+static void triggers_remove(MazeTriggers* triggers, int index);
+static void triggers_pair_portals(MazeTriggers* triggers);
+
+// Build the trigger table from the maze's special cells. Each one gets a
+// random type; portals are shuffled and paired so a jump usually crosses
+// the maze (an odd one out becomes a speed pad). Arena mazes keep the
+// table in their arena, so building it costs no heap calls.
+MazeTriggers* maze_triggers_create(Maze* maze, unsigned int seed) {
+    MazeTriggers* triggers = (MazeTriggers*)triggers_alloc(maze, sizeof(MazeTriggers));
+    if (!triggers) return NULL;
+    memset(triggers, 0, sizeof(MazeTriggers));
+    
+    // Independent of the generator's and dynamic layer's streams
+    seed = maze_random_jump(seed, 3u << 29);
+    
+    // Size the trigger array for the special cells up front
+    int cell_count = maze->width * maze->height;
+    int special_count = 0;
+    for (int i = 0; i < cell_count; i++) {
+        if (maze->cells[i / maze->height][i % maze->height] == CELL_SPECIAL) special_count++;
+    }
+    
+    triggers->maze = maze;
+    triggers->trigger_capacity = special_count > 0 ? special_count : 16;
+    triggers->cell_triggers = (int*)triggers_alloc(maze, cell_count * sizeof(int));
+    triggers->triggers = (MazeTrigger*)triggers_alloc(maze, triggers->trigger_capacity * sizeof(MazeTrigger));
+    if (!triggers->cell_triggers || !triggers->triggers) {
+        fprintf(stderr, "Failed to allocate trigger table for %dx%d maze\n", maze->width, maze->height);
+        maze_triggers_destroy(triggers);
+        return NULL;
+    }
+    
+    for (int i = 0; i < cell_count; i++) {
+        triggers->cell_triggers[i] = -1;
+    }
+    
+    for (int x = 0; x < maze->width; x++) {
+        for (int y = 0; y < maze->height; y++) {
+            if (maze->cells[x][y] != CELL_SPECIAL) continue;
+            
+            MazeTriggerType type = (MazeTriggerType)maze_random_below(&seed, 3);
+            if (triggers_add(triggers, type, x, y) < 0) {
+                maze_triggers_destroy(triggers);
+                return NULL;
+            }
+        }
+    }
+    
+    triggers->seed = seed;
+    triggers_pair_portals(triggers);
+    
+    return triggers;
+}
+
+// Free a trigger table (arena tables go with their arena)
+void maze_triggers_destroy(MazeTriggers* triggers) {
+    if (!triggers || triggers->maze->arena) return;
+    
+    free(triggers->cell_triggers);
+    free(triggers->triggers);
+    free(triggers);
+}
+
+// Get the trigger in a cell (NULL if the cell is not special)
+const MazeTrigger* maze_triggers_at(const MazeTriggers* triggers, int x, int y) {
+    Maze* maze = triggers->maze;
+    if (x < 0 || x >= maze->width || y < 0 || y >= maze->height) return NULL;
+    
+    int index = triggers->cell_triggers[x * maze->height + y];
+    return index >= 0 ? &triggers->triggers[index] : NULL;
+}
+
+// Follow a batch of journaled cell edits: cells that stop being special lose
+// their trigger (a portal's partner becomes a speed pad), and cells that
+// become special get a speed pad or cooldown reset
+void maze_triggers_apply_changes(MazeTriggers* triggers, const MazeCellChange* changes, int change_count) {
+    Maze* maze = triggers->maze;
+    
+    for (int i = 0; i < change_count; i++) {
+        const MazeCellChange* change = &changes[i];
+        int index = triggers->cell_triggers[change->x * maze->height + change->y];
+        
+        if (change->new_type == CELL_SPECIAL && index < 0) {
+            MazeTriggerType type = (MazeTriggerType)maze_random_below(&triggers->seed, 2);
+            triggers_add(triggers, type, change->x, change->y);
+        } else if (change->new_type != CELL_SPECIAL && index >= 0) {
+            triggers_remove(triggers, index);
+        }
+    }
+}
+
+// Helper: Append a trigger and point its cell at it. Returns its index, or
+// -1 if the array could not grow.
+static int triggers_add(MazeTriggers* triggers, MazeTriggerType type, int x, int y) {
+    if (triggers->trigger_count == triggers->trigger_capacity) {
+        int capacity = triggers->trigger_capacity ? triggers->trigger_capacity * 2 : 16;
+        Arena* arena = triggers->maze->arena;
+        MazeTrigger* grown = arena
+            ? (MazeTrigger*)arena_grow(arena, triggers->triggers,
+                  triggers->trigger_capacity * sizeof(MazeTrigger), capacity * sizeof(MazeTrigger))
+            : (MazeTrigger*)realloc(triggers->triggers, capacity * sizeof(MazeTrigger));
+        if (!grown) {
+            fprintf(stderr, "Failed to grow trigger table to %d triggers\n", capacity);
+            return -1;
+        }
+        triggers->triggers = grown;
+        triggers->trigger_capacity = capacity;
+    }
+    
+    int index = triggers->trigger_count++;
+    MazeTrigger* trigger = &triggers->triggers[index];
+    trigger->type = type;
+    trigger->x = x;
+    trigger->y = y;
+    trigger->partner = -1;
+    triggers->cell_triggers[x * triggers->maze->height + y] = index;
+    return index;
+}
+
+// Helper: Drop a trigger by moving the last one into its slot, fixing the
+// moved trigger's cell and partner links
+static void triggers_remove(MazeTriggers* triggers, int index) {
+    int height = triggers->maze->height;
+    MazeTrigger* trigger = &triggers->triggers[index];
+    
+    if (trigger->partner >= 0) {
+        MazeTrigger* partner = &triggers->triggers[trigger->partner];
+        partner->type = MAZE_TRIGGER_SPEED_PAD;
+        partner->partner = -1;
+    }
+    triggers->cell_triggers[trigger->x * height + trigger->y] = -1;
+    
+    int last = --triggers->trigger_count;
+    if (index == last) return;
+    
+    *trigger = triggers->triggers[last];
+    triggers->cell_triggers[trigger->x * height + trigger->y] = index;
+    if (trigger->partner >= 0) {
+        triggers->triggers[trigger->partner].partner = index;
+    }
+}
+
+// Helper: Shuffle the portals and link them two by two (at most one
+// trigger per cell, so the list fits in the maze's scratch buffer)
+static void triggers_pair_portals(MazeTriggers* triggers) {
+    int* portals = triggers->maze->scratch;
+    
+    int portal_count = 0;
+    for (int i = 0; i < triggers->trigger_count; i++) {
+        if (triggers->triggers[i].type == MAZE_TRIGGER_PORTAL) {
+            portals[portal_count++] = i;
+        }
+    }
+    
+    for (int i = portal_count - 1; i > 0; i--) {
+        int j = maze_random_below(&triggers->seed, i + 1);
+        int swap = portals[i];
+        portals[i] = portals[j];
+        portals[j] = swap;
+    }
+    
+    for (int i = 0; i + 1 < portal_count; i += 2) {
+        triggers->triggers[portals[i]].partner = portals[i + 1];
+        triggers->triggers[portals[i + 1]].partner = portals[i];
+    }
+    if (portal_count % 2 == 1) {
+        triggers->triggers[portals[portal_count - 1]].type = MAZE_TRIGGER_SPEED_PAD;
+    }
+}
+
+// Helper: Allocate from the maze's arena, or the heap for heap mazes
+static void* triggers_alloc(Maze* maze, size_t size) {
+    return maze->arena ? arena_alloc(maze->arena, size) : malloc(size);
+}
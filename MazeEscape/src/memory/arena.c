@@ -0,0 +1,141 @@
+#include "memory/arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Alignment of every allocation (enough for doubles and pointers)
+#define ARENA_ALIGNMENT 16
+
+// One contiguous chunk of arena memory
+struct ArenaBlock {
+    ArenaBlock* next;
+    size_t size;
+    size_t used;
+    // Allocation space follows the (aligned) header
+};
+
+// Local function prototypes
+static size_t align_up(size_t value);
+static ArenaBlock* arena_new_block(size_t size);
+static unsigned char* block_data(ArenaBlock* block);
+
+// Create an empty arena (blocks are allocated on first use)
+Arena* arena_create(size_t block_size) {
+    Arena* arena = (Arena*)malloc(sizeof(Arena));
+    if (!arena) return NULL;
+    
+    arena->first = NULL;
+    arena->current = NULL;
+    arena->block_size = block_size > 0 ? block_size : 64 * 1024;
+    return arena;
+}
+
+// Free an arena and all memory allocated from it
+void arena_destroy(Arena* arena) {
+    if (!arena) return;
+    
+    ArenaBlock* block = arena->first;
+    while (block) {
+        ArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+    
+    free(arena);
+}
+
+// Allocate uninitialized memory
+void* arena_alloc(Arena* arena, size_t size) {
+    size = align_up(size > 0 ? size : 1);
+    
+    // Continue into blocks kept from before the last reset, then grow the chain
+    while (arena->current && arena->current->used + size > arena->current->size) {
+        if (!arena->current->next) break;
+        arena->current = arena->current->next;
+        arena->current->used = 0;
+    }
+    
+    if (!arena->current || arena->current->used + size > arena->current->size) {
+        ArenaBlock* block = arena_new_block(size > arena->block_size ? size : arena->block_size);
+        if (!block) return NULL;
+        
+        // Link the new block after the current one so it is reused after a reset
+        if (arena->current) {
+            block->next = arena->current->next;
+            arena->current->next = block;
+        } else {
+            block->next = arena->first;
+            arena->first = block;
+        }
+        arena->current = block;
+    }
+    
+    void* data = block_data(arena->current) + arena->current->used;
+    arena->current->used += size;
+    return data;
+}
+
+// Allocate zeroed memory
+void* arena_calloc(Arena* arena, size_t count, size_t size) {
+    void* data = arena_alloc(arena, count * size);
+    if (data) {
+        memset(data, 0, count * size);
+    }
+    return data;
+}
+
+// Grow an arena allocation (the old copy is abandoned until the next reset)
+void* arena_grow(Arena* arena, void* data, size_t old_size, size_t new_size) {
+    void* grown = arena_alloc(arena, new_size);
+    if (grown && data) {
+        memcpy(grown, data, old_size < new_size ? old_size : new_size);
+    }
+    return grown;
+}
+
+// Copy a string into the arena
+char* arena_strdup(Arena* arena, const char* text) {
+    size_t length = strlen(text) + 1;
+    char* copy = (char*)arena_alloc(arena, length);
+    if (copy) {
+        memcpy(copy, text, length);
+    }
+    return copy;
+}
+
+// Release every allocation at once; blocks stay allocated for reuse
+void arena_reset(Arena* arena) {
+    arena->current = arena->first;
+    if (arena->current) {
+        arena->current->used = 0;
+    }
+}
+
+// Total bytes held by the arena's blocks
+size_t arena_capacity(const Arena* arena) {
+    size_t total = 0;
+    for (ArenaBlock* block = arena->first; block; block = block->next) {
+        total += block->size;
+    }
+    return total;
+}
+
+// Helper: Round a size up to the allocation alignment
+static size_t align_up(size_t value) {
+    return (value + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+}
+
+// Helper: Allocate a block with room for size bytes
+static ArenaBlock* arena_new_block(size_t size) {
+    ArenaBlock* block = (ArenaBlock*)malloc(align_up(sizeof(ArenaBlock)) + size);
+    if (!block) return NULL;
+    
+    block->next = NULL;
+    block->size = size;
+    block->used = 0;
+    return block;
+}
+
+// Helper: First usable byte of a block
+static unsigned char* block_data(ArenaBlock* block) {
+    return (unsigned char*)block + align_up(sizeof(ArenaBlock));
+}
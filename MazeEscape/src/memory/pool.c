@@ -0,0 +1,186 @@
+#include "memory/pool.h"
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#ifdef _MSC_VER
+#define POOL_THREAD_LOCAL __declspec(thread)
+#else
+#define POOL_THREAD_LOCAL _Thread_local
+#endif
+
+// Size classes are powers of two from 32 bytes to 4 KB (header included)
+#define POOL_MIN_SHIFT 5
+#define POOL_CLASS_COUNT 8
+#define POOL_LARGE_CLASS POOL_CLASS_COUNT
+#define POOL_CHUNK_SIZE (64 * 1024)
+
+// Header in front of every block; keeps the payload 16-byte aligned
+typedef union {
+    size_t size_class;
+    unsigned char padding[16];
+} PoolHeader;
+
+// Free block (the header space is reused for the link)
+typedef struct PoolFreeBlock {
+    struct PoolFreeBlock* next;
+} PoolFreeBlock;
+
+// Chunk of memory carved into blocks of one size class
+typedef struct PoolChunk {
+    struct PoolChunk* next;
+    unsigned char padding[8];
+} PoolChunk;
+
+// State of the calling thread's pool
+typedef struct {
+    PoolFreeBlock* free_lists[POOL_CLASS_COUNT];
+    PoolChunk* chunks;
+    PoolStats stats;
+} ThreadPool;
+
+// Local variables
+static POOL_THREAD_LOCAL ThreadPool thread_pool;
+
+// Local function prototypes
+static int size_class_for(size_t size);
+static size_t class_block_size(int size_class);
+static void* pool_alloc(size_t size);
+static bool pool_refill(int size_class);
+
+// Allocate zeroed memory
+void* pool_calloc(size_t count, size_t size) {
+    size_t total = count * size;
+    void* data = pool_alloc(total);
+    if (data) {
+        memset(data, 0, total);
+    }
+    return data;
+}
+
+// Resize a block, moving it when it changes size class
+void* pool_realloc(void* data, size_t size) {
+    if (!data) return pool_alloc(size);
+    
+    PoolHeader* header = (PoolHeader*)data - 1;
+    int old_class = (int)header->size_class;
+    
+    // Large blocks stay on the system allocator
+    if (old_class == POOL_LARGE_CLASS && size_class_for(size) == POOL_LARGE_CLASS) {
+        thread_pool.stats.system_allocs++;
+        PoolHeader* grown = (PoolHeader*)realloc(header, sizeof(PoolHeader) + size);
+        return grown ? grown + 1 : NULL;
+    }
+    
+    // Still fits the current block
+    if (old_class != POOL_LARGE_CLASS && size + sizeof(PoolHeader) <= class_block_size(old_class)) {
+        return data;
+    }
+    
+    void* moved = pool_alloc(size);
+    if (!moved) return NULL;
+    
+    size_t old_size = old_class == POOL_LARGE_CLASS ? size : class_block_size(old_class) - sizeof(PoolHeader);
+    memcpy(moved, data, old_size < size ? old_size : size);
+    pool_free(data);
+    return moved;
+}
+
+// Return a block to the calling thread's free list
+void pool_free(void* data) {
+    if (!data) return;
+    
+    PoolHeader* header = (PoolHeader*)data - 1;
+    int size_class = (int)header->size_class;
+    
+    if (size_class == POOL_LARGE_CLASS) {
+        free(header);
+        return;
+    }
+    
+    PoolFreeBlock* block = (PoolFreeBlock*)header;
+    block->next = thread_pool.free_lists[size_class];
+    thread_pool.free_lists[size_class] = block;
+}
+
+// Read the calling thread's counters
+void pool_get_stats(PoolStats* stats) {
+    *stats = thread_pool.stats;
+}
+
+// Free the calling thread's chunks. Only call this when nothing allocated
+// from this thread's pool is still in use (e.g. as a worker thread exits).
+void pool_release_thread(void) {
+    PoolChunk* chunk = thread_pool.chunks;
+    while (chunk) {
+        PoolChunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    
+    memset(&thread_pool, 0, sizeof(thread_pool));
+}
+
+// Helper: Allocate a block of at least size bytes
+static void* pool_alloc(size_t size) {
+    int size_class = size_class_for(size);
+    
+    if (size_class == POOL_LARGE_CLASS) {
+        thread_pool.stats.system_allocs++;
+        PoolHeader* header = (PoolHeader*)malloc(sizeof(PoolHeader) + size);
+        if (!header) return NULL;
+        header->size_class = POOL_LARGE_CLASS;
+        return header + 1;
+    }
+    
+    if (!thread_pool.free_lists[size_class] && !pool_refill(size_class)) {
+        return NULL;
+    }
+    
+    PoolFreeBlock* block = thread_pool.free_lists[size_class];
+    thread_pool.free_lists[size_class] = block->next;
+    
+    PoolHeader* header = (PoolHeader*)block;
+    header->size_class = (size_t)size_class;
+    return header + 1;
+}
+
+// Helper: Carve a new chunk into free blocks of one size class
+static bool pool_refill(int size_class) {
+    PoolChunk* chunk = (PoolChunk*)malloc(POOL_CHUNK_SIZE);
+    if (!chunk) return false;
+    
+    thread_pool.stats.system_allocs++;
+    thread_pool.stats.chunk_bytes += POOL_CHUNK_SIZE;
+    chunk->next = thread_pool.chunks;
+    thread_pool.chunks = chunk;
+    
+    size_t block_size = class_block_size(size_class);
+    unsigned char* cursor = (unsigned char*)chunk + sizeof(PoolChunk);
+    unsigned char* end = (unsigned char*)chunk + POOL_CHUNK_SIZE;
+    
+    while (cursor + block_size <= end) {
+        PoolFreeBlock* block = (PoolFreeBlock*)cursor;
+        block->next = thread_pool.free_lists[size_class];
+        thread_pool.free_lists[size_class] = block;
+        cursor += block_size;
+    }
+    
+    return true;
+}
+
+// Helper: Smallest size class holding size bytes plus the header
+static int size_class_for(size_t size) {
+    size_t needed = size + sizeof(PoolHeader);
+    for (int size_class = 0; size_class < POOL_CLASS_COUNT; size_class++) {
+        if (needed <= class_block_size(size_class)) {
+            return size_class;
+        }
+    }
+    return POOL_LARGE_CLASS;
+}
+
+// Helper: Block size of a size class
+static size_t class_block_size(int size_class) {
+    return (size_t)1 << (POOL_MIN_SHIFT + size_class);
+}
@@ -3,6 +3,12 @@
 #include "maze/maze.h"
 #include <stdlib.h>
 
+// Local function prototypes
+static void post_shape_free(cpShape* shape, void* data);
+static void post_body_free(cpBody* body, void* data);
+static void shape_free(cpSpace* space, void* shape, void* data);
+static void body_free(cpSpace* space, void* body, void* data);
+
 // Create a new physics space
 cpSpace* physics_create_space(float gravity_x, float gravity_y) {
     cpSpace* space = cpSpaceNew();
@@ -19,8 +25,13 @@ cpSpace* physics_create_space(float gravity_x, float gravity_y) {
     return space;
 }
 
-// Destroy a physics space
+// Destroy a physics space with every shape and body in it
+// (cpSpaceFree only frees the space itself)
 void physics_destroy_space(cpSpace* space) {
+    // Removal is not allowed while iterating, so queue it as post-step work,
+    // which runs as soon as the iteration unlocks the space
+    cpSpaceEachShape(space, post_shape_free, space);
+    cpSpaceEachBody(space, post_body_free, space);
     cpSpaceFree(space);
 }
 
@@ -65,6 +76,24 @@ cpShape* physics_add_box(cpSpace* space, cpBody* body, float width, float height
     return shape;
 }
 
+// Add a box shape with its top-left corner at (x, y) in body coordinates
+cpShape* physics_add_box_at(cpSpace* space, cpBody* body, float x, float y, float width, float height, float friction, CollisionType type) {
+    // Offset box so many shapes can share one static body
+    cpShape* shape = cpBoxShapeNew2(body, cpBBNew(x, y, x + width, y + height), 0);
+    
+    // Set shape properties
+    cpShapeSetFriction(shape, friction);
+    cpShapeSetElasticity(shape, 0.1);
+    
+    // Set collision type
+    cpShapeSetCollisionType(shape, (cpCollisionType)type);
+    
+    // Add shape to space
+    cpSpaceAddShape(space, shape);
+    
+    return shape;
+}
+
 // Add a circle shape to a body
 cpShape* physics_add_circle(cpSpace* space, cpBody* body, float radius, float friction, CollisionType type) {
     // Create circle shape
@@ -176,3 +205,27 @@ void physics_register_collision_handlers(cpSpace* space) {
     );
     handler_char_breakable->beginFunc = physics_begin_collision;
 }
+
+// Helper: Queue a shape for removal and freeing
+static void post_shape_free(cpShape* shape, void* data) {
+    cpSpaceAddPostStepCallback((cpSpace*)data, shape_free, shape, NULL);
+}
+
+// Helper: Queue a body for removal and freeing (the space's static body is not iterated)
+static void post_body_free(cpBody* body, void* data) {
+    cpSpaceAddPostStepCallback((cpSpace*)data, body_free, body, NULL);
+}
+
+// Helper: Remove and free a shape
+static void shape_free(cpSpace* space, void* shape, void* data) {
+    (void)data;
+    cpSpaceRemoveShape(space, (cpShape*)shape);
+    cpShapeFree((cpShape*)shape);
+}
+
+// Helper: Remove and free a body
+static void body_free(cpSpace* space, void* body, void* data) {
+    (void)data;
+    cpSpaceRemoveBody(space, (cpBody*)body);
+    cpBodyFree((cpBody*)body);
+}
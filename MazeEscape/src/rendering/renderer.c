@@ -1,4 +1,7 @@
 #include "rendering/renderer.h"
+#include "trace/trace.h"
+#include "maze/terrain.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
@@ -16,7 +19,7 @@ static const Color COLOR_CYAN = {0, 255, 255, 255};
 static const Color COLOR_MAGENTA = {255, 0, 255, 255};
 
 // Particle structure
-typedef struct {
+struct Particle {
     float x;
     float y;
     float vx;
@@ -27,17 +30,23 @@ typedef struct {
     Color color;
     ParticleType type;
     bool active;
-} Particle;
+};
 
 // Maximum number of particles
 #define MAX_PARTICLES 2000
 
-// Local variables
-static Particle particles[MAX_PARTICLES];
-static int next_particle = 0;
+// Fog overlay texels (RGBA8888): unrevealed cells are opaque dark blue
+#define FOG_HIDDEN_TEXEL 0x0A0A14FFu
+#define FOG_REVEALED_TEXEL 0x00000000u
+
+// Local function prototypes
+static bool renderer_init_common(Renderer* renderer, int width, int height);
+static int renderer_random(Renderer* renderer);
+static bool renderer_sync_fog(Renderer* renderer, MazeFog* fog);
+static void renderer_draw_terrain(Renderer* renderer, const SDL_Rect* cell_rect, TerrainType terrain);
 
 // Create a renderer
-Renderer* renderer_create(int width, int height, const char* title) {
+Renderer* renderer_create(int width, int height, const char* title, bool vsync) {
     // Allocate renderer structure
     Renderer* renderer = (Renderer*)malloc(sizeof(Renderer));
     if (!renderer) return NULL;
@@ -55,10 +64,12 @@ Renderer* renderer_create(int width, int height, const char* title) {
         return NULL;
     }
     
-    renderer->sdl_renderer = SDL_CreateRenderer(
-        renderer->window, -1,
-        SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC
-    );
+    Uint32 flags = SDL_RENDERER_ACCELERATED;
+    if (vsync) {
+        flags |= SDL_RENDERER_PRESENTVSYNC;
+    }
+    
+    renderer->sdl_renderer = SDL_CreateRenderer(renderer->window, -1, flags);
     
     if (!renderer->sdl_renderer) {
         SDL_DestroyWindow(renderer->window);
@@ -66,22 +77,48 @@ Renderer* renderer_create(int width, int height, const char* title) {
         return NULL;
     }
     
-    // Initialize renderer properties
-    renderer->screen_width = width;
-    renderer->screen_height = height;
-    renderer->camera_x = 0;
-    renderer->camera_y = 0;
-    renderer->camera_zoom = 1.0f;
-    renderer->show_debug = false;
+    renderer->target_surface = NULL;
     
-    // Initialize textures to NULL
-    for (int i = 0; i < TEXTURE_COUNT; i++) {
-        renderer->textures[i] = NULL;
+    if (!renderer_init_common(renderer, width, height)) {
+        SDL_DestroyRenderer(renderer->sdl_renderer);
+        SDL_DestroyWindow(renderer->window);
+        free(renderer);
+        return NULL;
     }
     
-    // Initialize particles
-    for (int i = 0; i < MAX_PARTICLES; i++) {
-        particles[i].active = false;
+    return renderer;
+}
+
+// Create a renderer that draws into an offscreen surface with no window
+Renderer* renderer_create_headless(int width, int height) {
+    Renderer* renderer = (Renderer*)malloc(sizeof(Renderer));
+    if (!renderer) return NULL;
+    
+    renderer->window = NULL;
+    
+    // RGB24 matches the encoder's pixel layout, so frames need no conversion
+    renderer->target_surface = SDL_CreateRGBSurfaceWithFormat(
+        0, width, height, 24, SDL_PIXELFORMAT_RGB24
+    );
+    
+    if (!renderer->target_surface) {
+        free(renderer);
+        return NULL;
+    }
+    
+    renderer->sdl_renderer = SDL_CreateSoftwareRenderer(renderer->target_surface);
+    
+    if (!renderer->sdl_renderer) {
+        SDL_FreeSurface(renderer->target_surface);
+        free(renderer);
+        return NULL;
+    }
+    
+    if (!renderer_init_common(renderer, width, height)) {
+        SDL_DestroyRenderer(renderer->sdl_renderer);
+        SDL_FreeSurface(renderer->target_surface);
+        free(renderer);
+        return NULL;
     }
     
     return renderer;
@@ -98,6 +135,10 @@ void renderer_destroy(Renderer* renderer) {
         }
     }
     
+    if (renderer->fog_texture) {
+        SDL_DestroyTexture(renderer->fog_texture);
+    }
+    
     // Destroy SDL renderer and window
     if (renderer->sdl_renderer) {
         SDL_DestroyRenderer(renderer->sdl_renderer);
@@ -107,7 +148,16 @@ void renderer_destroy(Renderer* renderer) {
         SDL_DestroyWindow(renderer->window);
     }
     
-    // Free renderer structure
+    if (renderer->target_surface) {
+        SDL_FreeSurface(renderer->target_surface);
+    }
+    
+    if (renderer->readback_surface) {
+        SDL_FreeSurface(renderer->readback_surface);
+    }
+    
+    // Free particle pool and renderer structure
+    free(renderer->particles);
     free(renderer);
 }
 
@@ -125,6 +175,33 @@ void renderer_present(Renderer* renderer) {
     SDL_RenderPresent(renderer->sdl_renderer);
 }
 
+// Get the frame just drawn as a surface: the target of a headless renderer,
+// or one readback of a window, which every output can then crop from
+SDL_Surface* renderer_read_frame(Renderer* renderer) {
+    if (renderer->target_surface) return renderer->target_surface;
+    
+    if (!renderer->readback_surface) {
+        renderer->readback_surface = SDL_CreateRGBSurfaceWithFormat(
+            0, renderer->screen_width, renderer->screen_height, 24, SDL_PIXELFORMAT_RGB24
+        );
+        if (!renderer->readback_surface) {
+            fprintf(stderr, "Error creating readback surface: %s\n", SDL_GetError());
+            return NULL;
+        }
+    }
+    
+    TRACE_BEGIN(readback_zone, "render.readback");
+    SDL_RenderReadPixels(
+        renderer->sdl_renderer, NULL,
+        SDL_PIXELFORMAT_RGB24,
+        renderer->readback_surface->pixels,
+        renderer->readback_surface->pitch
+    );
+    TRACE_END(readback_zone);
+    
+    return renderer->readback_surface;
+}
+
 // Load textures
 void renderer_load_textures(Renderer* renderer) {
     // TODO: Load actual textures from files
@@ -206,6 +283,31 @@ void renderer_set_camera(Renderer* renderer, float x, float y, float zoom) {
     renderer->camera_zoom = zoom;
 }
 
+// Set the animation clock (simulation time, not wall time)
+void renderer_set_time(Renderer* renderer, float time) {
+    renderer->time = time;
+}
+
+// Set the area HUD overlays are laid out in (NULL = the whole screen)
+void renderer_set_hud_area(Renderer* renderer, const SDL_Rect* area) {
+    if (area) {
+        renderer->hud_area = *area;
+    } else {
+        SDL_Rect screen = {0, 0, renderer->screen_width, renderer->screen_height};
+        renderer->hud_area = screen;
+    }
+}
+
+// Clear per-run state (particles, clock) so the renderer can be reused
+void renderer_reset(Renderer* renderer, unsigned int seed) {
+    for (int i = 0; i < MAX_PARTICLES; i++) {
+        renderer->particles[i].active = false;
+    }
+    renderer->next_particle = 0;
+    renderer->rng_state = seed;
+    renderer->time = 0.0f;
+}
+
 // Convert world coordinates to screen coordinates
 static void world_to_screen(Renderer* renderer, float wx, float wy, int* sx, int* sy) {
     float zoom = renderer->camera_zoom;
@@ -292,6 +394,12 @@ void renderer_draw_maze(Renderer* renderer, Maze* maze) {
             if (texture) {
                 SDL_RenderCopy(renderer->sdl_renderer, texture, NULL, &cell_rect);
             }
+            
+            // Mark mud, ice and conveyor floors
+            TerrainType terrain = maze_get_terrain(maze, x, y);
+            if (terrain != TERRAIN_NORMAL && !maze_is_wall(maze, x, y)) {
+                renderer_draw_terrain(renderer, &cell_rect, terrain);
+            }
         }
     }
     
@@ -303,7 +411,7 @@ void renderer_draw_maze(Renderer* renderer, Maze* maze) {
         &exit_screen_x, &exit_screen_y);
     
     // Pulse effect for exit
-    int pulse_size = (int)(sin(SDL_GetTicks() / 300.0f) * 5 + 20) * zoom;
+    int pulse_size = (int)(sin(renderer->time / 0.3f) * 5 + 20) * zoom;
     
     SDL_SetRenderDrawColor(renderer->sdl_renderer, 0, 255, 0, 100);
     for (int i = 0; i < 3; i++) {
@@ -317,6 +425,37 @@ void renderer_draw_maze(Renderer* renderer, Maze* maze) {
     }
 }
 
+// Cover the cells no racer has seen yet. The overlay texture is only
+// re-uploaded for tiles the fog reports as changed, then stretched over the
+// visible part of the maze in one copy.
+void renderer_draw_fog(Renderer* renderer, MazeFog* fog) {
+    if (!renderer_sync_fog(renderer, fog)) return;
+    
+    Maze* maze = fog->maze;
+    int cell_size = maze->cell_size;
+    float zoom = renderer->camera_zoom;
+    
+    int min_x = (int)((renderer->camera_x - renderer->screen_width / (2 * zoom)) / cell_size) - 1;
+    int min_y = (int)((renderer->camera_y - renderer->screen_height / (2 * zoom)) / cell_size) - 1;
+    int max_x = (int)((renderer->camera_x + renderer->screen_width / (2 * zoom)) / cell_size) + 1;
+    int max_y = (int)((renderer->camera_y + renderer->screen_height / (2 * zoom)) / cell_size) + 1;
+    
+    // Clamp to maze bounds
+    if (min_x < 0) min_x = 0;
+    if (min_y < 0) min_y = 0;
+    if (max_x >= maze->width) max_x = maze->width - 1;
+    if (max_y >= maze->height) max_y = maze->height - 1;
+    if (min_x > max_x || min_y > max_y) return;
+    
+    SDL_Rect source_rect = {min_x, min_y, max_x - min_x + 1, max_y - min_y + 1};
+    SDL_Rect dest_rect;
+    world_to_screen(renderer, min_x * cell_size, min_y * cell_size, &dest_rect.x, &dest_rect.y);
+    dest_rect.w = (int)(source_rect.w * cell_size * zoom) + 1;
+    dest_rect.h = (int)(source_rect.h * cell_size * zoom) + 1;
+    
+    SDL_RenderCopy(renderer->sdl_renderer, renderer->fog_texture, &source_rect, &dest_rect);
+}
+
 // Draw a character
 void renderer_draw_character(Renderer* renderer, Character* character) {
     // Skip if character has escaped
@@ -401,7 +540,7 @@ void renderer_draw_debug_info(Renderer* renderer, int fps, int character_count)
     
     // This would use renderer_draw_text in a full implementation
     // For now, just draw a debug box
-    SDL_Rect debug_rect = {10, 10, 300, 20};
+    SDL_Rect debug_rect = {renderer->hud_area.x + 10, renderer->hud_area.y + 10, 300, 20};
     SDL_SetRenderDrawColor(renderer->sdl_renderer, 0, 0, 0, 128);
     SDL_RenderFillRect(renderer->sdl_renderer, &debug_rect);
 }
@@ -419,8 +558,8 @@ void renderer_draw_text(Renderer* renderer, const char* text, int x, int y, Colo
 void renderer_add_particle_effect(Renderer* renderer, ParticleType type, float x, float y, int count) {
     for (int i = 0; i < count; i++) {
         // Find an inactive particle
-        Particle* p = &particles[next_particle];
-        next_particle = (next_particle + 1) % MAX_PARTICLES;
+        Particle* p = &renderer->particles[renderer->next_particle];
+        renderer->next_particle = (renderer->next_particle + 1) % MAX_PARTICLES;
         
         // Reuse this particle slot
         p->active = true;
@@ -431,30 +570,30 @@ void renderer_add_particle_effect(Renderer* renderer, ParticleType type, float x
         // Set properties based on type
         switch (type) {
             case PARTICLE_DUST:
-                p->vx = ((rand() % 100) - 50) / 50.0f * 30.0f;
-                p->vy = ((rand() % 100) - 50) / 50.0f * 30.0f;
-                p->lifetime = p->max_lifetime = 0.5f + (rand() % 100) / 100.0f * 0.5f;
-                p->size = 3.0f + (rand() % 100) / 100.0f * 3.0f;
+                p->vx = ((renderer_random(renderer) % 100) - 50) / 50.0f * 30.0f;
+                p->vy = ((renderer_random(renderer) % 100) - 50) / 50.0f * 30.0f;
+                p->lifetime = p->max_lifetime = 0.5f + (renderer_random(renderer) % 100) / 100.0f * 0.5f;
+                p->size = 3.0f + (renderer_random(renderer) % 100) / 100.0f * 3.0f;
                 p->color = COLOR_WHITE;
                 p->color.a = 128;
                 break;
                 
             case PARTICLE_SPARK:
-                p->vx = ((rand() % 100) - 50) / 50.0f * 80.0f;
-                p->vy = ((rand() % 100) - 50) / 50.0f * 80.0f;
-                p->lifetime = p->max_lifetime = 0.3f + (rand() % 100) / 100.0f * 0.2f;
-                p->size = 2.0f + (rand() % 100) / 100.0f * 2.0f;
+                p->vx = ((renderer_random(renderer) % 100) - 50) / 50.0f * 80.0f;
+                p->vy = ((renderer_random(renderer) % 100) - 50) / 50.0f * 80.0f;
+                p->lifetime = p->max_lifetime = 0.3f + (renderer_random(renderer) % 100) / 100.0f * 0.2f;
+                p->size = 2.0f + (renderer_random(renderer) % 100) / 100.0f * 2.0f;
                 p->color = COLOR_YELLOW;
                 break;
                 
             case PARTICLE_CELEBRATION:
-                p->vx = ((rand() % 100) - 50) / 50.0f * 50.0f;
-                p->vy = ((rand() % 100) - 60) / 50.0f * 80.0f; // More upward bias
-                p->lifetime = p->max_lifetime = 1.0f + (rand() % 100) / 100.0f * 2.0f;
-                p->size = 5.0f + (rand() % 100) / 100.0f * 5.0f;
+                p->vx = ((renderer_random(renderer) % 100) - 50) / 50.0f * 50.0f;
+                p->vy = ((renderer_random(renderer) % 100) - 60) / 50.0f * 80.0f; // More upward bias
+                p->lifetime = p->max_lifetime = 1.0f + (renderer_random(renderer) % 100) / 100.0f * 2.0f;
+                p->size = 5.0f + (renderer_random(renderer) % 100) / 100.0f * 5.0f;
                 
                 // Random festive color
-                switch (rand() % 6) {
+                switch (renderer_random(renderer) % 6) {
                     case 0: p->color = COLOR_RED; break;
                     case 1: p->color = COLOR_GREEN; break;
                     case 2: p->color = COLOR_BLUE; break;
@@ -465,35 +604,71 @@ void renderer_add_particle_effect(Renderer* renderer, ParticleType type, float x
                 break;
                 
             case PARTICLE_TELEPORT:
-                p->vx = ((rand() % 100) - 50) / 50.0f * 30.0f;
-                p->vy = ((rand() % 100) - 50) / 50.0f * 30.0f;
-                p->lifetime = p->max_lifetime = 0.3f + (rand() % 100) / 100.0f * 0.2f;
-                p->size = 4.0f + (rand() % 100) / 100.0f * 4.0f;
+                p->vx = ((renderer_random(renderer) % 100) - 50) / 50.0f * 30.0f;
+                p->vy = ((renderer_random(renderer) % 100) - 50) / 50.0f * 30.0f;
+                p->lifetime = p->max_lifetime = 0.3f + (renderer_random(renderer) % 100) / 100.0f * 0.2f;
+                p->size = 4.0f + (renderer_random(renderer) % 100) / 100.0f * 4.0f;
                 p->color = COLOR_MAGENTA;
                 break;
         }
     }
 }
 
+// Spawn particles for the effects reported by the last simulation step
+void renderer_add_simulation_effects(Renderer* renderer, Simulation* sim) {
+    for (int i = 0; i < sim->event_count; i++) {
+        SimulationEvent* event = &sim->events[i];
+        if (event->type != SIM_EVENT_EFFECT) continue;
+        
+        ParticleType type = PARTICLE_DUST;
+        switch ((SimulationEffect)event->kind) {
+            case SIM_EFFECT_DUST:        type = PARTICLE_DUST; break;
+            case SIM_EFFECT_SPARK:       type = PARTICLE_SPARK; break;
+            case SIM_EFFECT_CELEBRATION: type = PARTICLE_CELEBRATION; break;
+            case SIM_EFFECT_TELEPORT:    type = PARTICLE_TELEPORT; break;
+        }
+        
+        renderer_add_particle_effect(renderer, type, event->x, event->y, event->count);
+    }
+}
+
+// Advance animations by one frame: clock, celebration spawns and particles.
+// Drawing has no side effects, so frames can be skipped without changing later ones.
+void renderer_update_animations(Renderer* renderer, Simulation* sim, float dt) {
+    renderer_set_time(renderer, sim->time);
+    
+    // Generate celebration particles around the winner
+    if (sim->winner && fmodf(renderer->time, 0.1f) < 0.02f) {
+        float x = sim->winner->x + ((renderer_random(renderer) % 100) - 50) / 50.0f * 30.0f;
+        float y = sim->winner->y + ((renderer_random(renderer) % 100) - 50) / 50.0f * 30.0f;
+        renderer_add_particle_effect(renderer, PARTICLE_CELEBRATION, x, y, 10);
+    }
+    
+    TRACE_BEGIN(particles_zone, "particles.update");
+    renderer_update_particles(renderer, dt);
+    TRACE_END(particles_zone);
+}
+
 // Update particles
 void renderer_update_particles(Renderer* renderer, float dt) {
     for (int i = 0; i < MAX_PARTICLES; i++) {
-        if (!particles[i].active) continue;
+        Particle* p = &renderer->particles[i];
+        if (!p->active) continue;
         
         // Update lifetime
-        particles[i].lifetime -= dt;
-        if (particles[i].lifetime <= 0) {
-            particles[i].active = false;
+        p->lifetime -= dt;
+        if (p->lifetime <= 0) {
+            p->active = false;
             continue;
         }
         
         // Update position
-        particles[i].x += particles[i].vx * dt;
-        particles[i].y += particles[i].vy * dt;
+        p->x += p->vx * dt;
+        p->y += p->vy * dt;
         
         // Apply gravity for some particles
-        if (particles[i].type == PARTICLE_CELEBRATION) {
-            particles[i].vy += 50.0f * dt;
+        if (p->type == PARTICLE_CELEBRATION) {
+            p->vy += 50.0f * dt;
         }
     }
 }
@@ -501,26 +676,27 @@ void renderer_update_particles(Renderer* renderer, float dt) {
 // Draw particles
 void renderer_draw_particles(Renderer* renderer) {
     for (int i = 0; i < MAX_PARTICLES; i++) {
-        if (!particles[i].active) continue;
+        Particle* p = &renderer->particles[i];
+        if (!p->active) continue;
         
         // Convert world position to screen position
         int screen_x, screen_y;
-        world_to_screen(renderer, particles[i].x, particles[i].y, &screen_x, &screen_y);
+        world_to_screen(renderer, p->x, p->y, &screen_x, &screen_y);
         
         // Calculate alpha based on lifetime
-        float alpha_factor = particles[i].lifetime / particles[i].max_lifetime;
-        Uint8 alpha = (Uint8)(particles[i].color.a * alpha_factor);
+        float alpha_factor = p->lifetime / p->max_lifetime;
+        Uint8 alpha = (Uint8)(p->color.a * alpha_factor);
         
         // Calculate size based on lifetime and zoom
         float size_factor = 0.5f + 0.5f * alpha_factor;
-        int size = (int)(particles[i].size * size_factor * renderer->camera_zoom);
+        int size = (int)(p->size * size_factor * renderer->camera_zoom);
         
         // Set color
         SDL_SetRenderDrawColor(
             renderer->sdl_renderer,
-            particles[i].color.r,
-            particles[i].color.g,
-            particles[i].color.b,
+            p->color.r,
+            p->color.g,
+            p->color.b,
             alpha
         );
         
@@ -536,19 +712,13 @@ void renderer_draw_particles(Renderer* renderer) {
 
 // Draw celebration effect
 void renderer_draw_celebration(Renderer* renderer, Character* winner) {
-    // Generate celebration particles
-    if ((SDL_GetTicks() % 100) < 20) {
-        float x = winner->x + ((rand() % 100) - 50) / 50.0f * 30.0f;
-        float y = winner->y + ((rand() % 100) - 50) / 50.0f * 30.0f;
-        renderer_add_particle_effect(renderer, PARTICLE_CELEBRATION, x, y, 10);
-    }
-    
     // Draw winner banner
+    const SDL_Rect* hud = &renderer->hud_area;
     SDL_Rect banner_rect = {
-        renderer->screen_width / 4,
-        renderer->screen_height / 4,
-        renderer->screen_width / 2,
-        renderer->screen_height / 8
+        hud->x + hud->w / 4,
+        hud->y + hud->h / 4,
+        hud->w / 2,
+        hud->h / 8
     };
     
     SDL_SetRenderDrawColor(renderer->sdl_renderer, 0, 0, 0, 200);
@@ -570,9 +740,182 @@ void renderer_draw_celebration(Renderer* renderer, Character* winner) {
     renderer_draw_text(
         renderer,
         buffer,
-        renderer->screen_width / 2 - strlen(buffer) * 8 / 2,
-        renderer->screen_height / 4 + 20,
+        hud->x + hud->w / 2 - strlen(buffer) * 8 / 2,
+        hud->y + hud->h / 4 + 20,
         COLOR_WHITE,
         2.0f
     );
 }
+
+// Draw a full frame of a race: maze, racers, particles and overlays
+void renderer_draw_simulation(Renderer* renderer, Simulation* sim, float zoom, int fps) {
+    // Clear screen
+    Color bg_color = {30, 30, 50, 255}; // Dark blue-ish background
+    renderer_clear(renderer, bg_color);
+    
+    // Set camera to follow characters (average position)
+    float avg_x = 0, avg_y = 0;
+    int active_chars = 0;
+    
+    for (int i = 0; i < sim->character_count; i++) {
+        if (!sim->characters[i]->has_escaped) {
+            avg_x += sim->characters[i]->x;
+            avg_y += sim->characters[i]->y;
+            active_chars++;
+        }
+    }
+    
+    if (active_chars > 0) {
+        avg_x /= active_chars;
+        avg_y /= active_chars;
+        renderer_set_camera(renderer, avg_x, avg_y, zoom);
+    }
+    
+    // Draw maze
+    TRACE_BEGIN(maze_zone, "draw.maze");
+    renderer_draw_maze(renderer, sim->maze);
+    TRACE_END(maze_zone);
+    
+    // Hide what the racers have not seen yet
+    if (sim->fog) {
+        TRACE_BEGIN(fog_zone, "draw.fog");
+        renderer_draw_fog(renderer, sim->fog);
+        TRACE_END(fog_zone);
+    }
+    
+    // Draw characters
+    TRACE_BEGIN(characters_zone, "draw.characters");
+    for (int i = 0; i < sim->character_count; i++) {
+        renderer_draw_character(renderer, sim->characters[i]);
+    }
+    TRACE_END(characters_zone);
+    
+    // Draw particles
+    TRACE_BEGIN(particles_zone, "draw.particles");
+    renderer_draw_particles(renderer);
+    TRACE_END(particles_zone);
+    
+    // Draw debug info if enabled
+    if (renderer->show_debug) {
+        renderer_draw_debug_info(renderer, fps, sim->character_count);
+    }
+    
+    // Draw celebration if there's a winner
+    if (sim->winner) {
+        renderer_draw_celebration(renderer, sim->winner);
+    }
+}
+
+// Helper: Set up state shared by windowed and headless renderers
+static bool renderer_init_common(Renderer* renderer, int width, int height) {
+    // Initialize renderer properties
+    renderer->screen_width = width;
+    renderer->screen_height = height;
+    renderer->camera_x = 0;
+    renderer->camera_y = 0;
+    renderer->camera_zoom = 1.0f;
+    renderer->time = 0.0f;
+    renderer->show_debug = false;
+    renderer_set_hud_area(renderer, NULL);
+    
+    // Initialize textures to NULL
+    for (int i = 0; i < TEXTURE_COUNT; i++) {
+        renderer->textures[i] = NULL;
+    }
+    renderer->readback_surface = NULL;
+    renderer->fog_texture = NULL;
+    renderer->fog_width = 0;
+    renderer->fog_height = 0;
+    
+    // Initialize particles
+    renderer->particles = (Particle*)malloc(MAX_PARTICLES * sizeof(Particle));
+    if (!renderer->particles) return false;
+    renderer_reset(renderer, 1);
+    
+    return true;
+}
+
+// Helper: Next value from the renderer's particle random stream
+static int renderer_random(Renderer* renderer) {
+    renderer->rng_state = (renderer->rng_state * 1103515245 + 12345) & 0x7fffffff;
+    return (int)(renderer->rng_state >> 8);
+}
+
+// Helper: Bring the fog overlay up to date, (re)creating it when the maze
+// size changes, and upload only the dirty tiles
+static bool renderer_sync_fog(Renderer* renderer, MazeFog* fog) {
+    Maze* maze = fog->maze;
+    
+    if (!renderer->fog_texture || renderer->fog_width != maze->width || renderer->fog_height != maze->height) {
+        if (renderer->fog_texture) {
+            SDL_DestroyTexture(renderer->fog_texture);
+        }
+        renderer->fog_texture = SDL_CreateTexture(renderer->sdl_renderer, SDL_PIXELFORMAT_RGBA8888,
+            SDL_TEXTUREACCESS_STREAMING, maze->width, maze->height);
+        if (!renderer->fog_texture) {
+            fprintf(stderr, "Error creating fog texture: %s\n", SDL_GetError());
+            renderer->fog_width = 0;
+            renderer->fog_height = 0;
+            return false;
+        }
+        SDL_SetTextureBlendMode(renderer->fog_texture, SDL_BLENDMODE_BLEND);
+        renderer->fog_width = maze->width;
+        renderer->fog_height = maze->height;
+        fog_mark_all_dirty(fog);
+    }
+    
+    // Texels are row-major (y, x) while the maze is column-major (x, y)
+    Uint32 texels[FOG_TILE_SIZE * FOG_TILE_SIZE];
+    for (int i = 0; i < fog->dirty_count; i++) {
+        int tile = fog->dirty_tiles[i];
+        SDL_Rect rect;
+        rect.x = (tile % fog->tiles_x) * FOG_TILE_SIZE;
+        rect.y = (tile / fog->tiles_x) * FOG_TILE_SIZE;
+        rect.w = maze->width - rect.x < FOG_TILE_SIZE ? maze->width - rect.x : FOG_TILE_SIZE;
+        rect.h = maze->height - rect.y < FOG_TILE_SIZE ? maze->height - rect.y : FOG_TILE_SIZE;
+        
+        for (int y = 0; y < rect.h; y++) {
+            for (int x = 0; x < rect.w; x++) {
+                texels[y * rect.w + x] = fog_is_revealed(fog, rect.x + x, rect.y + y)
+                    ? FOG_REVEALED_TEXEL : FOG_HIDDEN_TEXEL;
+            }
+        }
+        SDL_UpdateTexture(renderer->fog_texture, &rect, texels, rect.w * (int)sizeof(Uint32));
+    }
+    fog_clear_dirty(fog);
+    
+    return true;
+}
+
+// Helper: Draw a terrain marker inside a floor cell: a patch for mud and
+// ice, a stripe along the leading edge for a conveyor belt
+static void renderer_draw_terrain(Renderer* renderer, const SDL_Rect* cell_rect, TerrainType terrain) {
+    const TerrainInfo* info = maze_terrain_info(terrain);
+    SDL_Rect mark = *cell_rect;
+    
+    if (terrain == TERRAIN_MUD) {
+        SDL_SetRenderDrawColor(renderer->sdl_renderer, 110, 75, 40, 255);
+    } else if (terrain == TERRAIN_ICE) {
+        SDL_SetRenderDrawColor(renderer->sdl_renderer, 175, 225, 255, 255);
+    } else {
+        SDL_SetRenderDrawColor(renderer->sdl_renderer, 90, 90, 100, 255);
+    }
+    
+    if (info->push_x || info->push_y) {
+        // Stripe on the side the belt pushes toward
+        if (info->push_x) {
+            mark.w = cell_rect->w / 4;
+            mark.x += info->push_x > 0 ? cell_rect->w - mark.w : 0;
+        } else {
+            mark.h = cell_rect->h / 4;
+            mark.y += info->push_y > 0 ? cell_rect->h - mark.h : 0;
+        }
+    } else {
+        mark.x += cell_rect->w / 8;
+        mark.y += cell_rect->h / 8;
+        mark.w = cell_rect->w * 3 / 4;
+        mark.h = cell_rect->h * 3 / 4;
+    }
+    
+    SDL_RenderFillRect(renderer->sdl_renderer, &mark);
+}
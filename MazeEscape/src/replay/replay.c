@@ -0,0 +1,159 @@
+#include "replay/replay.h"
+#include "trace/trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Don't split recordings into slices shorter than this many frames
+#define MIN_FRAMES_PER_SLICE 120
+
+// One worker's share of the frame range
+typedef struct {
+    const char* trajectory_path;
+    const AppSettings* settings;
+    char output_filename[1024];
+    int first_frame;
+    int end_frame;
+    bool ok;
+} ReplaySlice;
+
+// Local function prototypes
+static int replay_slice_worker(void* data);
+
+// Count the frames in a trajectory (decodes it once without rendering)
+int replay_count_frames(const char* trajectory_path) {
+    TrajectoryReader* reader = trajectory_reader_open(trajectory_path);
+    if (!reader) return -1;
+    
+    int frames = 0;
+    while (trajectory_read_frame(reader)) {
+        frames++;
+    }
+    
+    trajectory_reader_close(reader);
+    return frames;
+}
+
+// Render frames [first_frame, end_frame) of a trajectory to a video file.
+// Earlier frames are decoded and animated but not drawn, so every output frame
+// is identical to the same frame of a full render.
+bool replay_render_range(const char* trajectory_path, const char* output_filename,
+                         const AppSettings* settings, int first_frame, int end_frame) {
+    TrajectoryReader* reader = trajectory_reader_open(trajectory_path);
+    if (!reader) return false;
+    
+    Simulation* replay = trajectory_reader_simulation(reader);
+    int fps = trajectory_reader_fps(reader);
+    
+    Renderer* renderer = renderer_create_headless(settings->video_width, settings->video_height);
+    VideoEncoder* encoder = encoder_create(
+        output_filename,
+        settings->video_width,
+        settings->video_height,
+        fps,
+        5000000 // 5 Mbps bitrate
+    );
+    
+    bool ok = renderer && encoder && encoder_start(encoder);
+    if (ok) {
+        renderer_load_textures(renderer);
+        renderer_reset(renderer, replay->config.random_seed);
+        renderer->show_debug = settings->debug_mode;
+        
+        // Same per-frame order as the live loop, so particles match across re-renders
+        for (int frame = 0; frame < end_frame && trajectory_read_frame(reader); frame++) {
+            renderer_add_simulation_effects(renderer, replay);
+            renderer_update_animations(renderer, replay, trajectory_reader_frame_dt(reader));
+            
+            if (frame >= first_frame) {
+                TRACE_BEGIN(frame_zone, "frame");
+                renderer_draw_simulation(renderer, replay, settings->zoom_level, fps);
+                encoder_encode_frame(encoder, renderer->target_surface);
+                TRACE_END(frame_zone);
+            }
+        }
+        
+        encoder_stop(encoder);
+    }
+    
+    encoder_destroy(encoder);
+    renderer_destroy(renderer);
+    trajectory_reader_close(reader);
+    return ok;
+}
+
+// Render a whole trajectory, splitting the frame range across worker threads
+// and concatenating the slices when there is enough work to share
+bool replay_render(const char* trajectory_path, const char* output_filename,
+                   const AppSettings* settings, int worker_count) {
+    int frame_count = replay_count_frames(trajectory_path);
+    if (frame_count < 0) return false;
+    
+    if (worker_count > frame_count / MIN_FRAMES_PER_SLICE) {
+        worker_count = frame_count / MIN_FRAMES_PER_SLICE;
+    }
+    
+    if (worker_count <= 1) {
+        return replay_render_range(trajectory_path, output_filename, settings, 0, frame_count);
+    }
+    
+    printf("Rendering %d frames in %d slices\n", frame_count, worker_count);
+    
+    ReplaySlice* slices = (ReplaySlice*)calloc(worker_count, sizeof(ReplaySlice));
+    SDL_Thread** threads = (SDL_Thread**)calloc(worker_count, sizeof(SDL_Thread*));
+    const char** part_names = (const char**)calloc(worker_count, sizeof(const char*));
+    
+    bool ok = slices && threads && part_names;
+    
+    for (int i = 0; ok && i < worker_count; i++) {
+        ReplaySlice* slice = &slices[i];
+        slice->trajectory_path = trajectory_path;
+        slice->settings = settings;
+        slice->first_frame = (int)((long long)frame_count * i / worker_count);
+        slice->end_frame = (int)((long long)frame_count * (i + 1) / worker_count);
+        snprintf(slice->output_filename, sizeof(slice->output_filename),
+            "%s.part%02d.mp4", output_filename, i);
+        part_names[i] = slice->output_filename;
+        
+        threads[i] = SDL_CreateThread(replay_slice_worker, "replay_slice", slice);
+        if (!threads[i]) {
+            // Render this slice on the calling thread instead
+            replay_slice_worker(slice);
+        }
+    }
+    
+    // Join every started slice before touching their files or state
+    for (int i = 0; threads && i < worker_count; i++) {
+        if (threads[i]) {
+            SDL_WaitThread(threads[i], NULL);
+        }
+    }
+    for (int i = 0; ok && i < worker_count; i++) {
+        ok = slices[i].ok;
+    }
+    
+    if (ok) {
+        ok = encoder_concat_files(part_names, worker_count, output_filename);
+    }
+    
+    // Slices are temporary either way
+    for (int i = 0; slices && i < worker_count; i++) {
+        if (slices[i].output_filename[0]) {
+            remove(slices[i].output_filename);
+        }
+    }
+    
+    free(part_names);
+    free(threads);
+    free(slices);
+    return ok;
+}
+
+// Helper: Worker thread - render one slice
+static int replay_slice_worker(void* data) {
+    ReplaySlice* slice = (ReplaySlice*)data;
+    trace_set_thread_name("replay_slice");
+    slice->ok = replay_render_range(slice->trajectory_path, slice->output_filename,
+                                    slice->settings, slice->first_frame, slice->end_frame);
+    return slice->ok ? 0 : 1;
+}
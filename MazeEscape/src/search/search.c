@@ -0,0 +1,257 @@
+#include "search/search.h"
+#include "memory/pool.h"
+#include "maze/stats.h"
+#include "maze/generators.h"
+#include <SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Weights of the excitement score
+#define SCORE_LEAD_CHANGE      3.0f   // Per change of leader
+#define SCORE_ABILITY_USE      0.5f   // Per ability activation (all racers)
+#define SCORE_CLOSE_FINISH    10.0f   // Scaled by 1 / (1 + margin seconds)
+#define SCORE_NO_WINNER      -20.0f   // Nobody escaped before the timeout
+#define SCORE_IDEAL_DURATION  0.6f    // Fraction of the time limit a good race lasts
+
+// Arena block size of a search worker (large enough for big mazes in one block)
+#define SEARCH_ARENA_BLOCK_SIZE (256 * 1024)
+
+// Shared work queue for the search workers
+typedef struct {
+    const SimulationConfig* base_config;
+    const SearchFilter* filter;
+    int seed_count;
+    float fps;
+    SearchResult* results;
+    SDL_atomic_t next_seed;
+} SearchQueue;
+
+// Local function prototypes
+static int search_worker(void* data);
+static float search_compute_score(const SearchResult* result, int time_limit);
+static int compare_results(const void* a, const void* b);
+
+// Check a seed's maze layout against the filter without simulating it.
+// Only the maze is generated (in the arena, which is reset before returning),
+// so rejecting a seed costs a fraction of a race.
+bool search_filter_seed(const SimulationConfig* config, const SearchFilter* filter, Arena* arena) {
+    if (!filter) return true;
+    if (filter->min_solution_length <= 0 && filter->min_useful_breakables <= 0 && filter->max_spawn_spread < 0) {
+        return true;
+    }
+    
+    Maze* maze = maze_create_in_arena(arena, config->maze_width, config->maze_height, config->cell_size);
+    if (!maze) return true; // Let the race itself report the failure
+    maze_generate_with(maze, config->random_seed, config->maze_algorithm);
+    maze_braid(maze, config->braid_fraction, config->random_seed);
+    
+    MazeStats stats;
+    maze_compute_stats(maze, &stats);
+    
+    bool accepted = true;
+    if (stats.solution_length == MAZE_UNREACHABLE || stats.solution_length < filter->min_solution_length) {
+        accepted = false;
+    }
+    if (stats.useful_breakables < filter->min_useful_breakables) {
+        accepted = false;
+    }
+    if (filter->max_spawn_spread >= 0) {
+        int nearest = stats.spawn_distance[0];
+        int farthest = stats.spawn_distance[0];
+        for (int i = 1; i < MAZE_STATS_SPAWNS; i++) {
+            if (stats.spawn_distance[i] < nearest) nearest = stats.spawn_distance[i];
+            if (stats.spawn_distance[i] > farthest) farthest = stats.spawn_distance[i];
+        }
+        if (nearest == MAZE_UNREACHABLE || farthest - nearest > filter->max_spawn_spread) {
+            accepted = false;
+        }
+    }
+    
+    if (arena) {
+        arena_reset(arena);
+    } else {
+        maze_destroy(maze);
+    }
+    return accepted;
+}
+
+// Simulate one seed headless (no renderer, no encoder) and score the race.
+// With an arena the race is built in it; the arena is reset before returning.
+bool search_score_seed(const SimulationConfig* config, float fps, Arena* arena, SearchResult* result) {
+    Simulation* sim = simulation_create_in_arena(config, arena);
+    if (!sim) return false;
+    sim->verbose = false;
+    
+    // Keep going after the winner until the runner-up escapes to measure the
+    // margin, unless early stopping ends a decided race at the winner's escape
+    int finishers_needed = sim->character_count < 2 ? sim->character_count : 2;
+    float frame_dt = 1.0f / fps;
+    
+    while (sim->time < config->simulation_duration && sim->escaped_count < finishers_needed) {
+        if (config->stop_when_decided && sim->decided_time >= 0.0f && sim->winner) break;
+        simulation_step(sim, frame_dt);
+    }
+    
+    result->seed = config->random_seed;
+    result->lead_changes = sim->lead_changes;
+    result->margin_estimated = sim->winner && sim->escaped_count < finishers_needed &&
+                               sim->time < config->simulation_duration;
+    result->ability_uses = 0;
+    for (int i = 0; i < sim->character_count; i++) {
+        result->ability_uses += sim->characters[i]->ability_uses;
+    }
+    
+    // The winner and duration are always real; a runner-up still in the maze
+    // is taken at its predicted finish
+    result->has_winner = sim->winner != NULL;
+    result->duration = sim->winner ? sim->winner->escape_time : sim->time;
+    float runner_up_time = (float)config->simulation_duration;
+    for (int i = 0; i < sim->character_count; i++) {
+        Character* character = sim->characters[i];
+        if (character == sim->winner) continue;
+        float finish = character->has_escaped ? character->escape_time :
+                       result->margin_estimated ? sim->predicted_finish[i] : -1.0f;
+        if (finish >= 0.0f && finish < runner_up_time) runner_up_time = finish;
+    }
+    result->finish_margin = result->has_winner ? runner_up_time - result->duration : 0.0f;
+    result->score = search_compute_score(result, config->simulation_duration);
+    
+    simulation_destroy(sim);
+    if (arena) {
+        arena_reset(arena);
+    }
+    return true;
+}
+
+// Score seed_count consecutive seeds starting at base_config->random_seed, best first.
+// Seeds rejected by the filter (NULL = none) are sorted behind result_count.
+SearchResult* search_run(const SimulationConfig* base_config, const SearchFilter* filter, int seed_count,
+                         float fps, int worker_count, int* result_count) {
+    *result_count = 0;
+    if (seed_count < 1) return NULL;
+    if (worker_count < 1) worker_count = 1;
+    if (worker_count > seed_count) worker_count = seed_count;
+    
+    SearchQueue queue;
+    queue.base_config = base_config;
+    queue.filter = filter;
+    queue.seed_count = seed_count;
+    queue.fps = fps;
+    queue.results = (SearchResult*)calloc(seed_count, sizeof(SearchResult));
+    SDL_AtomicSet(&queue.next_seed, 0);
+    
+    if (!queue.results) return NULL;
+    
+    SDL_Thread** threads = (SDL_Thread**)malloc(worker_count * sizeof(SDL_Thread*));
+    if (!threads) {
+        free(queue.results);
+        return NULL;
+    }
+    
+    int started = 0;
+    for (int i = 0; i < worker_count; i++) {
+        threads[i] = SDL_CreateThread(search_worker, "search_worker", &queue);
+        if (threads[i]) started++;
+    }
+    
+    // Fall back to searching on this thread if no worker could start
+    if (started == 0) {
+        search_worker(&queue);
+    }
+    
+    for (int i = 0; i < worker_count; i++) {
+        if (threads[i]) {
+            SDL_WaitThread(threads[i], NULL);
+        }
+    }
+    free(threads);
+    
+    qsort(queue.results, seed_count, sizeof(SearchResult), compare_results);
+    
+    int skipped = 0;
+    for (int i = 0; i < seed_count; i++) {
+        if (queue.results[i].filtered) skipped++;
+    }
+    if (skipped > 0) {
+        printf("Skipped %d of %d seeds by maze layout\n", skipped, seed_count);
+    }
+    
+    *result_count = seed_count - skipped;
+    return queue.results;
+}
+
+// Print the best races as a table
+void search_print_top(const SearchResult* results, int result_count, int top_count) {
+    if (top_count > result_count) top_count = result_count;
+    
+    printf("%4s %12s %8s %6s %8s %8s %9s\n",
+        "rank", "seed", "score", "leads", "margin", "ability", "duration");
+    
+    for (int i = 0; i < top_count; i++) {
+        const SearchResult* r = &results[i];
+        printf("%4d %12u %8.2f %6d %7.2fs %8d %8.2fs%s%s\n",
+            i + 1, r->seed, r->score, r->lead_changes, r->finish_margin,
+            r->ability_uses, r->duration, r->has_winner ? "" : " (no winner)",
+            r->margin_estimated ? " (margin estimated)" : "");
+    }
+}
+
+// Helper: Worker thread - simulate seeds until all are taken
+static int search_worker(void* data) {
+    SearchQueue* queue = (SearchQueue*)data;
+    
+    // Every race on this worker reuses the same arena blocks and physics pool
+    Arena* arena = arena_create(SEARCH_ARENA_BLOCK_SIZE);
+    
+    for (;;) {
+        int index = SDL_AtomicAdd(&queue->next_seed, 1);
+        if (index >= queue->seed_count) break;
+        
+        SimulationConfig config = *queue->base_config;
+        config.random_seed = queue->base_config->random_seed + (unsigned int)index;
+        
+        SearchResult* result = &queue->results[index];
+        if (!search_filter_seed(&config, queue->filter, arena)) {
+            result->seed = config.random_seed;
+            result->filtered = true;
+            continue;
+        }
+        if (!search_score_seed(&config, queue->fps, arena, result)) {
+            result->seed = config.random_seed;
+            result->score = SCORE_NO_WINNER * 10.0f;
+        }
+    }
+    
+    arena_destroy(arena);
+    pool_release_thread();
+    return 0;
+}
+
+// Helper: Combine race statistics into a single excitement score
+static float search_compute_score(const SearchResult* result, int time_limit) {
+    if (!result->has_winner) {
+        return SCORE_NO_WINNER + result->lead_changes * SCORE_LEAD_CHANGE;
+    }
+    
+    float score = result->lead_changes * SCORE_LEAD_CHANGE
+                + result->ability_uses * SCORE_ABILITY_USE
+                + SCORE_CLOSE_FINISH / (1.0f + result->finish_margin);
+    
+    // Prefer races that fill a good part of the video without timing out
+    float ideal = SCORE_IDEAL_DURATION * time_limit;
+    float off = (result->duration - ideal) / (ideal > 0 ? ideal : 1.0f);
+    score -= 5.0f * off * off;
+    
+    return score;
+}
+
+// Helper: qsort comparator, highest score first and filtered seeds last
+static int compare_results(const void* a, const void* b) {
+    bool filtered_a = ((const SearchResult*)a)->filtered;
+    bool filtered_b = ((const SearchResult*)b)->filtered;
+    if (filtered_a != filtered_b) return filtered_a - filtered_b;
+    
+    float score_a = ((const SearchResult*)a)->score;
+    float score_b = ((const SearchResult*)b)->score;
+    return (score_a < score_b) - (score_a > score_b);
+}
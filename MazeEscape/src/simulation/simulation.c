@@ -0,0 +1,672 @@
+#include "simulation/simulation.h"
+#include "maze/generators.h"
+#include "maze/dynamic.h"
+#include "maze/terrain.h"
+#include "physics/physics.h"
+#include "trace/trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <math.h>
+
+// Local function prototypes
+static Character* create_character_of_type(Arena* arena, const char* type, float x, float y);
+static void simulation_update_leader(Simulation* sim);
+static void simulation_push_effect(Simulation* sim, SimulationEffect effect, float x, float y, int count);
+static SimulationEffect ability_effect(CharacterType type);
+static void simulation_update_coop(Simulation* sim, float dt);
+static void simulation_update_fog(Simulation* sim, bool maze_changed);
+static bool simulation_cell_occupied(void* user_data, int x, int y);
+static void simulation_fire_trigger(Simulation* sim, Character* character);
+static void simulation_update_prediction(Simulation* sim);
+static float simulation_earliest_finish(Simulation* sim, Character* character, float fastest_floor);
+static float simulation_route_time(Simulation* sim, Character* character, float pace);
+
+// Speed pad boost
+#define TRIGGER_BOOST_MULTIPLIER 1.5f
+#define TRIGGER_BOOST_SECONDS 2.0f
+
+// Outcome prediction bounds: the leader is assumed to keep at least this
+// share of its top speed, and a challenger to gain this much on top of
+// every boost (belt drift, collision impulses) and to jump this many cells
+// (the teleport range) every ability cooldown
+#define PREDICT_LEADER_PACE 0.5f
+#define PREDICT_SPEED_MARGIN 1.25f
+#define PREDICT_JUMP_CELLS 3.0f
+
+// Size of the blocks of a race's arena (a 20x30 race fits in one)
+#define SIMULATION_ARENA_BLOCK_SIZE (64 * 1024)
+
+// Create a race: generate the maze, build the physics world and spawn racers
+Simulation* simulation_create(const SimulationConfig* config) {
+    return simulation_create_in_arena(config, NULL);
+}
+
+// Create a race whose maze, racers and buffers live in an arena. Callers that
+// run many races pass their own arena and arena_reset it after each
+// simulation_destroy; with NULL the race creates and frees a private arena.
+Simulation* simulation_create_in_arena(const SimulationConfig* config, Arena* arena) {
+    bool owns_arena = arena == NULL;
+    if (owns_arena) {
+        arena = arena_create(SIMULATION_ARENA_BLOCK_SIZE);
+        if (!arena) return NULL;
+    }
+    
+    Simulation* sim = (Simulation*)arena_alloc(arena, sizeof(Simulation));
+    if (!sim) {
+        if (owns_arena) arena_destroy(arena);
+        return NULL;
+    }
+    
+    sim->arena = arena;
+    sim->owns_arena = owns_arena;
+    sim->config = *config;
+    sim->winner = NULL;
+    sim->escaped_count = 0;
+    sim->leader_index = -1;
+    sim->lead_changes = 0;
+    sim->predicted_winner = -1;
+    sim->decided_time = -1.0f;
+    sim->time = 0.0f;
+    sim->running = true;
+    sim->verbose = true;
+    sim->character_count = 0;
+    sim->coop = NULL;
+    sim->coop_step_time = 0.0f;
+    sim->coop_elapsed = 0.0f;
+    sim->fog = NULL;
+    sim->triggers = NULL;
+    sim->triggers_fired = 0;
+    sim->events = NULL;
+    sim->event_count = 0;
+    sim->event_capacity = 0;
+    
+    // Create physics space
+    sim->physics_space = physics_create_space(0.0f, 100.0f); // Low gravity for interesting physics
+    
+    // Create and generate maze
+    sim->maze = maze_create_in_arena(arena, config->maze_width, config->maze_height, config->cell_size);
+    maze_generate_with(sim->maze, config->random_seed, config->maze_algorithm);
+    maze_braid(sim->maze, config->braid_fraction, config->random_seed);
+    sim->maze->physics_space = sim->physics_space;
+    
+    // Mud, ice and conveyor belts; racers route by the weighted cost field
+    if (config->terrain_fraction > 0.0f) {
+        MazeTerrain* terrain = maze_terrain_create(sim->maze);
+        if (terrain) {
+            maze_terrain_populate(terrain, config->random_seed, config->terrain_fraction);
+        }
+    }
+    
+    // Scheduled maze pieces, driven by maze_update; racers standing in a cell keep it open
+    if (config->dynamic_maze) {
+        sim->maze->dynamic = maze_dynamic_create(sim->maze);
+        if (sim->maze->dynamic) {
+            maze_dynamic_populate(sim->maze->dynamic, config->random_seed);
+            maze_dynamic_set_blocked(sim->maze->dynamic, simulation_cell_occupied, sim);
+        }
+    }
+    
+    // Add physics bodies for maze walls
+    maze_add_physics_bodies(sim->maze, sim->physics_space);
+    
+    // Index the special cells' power-ups by cell
+    sim->triggers = maze_triggers_create(sim->maze, config->random_seed);
+    
+    // Create characters based on specified types
+    sim->characters = (Character**)arena_alloc(arena, SIMULATION_MAX_CHARACTERS * sizeof(Character*));
+    
+    // Walk the comma-separated list without strtok so workers can run in parallel
+    const char* cursor = config->character_types;
+    while (*cursor && sim->character_count < SIMULATION_MAX_CHARACTERS) {
+        char token[32];
+        size_t length = strcspn(cursor, ",");
+        size_t copy_length = length < sizeof(token) - 1 ? length : sizeof(token) - 1;
+        memcpy(token, cursor, copy_length);
+        token[copy_length] = '\0';
+        cursor += length;
+        if (*cursor == ',') cursor++;
+        
+        int index = sim->character_count;
+        
+        // Get start position from maze
+        int start_x = sim->maze->start_positions[index * 2];
+        int start_y = sim->maze->start_positions[index * 2 + 1];
+        
+        // Convert grid coords to pixel coords
+        float pixel_x = (start_x + 0.5f) * config->cell_size;
+        float pixel_y = (start_y + 0.5f) * config->cell_size;
+        
+        Character* character = create_character_of_type(arena, token, pixel_x, pixel_y);
+        if (character) {
+            // Give every racer its own random stream so races replay exactly
+            character->rng_state = config->random_seed ^ (0x9E3779B9u * (unsigned int)(index + 1));
+            character_attach_physics(character, sim->physics_space);
+            sim->characters[sim->character_count++] = character;
+        } else if (length > 0) {
+            fprintf(stderr, "Unknown character type '%s' ignored\n", token);
+        }
+    }
+    
+    if (*cursor) {
+        fprintf(stderr, "Only %d characters supported, extra types ignored\n", SIMULATION_MAX_CHARACTERS);
+    }
+    
+    // Register collision handlers
+    physics_register_collision_handlers(sim->physics_space);
+    
+    // Cooperative planner: one planning step is one cell at the racers' mean speed
+    if (config->cooperative && sim->character_count > 0) {
+        float speed_sum = 0.0f;
+        for (int i = 0; i < sim->character_count; i++) {
+            speed_sum += sim->characters[i]->speed;
+        }
+        sim->coop = coop_create(sim->maze, sim->character_count, COOP_DEFAULT_WINDOW);
+        sim->coop_step_time = config->cell_size / (speed_sum / sim->character_count);
+    }
+    
+    // Fog of war: racers reveal the maze from their start cells
+    if (config->fog_radius > 0 && sim->character_count > 0) {
+        sim->fog = fog_create(sim->maze, sim->character_count, config->fog_radius);
+        if (sim->fog) {
+            simulation_update_fog(sim, false);
+        }
+    }
+    
+    return sim;
+}
+
+// Free a race and everything it owns
+void simulation_destroy(Simulation* sim) {
+    if (!sim) return;
+    
+    // Clean up physics (replayed races have no space)
+    if (sim->physics_space) {
+        physics_destroy_space(sim->physics_space);
+    }
+    
+    coop_destroy(sim->coop);
+    fog_destroy(sim->fog);
+    maze_triggers_destroy(sim->triggers);
+    if (sim->maze) {
+        maze_dynamic_destroy(sim->maze->dynamic);
+        maze_terrain_destroy(sim->maze->terrain);
+    }
+    
+    // Arena races free everything else at once (or leave it to the caller's reset)
+    if (sim->arena) {
+        if (sim->owns_arena) {
+            arena_destroy(sim->arena);
+        }
+        return;
+    }
+    
+    // Clean up characters
+    for (int i = 0; i < sim->character_count; i++) {
+        character_destroy(sim->characters[i]);
+    }
+    free(sim->characters);
+    free(sim->events);
+    
+    // Clean up maze
+    maze_destroy(sim->maze);
+    
+    free(sim);
+}
+
+// Advance the race by dt seconds
+void simulation_step(Simulation* sim, float dt) {
+    sim->event_count = 0;
+    
+    // Update physics
+    TRACE_BEGIN(physics_zone, "physics.step");
+    physics_update(sim->physics_space, dt);
+    TRACE_END(physics_zone);
+    
+    // Update maze
+    maze_update(sim->maze, dt);
+    
+    // Update simulation time
+    sim->time += dt;
+    
+    // Plan the racers' next cells around each other
+    if (sim->coop) {
+        TRACE_BEGIN(coop_zone, "coop.plan");
+        simulation_update_coop(sim, dt);
+        TRACE_END(coop_zone);
+    }
+    
+    // Update characters
+    TRACE_BEGIN(characters_zone, "characters.update");
+    for (int i = 0; i < sim->character_count; i++) {
+        Character* character = sim->characters[i];
+        bool had_escaped = character->has_escaped;
+        int ability_uses = character->ability_uses;
+        int cell_x = character->current_cell_x;
+        int cell_y = character->current_cell_y;
+        
+        character_update(character, sim->maze, dt);
+        
+        // Power-ups fire once per cell entered, not every step spent on them
+        if (sim->triggers && !character->has_escaped &&
+            (character->current_cell_x != cell_x || character->current_cell_y != cell_y)) {
+            simulation_fire_trigger(sim, character);
+        }
+        
+        if (character->ability_uses != ability_uses) {
+            simulation_push_effect(sim, ability_effect(character->type), character->x, character->y, 15);
+        }
+        
+        // Check if character has escaped
+        character_check_escaped(character, sim->maze);
+        
+        if (character->has_escaped && !had_escaped) {
+            character->escape_time = sim->time;
+            sim->escaped_count++;
+            simulation_push_effect(sim, SIM_EFFECT_CELEBRATION, character->x, character->y, 30);
+        }
+        
+        // Check for winner
+        if (character->has_escaped && !sim->winner) {
+            sim->winner = character;
+            if (sim->verbose) {
+                printf("Winner: %s escaped in %.2f seconds!\n", character->name, character->escape_time);
+            }
+        }
+    }
+    TRACE_END(characters_zone);
+    
+    // Consume this step's maze edits (broken walls, scheduled changes):
+    // swap the changed cells' colliders, then report the edits
+    bool maze_changed = sim->maze->change_count > 0;
+    maze_sync_physics(sim->maze, sim->maze->changes, sim->maze->change_count);
+    if (sim->triggers) {
+        maze_triggers_apply_changes(sim->triggers, sim->maze->changes, sim->maze->change_count);
+    }
+    for (int i = 0; i < sim->maze->change_count; i++) {
+        MazeCellChange* change = &sim->maze->changes[i];
+        SimulationEvent event = {0};
+        event.type = SIM_EVENT_CELL_CHANGE;
+        event.kind = change->new_type;
+        event.cell_x = change->x;
+        event.cell_y = change->y;
+        simulation_push_event(sim, &event);
+        
+        if (change->old_type == CELL_BREAKABLE) {
+            float x = (change->x + 0.5f) * sim->maze->cell_size;
+            float y = (change->y + 0.5f) * sim->maze->cell_size;
+            simulation_push_effect(sim, SIM_EFFECT_DUST, x, y, 20);
+        }
+    }
+    maze_clear_changes(sim->maze);
+    
+    // Reveal what the racers can see from their new cells
+    if (sim->fog) {
+        TRACE_BEGIN(fog_zone, "fog.update");
+        simulation_update_fog(sim, maze_changed);
+        TRACE_END(fog_zone);
+    }
+    
+    simulation_update_leader(sim);
+    simulation_update_prediction(sim);
+    
+    // A decided race may stop running before its winner gets out
+    if (sim->config.stop_when_decided && sim->decided_time >= 0.0f &&
+        sim->time - sim->decided_time >= sim->config.decided_epilogue) {
+        sim->running = false;
+    }
+    
+    // Check if simulation should end
+    if (sim->winner || sim->time >= sim->config.simulation_duration) {
+        if (!sim->winner && sim->verbose) {
+            printf("Simulation ended with no winner after %.2f seconds.\n", sim->time);
+        }
+        sim->running = false;
+    }
+}
+
+// Step a race on to its real result once it has stopped running: until a
+// racer escapes or the race times out. Callers draw and encode nothing for
+// these steps, which is where a decided race saves its time; the predicted
+// winner is only a guess and may still be overtaken.
+void simulation_finish(Simulation* sim, float dt) {
+    while (!sim->winner && sim->time < sim->config.simulation_duration) {
+        simulation_step(sim, dt);
+    }
+    sim->running = false;
+}
+
+// Append an event to the current step's event list
+void simulation_push_event(Simulation* sim, const SimulationEvent* event) {
+    if (sim->event_count == sim->event_capacity) {
+        int capacity = sim->event_capacity ? sim->event_capacity * 2 : 16;
+        SimulationEvent* grown = sim->arena
+            ? (SimulationEvent*)arena_grow(sim->arena, sim->events,
+                  sim->event_capacity * sizeof(SimulationEvent), capacity * sizeof(SimulationEvent))
+            : (SimulationEvent*)realloc(sim->events, capacity * sizeof(SimulationEvent));
+        if (!grown) return;
+        sim->events = grown;
+        sim->event_capacity = capacity;
+    }
+    
+    sim->events[sim->event_count++] = *event;
+}
+
+// Helper: Advance the planning clock, report where the racers are, replan
+// within the per-frame budget and hand every racer its next cell
+static void simulation_update_coop(Simulation* sim, float dt) {
+    MazeCoop* coop = sim->coop;
+    
+    sim->coop_elapsed += dt;
+    while (sim->coop_elapsed >= sim->coop_step_time) {
+        coop_advance(coop);
+        sim->coop_elapsed -= sim->coop_step_time;
+    }
+    
+    int cell_size = sim->maze->cell_size;
+    for (int i = 0; i < sim->character_count; i++) {
+        Character* character = sim->characters[i];
+        if (character->has_escaped) {
+            coop_set_agent(coop, i, -1, -1);
+        } else {
+            coop_set_agent(coop, i, (int)(character->x / cell_size), (int)(character->y / cell_size));
+        }
+    }
+    
+    coop_update(coop, COOP_DEFAULT_BUDGET);
+    
+    for (int i = 0; i < sim->character_count; i++) {
+        Character* character = sim->characters[i];
+        character->has_target = coop_next_cell(coop, i, &character->target_cell_x, &character->target_cell_y);
+    }
+}
+
+// Helper: Recast the field of view of racers that changed cell (all of
+// them when a wall broke, since new sight lines may have opened)
+static void simulation_update_fog(Simulation* sim, bool maze_changed) {
+    if (maze_changed) {
+        fog_invalidate(sim->fog);
+    }
+    
+    int cell_size = sim->maze->cell_size;
+    for (int i = 0; i < sim->character_count; i++) {
+        Character* character = sim->characters[i];
+        if (character->has_escaped) continue;
+        fog_move_viewer(sim->fog, i, (int)(character->x / cell_size), (int)(character->y / cell_size));
+    }
+}
+
+// Helper: Whether a racer stands in a cell (the dynamic maze must not close it)
+static bool simulation_cell_occupied(void* user_data, int x, int y) {
+    Simulation* sim = (Simulation*)user_data;
+    int cell_size = sim->maze->cell_size;
+    for (int i = 0; i < sim->character_count; i++) {
+        Character* character = sim->characters[i];
+        if (character->has_escaped) continue;
+        if ((int)(character->x / cell_size) == x && (int)(character->y / cell_size) == y) return true;
+    }
+    return false;
+}
+
+// Helper: Apply the power-up of the cell a racer just entered. A portal
+// drops the racer in its partner's cell; since that counts as the racer's
+// current cell, the partner fires only once the racer leaves and comes back.
+static void simulation_fire_trigger(Simulation* sim, Character* character) {
+    const MazeTrigger* trigger = maze_triggers_at(sim->triggers, character->current_cell_x, character->current_cell_y);
+    if (!trigger) return;
+    
+    switch (trigger->type) {
+        case MAZE_TRIGGER_SPEED_PAD:
+            character_apply_boost(character, TRIGGER_BOOST_MULTIPLIER, TRIGGER_BOOST_SECONDS);
+            simulation_push_effect(sim, SIM_EFFECT_DUST, character->x, character->y, 10);
+            break;
+        case MAZE_TRIGGER_COOLDOWN_RESET:
+            character->ability_cooldown_remaining = 0.0f;
+            simulation_push_effect(sim, SIM_EFFECT_SPARK, character->x, character->y, 10);
+            break;
+        case MAZE_TRIGGER_PORTAL: {
+            if (trigger->partner < 0) return;
+            const MazeTrigger* partner = &sim->triggers->triggers[trigger->partner];
+            
+            // Only jump towards the exit: racers steer downhill, so a portal
+            // back up their own route would bounce them between the pair forever
+            int partner_cost = maze_get_exit_cost(sim->maze, partner->x, partner->y);
+            int cost = maze_get_exit_cost(sim->maze, trigger->x, trigger->y);
+            if (partner_cost == MAZE_UNREACHABLE || (cost != MAZE_UNREACHABLE && partner_cost >= cost)) return;
+            float x = (partner->x + 0.5f) * sim->maze->cell_size;
+            float y = (partner->y + 0.5f) * sim->maze->cell_size;
+            simulation_push_effect(sim, SIM_EFFECT_TELEPORT, character->x, character->y, 15);
+            
+            if (character->body) {
+                cpBodySetPosition(character->body, cpv(x, y));
+            }
+            character->x = x;
+            character->y = y;
+            character->current_cell_x = partner->x;
+            character->current_cell_y = partner->y;
+            simulation_push_effect(sim, SIM_EFFECT_TELEPORT, x, y, 15);
+            break;
+        }
+    }
+    
+    sim->triggers_fired++;
+}
+
+// Helper: Report a visual effect
+static void simulation_push_effect(Simulation* sim, SimulationEffect effect, float x, float y, int count) {
+    SimulationEvent event = {0};
+    event.type = SIM_EVENT_EFFECT;
+    event.kind = effect;
+    event.x = x;
+    event.y = y;
+    event.count = count;
+    simulation_push_event(sim, &event);
+}
+
+// Helper: Effect shown when a character type uses its ability
+static SimulationEffect ability_effect(CharacterType type) {
+    switch (type) {
+        case CHARACTER_SMASHER:
+            return SIM_EFFECT_SPARK;
+        case CHARACTER_TELEPORTER:
+            return SIM_EFFECT_TELEPORT;
+        default:
+            return SIM_EFFECT_DUST;
+    }
+}
+
+// Helper: Track who is closest to the exit; ties keep the current leader
+static void simulation_update_leader(Simulation* sim) {
+    int best_index = sim->leader_index;
+    int best_distance = INT_MAX;
+    
+    if (best_index >= 0) {
+        Character* leader = sim->characters[best_index];
+        int distance = maze_get_exit_distance(sim->maze, leader->current_cell_x, leader->current_cell_y);
+        best_distance = leader->has_escaped ? -1 
+            : (distance == MAZE_UNREACHABLE ? INT_MAX : distance);
+    }
+    
+    for (int i = 0; i < sim->character_count; i++) {
+        Character* character = sim->characters[i];
+        int distance = maze_get_exit_distance(sim->maze, character->current_cell_x, character->current_cell_y);
+        if (character->has_escaped) {
+            distance = -1;
+        } else if (distance == MAZE_UNREACHABLE) {
+            distance = INT_MAX;
+        }
+        
+        if (distance < best_distance) {
+            best_distance = distance;
+            best_index = i;
+        }
+    }
+    
+    if (best_index != sim->leader_index) {
+        if (sim->leader_index >= 0) {
+            sim->lead_changes++;
+        }
+        sim->leader_index = best_index;
+    }
+}
+
+// Helper: Create a character from its type name
+static Character* create_character_of_type(Arena* arena, const char* type, float x, float y) {
+    if (strcmp(type, "runner") == 0) {
+        return character_create_in_arena(arena, CHARACTER_RUNNER, x, y);
+    } else if (strcmp(type, "smasher") == 0) {
+        return character_create_in_arena(arena, CHARACTER_SMASHER, x, y);
+    } else if (strcmp(type, "climber") == 0) {
+        return character_create_in_arena(arena, CHARACTER_CLIMBER, x, y);
+    } else if (strcmp(type, "teleporter") == 0) {
+        return character_create_in_arena(arena, CHARACTER_TELEPORTER, x, y);
+    }
+    return NULL;
+}
+
+// Helper: Estimate every racer's escape time (its steered route at top
+// speed) and check whether the expected winner can still be caught. The race
+// counts as decided once even a slow leader finishes before the earliest
+// time any other racer could. The leader's pace is an assumption (a jam or a
+// wall can pin it), so a decision only ends what is shown of a race, never
+// its result. Dynamic and cooperative races are only decided by the first
+// escape, since a door or a planned wait may hold the leader up for any time.
+static void simulation_update_prediction(Simulation* sim) {
+    int winner = -1;
+    
+    for (int i = 0; i < sim->character_count; i++) {
+        Character* character = sim->characters[i];
+        float finish = character->escape_time;
+        if (!character->has_escaped) {
+            float route = simulation_route_time(sim, character, 1.0f);
+            finish = route < 0.0f ? -1.0f : sim->time + route;
+        }
+        
+        sim->predicted_finish[i] = finish;
+        if (finish >= 0.0f && (winner < 0 || finish < sim->predicted_finish[winner])) winner = i;
+    }
+    
+    // A decided race keeps its winner
+    if (sim->decided_time >= 0.0f) return;
+    sim->predicted_winner = winner;
+    if (winner < 0) return;
+    
+    Character* leader = sim->characters[winner];
+    if (!leader->has_escaped) {
+        // Changing walls and planned waits can hold the leader up without bound
+        if (sim->maze->dynamic || sim->coop) return;
+        
+        // Floors change how fast anyone can go
+        float fastest_floor = 1.0f;
+        if (sim->maze->terrain) {
+            for (int type = 0; type < TERRAIN_COUNT; type++) {
+                fastest_floor = fmaxf(fastest_floor, maze_terrain_info((TerrainType)type)->speed_scale);
+            }
+        }
+        
+        float route = simulation_route_time(sim, leader, PREDICT_LEADER_PACE);
+        if (route < 0.0f) return;
+        float latest = sim->time + route;
+        
+        for (int i = 0; i < sim->character_count; i++) {
+            if (i == winner) continue;
+            if (simulation_earliest_finish(sim, sim->characters[i], fastest_floor) <= latest) return;
+        }
+    }
+    
+    sim->decided_time = sim->time;
+}
+
+// Helper: Seconds a racer needs to reach the exit along the route it steers
+// (the first strictly cheaper neighbour by exit cost, taking every portal
+// that fires on the way) at `pace` times its top speed on each floor, with
+// belts against the direction of travel halving it again. Every move and
+// jump lowers the exit cost, so the walk ends. Returns -1 if the racer has
+// no way down to the exit.
+static float simulation_route_time(Simulation* sim, Character* character, float pace) {
+    static const int ROUTE_DX[4] = {0, 1, 0, -1};
+    static const int ROUTE_DY[4] = {-1, 0, 1, 0};
+    Maze* maze = sim->maze;
+    float cell_size = (float)maze->cell_size;
+    int x = character->current_cell_x;
+    int y = character->current_cell_y;
+    int cost = maze_get_exit_cost(maze, x, y);
+    if (cost == MAZE_UNREACHABLE) return -1.0f;
+    
+    float seconds = 0.0f;
+    while (cost > 0) {
+        int best_dir = -1;
+        int best_cost = cost;
+        for (int dir = 0; dir < 4; dir++) {
+            int next_cost = maze_get_exit_cost(maze, x + ROUTE_DX[dir], y + ROUTE_DY[dir]);
+            if (next_cost != MAZE_UNREACHABLE && next_cost < best_cost) {
+                best_cost = next_cost;
+                best_dir = dir;
+            }
+        }
+        if (best_dir < 0) return -1.0f;
+        
+        // Steering runs at the speed of the floor being left
+        const TerrainInfo* floor = maze_terrain_info(maze_get_terrain(maze, x, y));
+        float speed = character->speed * floor->speed_scale * pace;
+        const TerrainInfo* entered = maze_terrain_info(maze_get_terrain(maze, x + ROUTE_DX[best_dir], y + ROUTE_DY[best_dir]));
+        if (entered->push_x == -ROUTE_DX[best_dir] && entered->push_y == -ROUTE_DY[best_dir] &&
+            (entered->push_x || entered->push_y)) {
+            speed *= 0.5f;
+        }
+        seconds += cell_size / speed;
+        
+        x += ROUTE_DX[best_dir];
+        y += ROUTE_DY[best_dir];
+        cost = best_cost;
+        
+        // Portals that fire send the racer on from their partner
+        const MazeTrigger* trigger = sim->triggers ? maze_triggers_at(sim->triggers, x, y) : NULL;
+        if (trigger && trigger->type == MAZE_TRIGGER_PORTAL && trigger->partner >= 0) {
+            const MazeTrigger* partner = &sim->triggers->triggers[trigger->partner];
+            int partner_cost = maze_get_exit_cost(maze, partner->x, partner->y);
+            if (partner_cost != MAZE_UNREACHABLE && partner_cost < cost) {
+                x = partner->x;
+                y = partner->y;
+                cost = partner_cost;
+            }
+        }
+    }
+    
+    return seconds;
+}
+
+// Helper: Lower bound on a racer's escape time: the straight line to the
+// exit (walls can be broken or jumped) or through the best portal pair, at
+// top speed with every boost, plus an ability jump every cooldown
+static float simulation_earliest_finish(Simulation* sim, Character* character, float fastest_floor) {
+    if (character->has_escaped) return character->escape_time;
+    
+    Maze* maze = sim->maze;
+    float cell_size = (float)maze->cell_size;
+    float exit_x = (maze->exit_x + 0.5f) * cell_size;
+    float exit_y = (maze->exit_y + 0.5f) * cell_size;
+    float distance = hypotf(exit_x - character->x, exit_y - character->y);
+    
+    if (sim->triggers) {
+        for (int i = 0; i < sim->triggers->trigger_count; i++) {
+            const MazeTrigger* portal = &sim->triggers->triggers[i];
+            if (portal->type != MAZE_TRIGGER_PORTAL || portal->partner < 0) continue;
+            
+            const MazeTrigger* partner = &sim->triggers->triggers[portal->partner];
+            float via = hypotf((portal->x + 0.5f) * cell_size - character->x, (portal->y + 0.5f) * cell_size - character->y)
+                      + hypotf(exit_x - (partner->x + 0.5f) * cell_size, exit_y - (partner->y + 0.5f) * cell_size);
+            distance = fminf(distance, via);
+        }
+    }
+    
+    // The exit counts as reached at its cell's edge
+    distance = fmaxf(0.0f, distance - cell_size);
+    
+    float top_speed = character->speed * TRIGGER_BOOST_MULTIPLIER * fastest_floor * PREDICT_SPEED_MARGIN;
+    if (character->use_ability && character->cooldown > 0.0f) {
+        top_speed += PREDICT_JUMP_CELLS * cell_size / character->cooldown;
+    }
+    return sim->time + distance / top_speed;
+}
@@ -0,0 +1,180 @@
+#include "simulation/timelapse.h"
+#include <stdlib.h>
+#include <math.h>
+
+// Activity below which a stretch is sped up
+#define TIMELAPSE_DULL_ACTIVITY 0.35f
+
+// Seconds of memory of the smoothed activity
+#define TIMELAPSE_SMOOTHING 1.0f
+
+// Seconds an event keeps the playback at real time
+#define TIMELAPSE_EVENT_HOLD 2.0f
+
+// Output frames between raising the speed-up by one step
+#define TIMELAPSE_RAMP_FRAMES 15
+
+// Weights of leader progress, events and racer motion in the activity score
+#define TIMELAPSE_PROGRESS_WEIGHT 0.4f
+#define TIMELAPSE_EVENT_WEIGHT 0.4f
+#define TIMELAPSE_MOTION_WEIGHT 0.2f
+
+// Local function prototypes
+static float timelapse_leader_progress(TimeLapse* lapse, Simulation* sim, float dt);
+static float timelapse_motion(Simulation* sim);
+
+// Start a time-lapse that runs up to max_speedup simulated steps per output
+// frame, mapping output frames to race time in map_path (NULL = no map)
+TimeLapse* timelapse_open(int max_speedup, int fps, const char* map_path) {
+    TimeLapse* lapse = (TimeLapse*)calloc(1, sizeof(TimeLapse));
+    if (!lapse) return NULL;
+    
+    lapse->max_speedup = max_speedup > 1 ? max_speedup : 1;
+    lapse->speedup = 1;
+    lapse->activity = 1.0f;
+    lapse->leader_index = -1;
+    lapse->leader_distance = -1;
+    lapse->frame_dt = 1.0f / fps;
+    
+    if (map_path) {
+        lapse->map_file = fopen(map_path, "w");
+        if (!lapse->map_file) {
+            fprintf(stderr, "Error creating time map %s\n", map_path);
+            free(lapse);
+            return NULL;
+        }
+        fprintf(lapse->map_file, "frame,output_time,sim_time,speedup\n");
+    }
+    
+    return lapse;
+}
+
+// Finish the map file and free the time-lapse. Returns false if the map
+// could not be written completely.
+bool timelapse_close(TimeLapse* lapse) {
+    if (!lapse) return false;
+    
+    bool ok = !lapse->failed;
+    if (lapse->map_file) {
+        if (ferror(lapse->map_file)) ok = false;
+        if (fclose(lapse->map_file) != 0) ok = false;
+    }
+    
+    free(lapse);
+    return ok;
+}
+
+// Score the step just simulated and fold it into the smoothed activity.
+// Returns the smoothed activity.
+float timelapse_measure(TimeLapse* lapse, Simulation* sim, float dt) {
+    if (!lapse) return 1.0f;
+    lapse->step_count++;
+    
+    // Visual effects (breaks, teleports, escapes) and overtakes are events
+    int events = sim->lead_changes - lapse->lead_changes;
+    lapse->lead_changes = sim->lead_changes;
+    for (int i = 0; i < sim->event_count; i++) {
+        if (sim->events[i].type == SIM_EVENT_EFFECT) events++;
+    }
+    
+    lapse->event_level -= dt / TIMELAPSE_EVENT_HOLD;
+    if (lapse->event_level < 0.0f) lapse->event_level = 0.0f;
+    if (events > 0) lapse->event_level = 1.0f;
+    
+    float score = TIMELAPSE_PROGRESS_WEIGHT * timelapse_leader_progress(lapse, sim, dt) +
+                  TIMELAPSE_EVENT_WEIGHT * lapse->event_level +
+                  TIMELAPSE_MOTION_WEIGHT * timelapse_motion(sim);
+    
+    // Drop back to real time at once so the action is not skipped through
+    if (events > 0 && lapse->activity < TIMELAPSE_DULL_ACTIVITY) {
+        lapse->activity = TIMELAPSE_DULL_ACTIVITY;
+        lapse->speedup = 1;
+        lapse->ramp_frames = 0;
+    }
+    
+    float alpha = fminf(dt / TIMELAPSE_SMOOTHING, 1.0f);
+    lapse->activity += (score - lapse->activity) * alpha;
+    return lapse->activity;
+}
+
+// Choose how many simulated steps the next output frame covers: one while
+// the race is lively, up to max_speedup the duller it gets. The speed-up
+// rises one step at a time but falls straight back.
+int timelapse_next_speedup(TimeLapse* lapse) {
+    if (!lapse) return 1;
+    
+    int target = 1;
+    if (lapse->activity < TIMELAPSE_DULL_ACTIVITY) {
+        float dullness = 1.0f - lapse->activity / TIMELAPSE_DULL_ACTIVITY;
+        target = 1 + (int)lroundf(dullness * (lapse->max_speedup - 1));
+    }
+    
+    if (target > lapse->speedup) {
+        if (++lapse->ramp_frames >= TIMELAPSE_RAMP_FRAMES) {
+            lapse->speedup++;
+            lapse->ramp_frames = 0;
+        }
+    } else {
+        lapse->speedup = target;
+        lapse->ramp_frames = 0;
+    }
+    
+    return lapse->speedup;
+}
+
+// Record that the next output frame shows the race at sim_time
+void timelapse_write_frame(TimeLapse* lapse, float sim_time) {
+    if (!lapse) return;
+    
+    if (lapse->map_file && !lapse->failed) {
+        if (fprintf(lapse->map_file, "%d,%.4f,%.4f,%d\n", lapse->frame_count,
+                    lapse->frame_count * lapse->frame_dt, sim_time, lapse->speedup) < 0) {
+            lapse->failed = true;
+        }
+    }
+    lapse->frame_count++;
+}
+
+// Helper: Leader's smoothed progress towards the exit, relative to covering
+// cells at its full speed (0 when stalled or backtracking)
+static float timelapse_leader_progress(TimeLapse* lapse, Simulation* sim, float dt) {
+    if (sim->leader_index < 0) return 0.0f;
+    
+    Character* leader = sim->characters[sim->leader_index];
+    int distance = leader->has_escaped ? 0 :
+                   maze_get_exit_distance(sim->maze, leader->current_cell_x, leader->current_cell_y);
+    if (distance == MAZE_UNREACHABLE) distance = -1;
+    
+    // Cells are entered a few steps apart, so the rate is smoothed before clamping
+    if (sim->leader_index == lapse->leader_index && lapse->leader_distance >= 0 && distance >= 0) {
+        float expected = leader->speed * dt / sim->maze->cell_size;
+        if (expected > 0.0f) {
+            float rate = (lapse->leader_distance - distance) / expected;
+            float alpha = fminf(dt / TIMELAPSE_SMOOTHING, 1.0f);
+            lapse->progress += (rate - lapse->progress) * alpha;
+        }
+    }
+    
+    lapse->leader_index = sim->leader_index;
+    lapse->leader_distance = distance;
+    
+    return fminf(fmaxf(lapse->progress, 0.0f), 1.0f);
+}
+
+// Helper: Mean speed of the racers still in the maze, relative to their top speed
+static float timelapse_motion(Simulation* sim) {
+    float motion = 0.0f;
+    int racing = 0;
+    
+    for (int i = 0; i < sim->character_count; i++) {
+        Character* character = sim->characters[i];
+        if (character->has_escaped || character->speed <= 0.0f) continue;
+        
+        float speed = (float)cpvlength(cpBodyGetVelocity(character->body));
+        float top_speed = character->speed * fmaxf(character->boost_multiplier, 1.0f);
+        motion += fminf(speed / top_speed, 1.0f);
+        racing++;
+    }
+    
+    return racing > 0 ? motion / racing : 0.0f;
+}
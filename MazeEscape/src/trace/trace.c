@@ -0,0 +1,315 @@
+#include "trace/trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#ifdef _MSC_VER
+#define TRACE_THREAD_LOCAL __declspec(thread)
+#else
+#define TRACE_THREAD_LOCAL _Thread_local
+#endif
+
+// Stop recording on a thread past this many zones (about 100 MB)
+#define TRACE_MAX_EVENTS_PER_THREAD (1 << 22)
+#define TRACE_INITIAL_CAPACITY 4096
+
+// One completed zone
+typedef struct {
+    const char* name;
+    uint64_t start_ns;
+    uint64_t duration_ns;
+} TraceEvent;
+
+// Zones recorded by one thread. Only the owning thread appends; buffers are
+// read after all threads have been joined.
+typedef struct TraceBuffer {
+    TraceEvent* events;
+    int event_count;
+    int event_capacity;
+    int dropped;
+    int thread_id;
+    const char* thread_name;
+    struct TraceBuffer* next;
+} TraceBuffer;
+
+// Per-phase statistics for the summary
+typedef struct {
+    const char* name;
+    uint64_t* durations;
+    int count;
+} TracePhase;
+
+// Local variables
+static volatile bool trace_enabled = false;
+static TraceBuffer* volatile trace_buffers = NULL;
+static volatile long trace_next_thread_id = 0;
+static uint64_t trace_origin_ns = 0;
+static TRACE_THREAD_LOCAL TraceBuffer* trace_local_buffer = NULL;
+
+// Local function prototypes
+static TraceBuffer* trace_get_buffer(void);
+static int compare_durations(const void* a, const void* b);
+static uint64_t percentile(const uint64_t* sorted, int count, double fraction);
+
+// Turn recording on or off (set before worker threads start)
+void trace_enable(bool enabled) {
+    if (enabled && trace_origin_ns == 0) {
+        trace_origin_ns = trace_now_ns();
+    }
+    trace_enabled = enabled;
+}
+
+// Check if zones are being recorded
+bool trace_is_enabled(void) {
+    return trace_enabled;
+}
+
+// Monotonic clock in nanoseconds
+uint64_t trace_now_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    if (frequency.QuadPart == 0) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+// Label the calling thread in the exported trace
+void trace_set_thread_name(const char* name) {
+    if (!trace_enabled) return;
+    
+    TraceBuffer* buffer = trace_get_buffer();
+    if (buffer) {
+        buffer->thread_name = name;
+    }
+}
+
+// Start a zone
+TraceZone trace_zone_begin(const char* name) {
+    TraceZone zone = {name, 0, false};
+    if (trace_enabled) {
+        zone.start_ns = trace_now_ns();
+        zone.active = true;
+    }
+    return zone;
+}
+
+// Finish a zone and record it in this thread's buffer
+void trace_zone_end(TraceZone* zone) {
+    if (!zone->active) return;
+    zone->active = false;
+    
+    uint64_t end_ns = trace_now_ns();
+    TraceBuffer* buffer = trace_get_buffer();
+    if (!buffer) return;
+    
+    // Grow the buffer
+    if (buffer->event_count >= buffer->event_capacity) {
+        if (buffer->event_capacity >= TRACE_MAX_EVENTS_PER_THREAD) {
+            buffer->dropped++;
+            return;
+        }
+        
+        int capacity = buffer->event_capacity ? buffer->event_capacity * 2 : TRACE_INITIAL_CAPACITY;
+        TraceEvent* events = (TraceEvent*)realloc(buffer->events, capacity * sizeof(TraceEvent));
+        if (!events) {
+            buffer->dropped++;
+            return;
+        }
+        buffer->events = events;
+        buffer->event_capacity = capacity;
+    }
+    
+    TraceEvent* event = &buffer->events[buffer->event_count++];
+    event->name = zone->name;
+    event->start_ns = zone->start_ns;
+    event->duration_ns = end_ns - zone->start_ns;
+}
+
+// Write all recorded zones in Chrome trace event format (chrome://tracing, Perfetto)
+bool trace_write_chrome(const char* filename) {
+    FILE* file = fopen(filename, "w");
+    if (!file) {
+        fprintf(stderr, "Error opening trace file %s\n", filename);
+        return false;
+    }
+    
+    fprintf(file, "{\"traceEvents\":[\n");
+    bool first = true;
+    
+    for (TraceBuffer* buffer = trace_buffers; buffer; buffer = buffer->next) {
+        if (buffer->thread_name) {
+            fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                "\"args\":{\"name\":\"%s\"}}",
+                first ? "" : ",\n", buffer->thread_id, buffer->thread_name);
+            first = false;
+        }
+        
+        for (int i = 0; i < buffer->event_count; i++) {
+            TraceEvent* event = &buffer->events[i];
+            fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                first ? "" : ",\n", event->name, buffer->thread_id,
+                (event->start_ns - trace_origin_ns) / 1000.0,
+                event->duration_ns / 1000.0);
+            first = false;
+        }
+    }
+    
+    fprintf(file, "\n],\"displayTimeUnit\":\"ms\"}\n");
+    
+    bool ok = !ferror(file);
+    fclose(file);
+    
+    if (ok) {
+        printf("Trace saved to %s\n", filename);
+    }
+    return ok;
+}
+
+// Print per-phase count, total and p50/p95/p99 durations across all threads
+void trace_print_summary(void) {
+    TracePhase* phases = NULL;
+    int phase_count = 0;
+    int dropped = 0;
+    
+    // Group durations by zone name
+    for (TraceBuffer* buffer = trace_buffers; buffer; buffer = buffer->next) {
+        dropped += buffer->dropped;
+        
+        for (int i = 0; i < buffer->event_count; i++) {
+            TraceEvent* event = &buffer->events[i];
+            
+            TracePhase* phase = NULL;
+            for (int p = 0; p < phase_count; p++) {
+                if (strcmp(phases[p].name, event->name) == 0) {
+                    phase = &phases[p];
+                    break;
+                }
+            }
+            
+            if (!phase) {
+                TracePhase* grown = (TracePhase*)realloc(phases, (phase_count + 1) * sizeof(TracePhase));
+                if (!grown) continue;
+                phases = grown;
+                phase = &phases[phase_count++];
+                phase->name = event->name;
+                phase->durations = NULL;
+                phase->count = 0;
+            }
+            
+            // Grow in powers of two
+            if ((phase->count & (phase->count - 1)) == 0) {
+                int capacity = phase->count ? phase->count * 2 : 64;
+                uint64_t* durations = (uint64_t*)realloc(phase->durations, capacity * sizeof(uint64_t));
+                if (!durations) continue;
+                phase->durations = durations;
+            }
+            phase->durations[phase->count++] = event->duration_ns;
+        }
+    }
+    
+    if (phase_count == 0) {
+        free(phases);
+        return;
+    }
+    
+    printf("\n%-24s %10s %12s %10s %10s %10s\n", "Phase", "Count", "Total (ms)", "p50 (ms)", "p95 (ms)", "p99 (ms)");
+    
+    for (int p = 0; p < phase_count; p++) {
+        TracePhase* phase = &phases[p];
+        qsort(phase->durations, phase->count, sizeof(uint64_t), compare_durations);
+        
+        uint64_t total = 0;
+        for (int i = 0; i < phase->count; i++) {
+            total += phase->durations[i];
+        }
+        
+        printf("%-24s %10d %12.2f %10.3f %10.3f %10.3f\n",
+            phase->name, phase->count, total / 1e6,
+            percentile(phase->durations, phase->count, 0.50) / 1e6,
+            percentile(phase->durations, phase->count, 0.95) / 1e6,
+            percentile(phase->durations, phase->count, 0.99) / 1e6);
+        
+        free(phase->durations);
+    }
+    
+    if (dropped > 0) {
+        printf("(%d zones dropped: per-thread trace buffer full)\n", dropped);
+    }
+    
+    free(phases);
+}
+
+// Free every thread's buffer
+void trace_shutdown(void) {
+    trace_enabled = false;
+    
+    TraceBuffer* buffer = trace_buffers;
+    trace_buffers = NULL;
+    
+    while (buffer) {
+        TraceBuffer* next = buffer->next;
+        free(buffer->events);
+        free(buffer);
+        buffer = next;
+    }
+    
+    // Threads that recorded zones must have exited by now
+    trace_local_buffer = NULL;
+}
+
+// Helper: Get (or register) the calling thread's buffer
+static TraceBuffer* trace_get_buffer(void) {
+    if (trace_local_buffer) return trace_local_buffer;
+    
+    TraceBuffer* buffer = (TraceBuffer*)calloc(1, sizeof(TraceBuffer));
+    if (!buffer) return NULL;
+    
+    // Publish it on the global list without a lock
+#ifdef _WIN32
+    buffer->thread_id = (int)InterlockedIncrement(&trace_next_thread_id);
+    TraceBuffer* head;
+    do {
+        head = trace_buffers;
+        buffer->next = head;
+    } while (InterlockedCompareExchangePointer((PVOID volatile*)&trace_buffers, buffer, head) != head);
+#else
+    buffer->thread_id = (int)__sync_add_and_fetch(&trace_next_thread_id, 1);
+    TraceBuffer* head;
+    do {
+        head = trace_buffers;
+        buffer->next = head;
+    } while (!__sync_bool_compare_and_swap(&trace_buffers, head, buffer));
+#endif
+    
+    trace_local_buffer = buffer;
+    return buffer;
+}
+
+// Helper: qsort comparator for durations
+static int compare_durations(const void* a, const void* b) {
+    uint64_t da = *(const uint64_t*)a;
+    uint64_t db = *(const uint64_t*)b;
+    return (da > db) - (da < db);
+}
+
+// Helper: Nearest-rank percentile of a sorted array
+static uint64_t percentile(const uint64_t* sorted, int count, double fraction) {
+    int index = (int)(fraction * count + 0.5) - 1;
+    if (index < 0) index = 0;
+    if (index >= count) index = count - 1;
+    return sorted[index];
+}
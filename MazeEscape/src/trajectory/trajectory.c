@@ -0,0 +1,578 @@
+#include "trajectory/trajectory.h"
+#include "maze/terrain.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// File format version and magic
+#define TRAJECTORY_MAGIC "MZTR"
+#define TRAJECTORY_VERSION 4
+
+// Record tags
+#define TAG_END 0
+#define TAG_FRAME 1
+
+// Per-character field mask
+#define FIELD_POSITION 0x01
+#define FIELD_ANGLE    0x02
+#define FIELD_STATE    0x04
+#define FIELD_COOLDOWN 0x08
+
+// Fixed-point scales
+#define POSITION_SCALE 64.0f    // 1/64 pixel
+#define ANGLE_SCALE 1024.0f     // 1/1024 radian
+#define COOLDOWN_SCALE 100.0f   // 10 ms
+#define TIME_SCALE 1000000.0    // 1 us
+
+// Longest maze side accepted from a file (keeps the cell count well inside an int)
+#define TRAJECTORY_MAX_MAZE_SIDE 4096
+
+// Flush the write buffer once it holds this many bytes
+#define WRITE_BUFFER_FLUSH 65536
+
+// Quantized per-character state (delta coding reference)
+typedef struct {
+    int x;
+    int y;
+    int angle;
+    int cooldown;
+    int state;
+} QuantizedCharacter;
+
+// Recorder state
+struct TrajectoryWriter {
+    FILE* file;
+    unsigned char* buffer;
+    size_t length;
+    size_t capacity;
+    bool failed;
+    long long last_time;
+    int character_count;
+    QuantizedCharacter* previous;
+};
+
+// Replay state
+struct TrajectoryReader {
+    unsigned char* data;
+    size_t length;
+    size_t cursor;
+    bool failed;
+    int fps;
+    long long last_time;
+    float frame_dt;
+    Simulation* sim;
+    QuantizedCharacter* previous;
+};
+
+// Local function prototypes
+static void write_byte(TrajectoryWriter* writer, unsigned char value);
+static void write_varint(TrajectoryWriter* writer, unsigned long long value);
+static void write_signed(TrajectoryWriter* writer, long long value);
+static void flush_writer(TrajectoryWriter* writer);
+static unsigned long long read_varint(TrajectoryReader* reader);
+static long long read_signed(TrajectoryReader* reader);
+static QuantizedCharacter quantize_character(const Character* character);
+static int character_state_bits(const Character* character);
+static bool read_header(TrajectoryReader* reader);
+static void update_fog(Simulation* sim, bool maze_changed);
+static void write_character(TrajectoryWriter* writer, const QuantizedCharacter* q);
+static void read_character(TrajectoryReader* reader, QuantizedCharacter* q);
+static void apply_character(Character* character, const QuantizedCharacter* q, int cell_size);
+
+// Start a recording: writes the header and the generated maze
+TrajectoryWriter* trajectory_writer_open(const char* path, const Simulation* sim, int fps) {
+    TrajectoryWriter* writer = (TrajectoryWriter*)calloc(1, sizeof(TrajectoryWriter));
+    if (!writer) return NULL;
+    
+    writer->file = fopen(path, "wb");
+    writer->capacity = WRITE_BUFFER_FLUSH * 2;
+    writer->buffer = (unsigned char*)malloc(writer->capacity);
+    writer->character_count = sim->character_count;
+    writer->previous = (QuantizedCharacter*)calloc(sim->character_count + 1, sizeof(QuantizedCharacter));
+    
+    if (!writer->file || !writer->buffer || !writer->previous) {
+        fprintf(stderr, "Error opening trajectory file %s\n", path);
+        if (writer->file) fclose(writer->file);
+        free(writer->buffer);
+        free(writer->previous);
+        free(writer);
+        return NULL;
+    }
+    
+    // Header
+    for (int i = 0; i < 4; i++) {
+        write_byte(writer, (unsigned char)TRAJECTORY_MAGIC[i]);
+    }
+    write_varint(writer, TRAJECTORY_VERSION);
+    write_varint(writer, (unsigned long long)fps);
+    write_varint(writer, sim->config.random_seed);
+    write_varint(writer, (unsigned long long)sim->config.simulation_duration);
+    write_varint(writer, (unsigned long long)(sim->fog ? sim->fog->radius : 0));
+    
+    // Maze: dimensions, exit, then run-length coded cells (column-major)
+    Maze* maze = sim->maze;
+    write_varint(writer, (unsigned long long)maze->width);
+    write_varint(writer, (unsigned long long)maze->height);
+    write_varint(writer, (unsigned long long)maze->cell_size);
+    write_varint(writer, (unsigned long long)maze->exit_x);
+    write_varint(writer, (unsigned long long)maze->exit_y);
+    
+    int cell_count = maze->width * maze->height;
+    int index = 0;
+    while (index < cell_count) {
+        CellType type = maze->cells[index / maze->height][index % maze->height];
+        int run = 1;
+        while (index + run < cell_count &&
+               maze->cells[(index + run) / maze->height][(index + run) % maze->height] == type) {
+            run++;
+        }
+        write_varint(writer, (unsigned long long)type);
+        write_varint(writer, (unsigned long long)run);
+        index += run;
+    }
+    
+    // Terrain: a presence flag, then run-length coded floor types
+    MazeTerrain* terrain = maze->terrain;
+    write_varint(writer, terrain ? 1 : 0);
+    index = 0;
+    while (terrain && index < cell_count) {
+        unsigned char type = terrain->types[index];
+        int run = 1;
+        while (index + run < cell_count && terrain->types[index + run] == type) {
+            run++;
+        }
+        write_varint(writer, (unsigned long long)type);
+        write_varint(writer, (unsigned long long)run);
+        index += run;
+    }
+    
+    // Racers: type and starting state, the reference of the first frame's deltas
+    write_varint(writer, (unsigned long long)sim->character_count);
+    for (int i = 0; i < sim->character_count; i++) {
+        write_varint(writer, (unsigned long long)sim->characters[i]->type);
+        writer->previous[i] = quantize_character(sim->characters[i]);
+        write_character(writer, &writer->previous[i]);
+    }
+    
+    return writer;
+}
+
+// Append the current race state as one frame; events are written only if the
+// simulation stepped since the previous frame
+bool trajectory_write_frame(TrajectoryWriter* writer, const Simulation* sim, bool stepped) {
+    if (!writer || writer->failed) return false;
+    
+    write_varint(writer, TAG_FRAME);
+    
+    long long time = llround(sim->time * TIME_SCALE);
+    write_signed(writer, time - writer->last_time);
+    writer->last_time = time;
+    
+    int winner = 0;
+    for (int i = 0; i < sim->character_count; i++) {
+        if (sim->characters[i] == sim->winner) winner = i + 1;
+    }
+    write_varint(writer, (unsigned long long)winner);
+    
+    // Characters: a field mask, then deltas of the fields that changed
+    for (int i = 0; i < writer->character_count; i++) {
+        QuantizedCharacter current = quantize_character(sim->characters[i]);
+        QuantizedCharacter* previous = &writer->previous[i];
+        
+        int mask = 0;
+        if (current.x != previous->x || current.y != previous->y) mask |= FIELD_POSITION;
+        if (current.angle != previous->angle) mask |= FIELD_ANGLE;
+        if (current.state != previous->state) mask |= FIELD_STATE;
+        if (current.cooldown != previous->cooldown) mask |= FIELD_COOLDOWN;
+        
+        write_varint(writer, (unsigned long long)mask);
+        if (mask & FIELD_POSITION) {
+            write_signed(writer, current.x - previous->x);
+            write_signed(writer, current.y - previous->y);
+        }
+        if (mask & FIELD_ANGLE) write_signed(writer, current.angle - previous->angle);
+        if (mask & FIELD_STATE) write_varint(writer, (unsigned long long)current.state);
+        if (mask & FIELD_COOLDOWN) write_signed(writer, current.cooldown - previous->cooldown);
+        
+        *previous = current;
+    }
+    
+    // Events
+    int event_count = stepped ? sim->event_count : 0;
+    write_varint(writer, (unsigned long long)event_count);
+    for (int i = 0; i < event_count; i++) {
+        const SimulationEvent* event = &sim->events[i];
+        write_varint(writer, (unsigned long long)event->type);
+        write_varint(writer, (unsigned long long)event->kind);
+        if (event->type == SIM_EVENT_EFFECT) {
+            write_signed(writer, lroundf(event->x * POSITION_SCALE));
+            write_signed(writer, lroundf(event->y * POSITION_SCALE));
+            write_varint(writer, (unsigned long long)event->count);
+        } else {
+            write_varint(writer, (unsigned long long)event->cell_x);
+            write_varint(writer, (unsigned long long)event->cell_y);
+        }
+    }
+    
+    if (writer->length >= WRITE_BUFFER_FLUSH) {
+        flush_writer(writer);
+    }
+    
+    return !writer->failed;
+}
+
+// Finish a recording
+bool trajectory_writer_close(TrajectoryWriter* writer) {
+    if (!writer) return false;
+    
+    write_varint(writer, TAG_END);
+    flush_writer(writer);
+    
+    bool ok = !writer->failed;
+    if (fclose(writer->file) != 0) ok = false;
+    
+    free(writer->buffer);
+    free(writer->previous);
+    free(writer);
+    return ok;
+}
+
+// Load a recording and rebuild the race at its initial state
+TrajectoryReader* trajectory_reader_open(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file) {
+        fprintf(stderr, "Error opening trajectory file %s\n", path);
+        return NULL;
+    }
+    
+    TrajectoryReader* reader = (TrajectoryReader*)calloc(1, sizeof(TrajectoryReader));
+    if (!reader) {
+        fclose(file);
+        return NULL;
+    }
+    
+    // Trajectories are compact, so read the whole file at once
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    
+    reader->data = (unsigned char*)malloc(size > 0 ? (size_t)size : 1);
+    reader->length = size > 0 ? (size_t)size : 0;
+    
+    bool ok = reader->data && fread(reader->data, 1, reader->length, file) == reader->length;
+    fclose(file);
+    
+    if (!ok || !read_header(reader)) {
+        fprintf(stderr, "Invalid trajectory file %s\n", path);
+        trajectory_reader_close(reader);
+        return NULL;
+    }
+    
+    return reader;
+}
+
+// The replayed race (no physics space; characters have no bodies)
+Simulation* trajectory_reader_simulation(TrajectoryReader* reader) {
+    return reader->sim;
+}
+
+// Frame rate the trajectory was recorded at
+int trajectory_reader_fps(const TrajectoryReader* reader) {
+    return reader->fps;
+}
+
+// Simulated time covered by the last frame read
+float trajectory_reader_frame_dt(const TrajectoryReader* reader) {
+    return reader->frame_dt;
+}
+
+// Apply the next frame to the replayed race; false at the end of the recording
+bool trajectory_read_frame(TrajectoryReader* reader) {
+    if (reader->failed || reader->cursor >= reader->length) return false;
+    
+    if (read_varint(reader) != TAG_FRAME) return false;
+    
+    Simulation* sim = reader->sim;
+    
+    long long time = reader->last_time + read_signed(reader);
+    reader->frame_dt = (float)((time - reader->last_time) / TIME_SCALE);
+    reader->last_time = time;
+    sim->time = (float)(time / TIME_SCALE);
+    
+    int winner = (int)read_varint(reader);
+    sim->winner = (winner > 0 && winner <= sim->character_count) ? sim->characters[winner - 1] : NULL;
+    
+    for (int i = 0; i < sim->character_count; i++) {
+        Character* character = sim->characters[i];
+        QuantizedCharacter* q = &reader->previous[i];
+        int mask = (int)read_varint(reader);
+        
+        if (mask & FIELD_POSITION) {
+            q->x += (int)read_signed(reader);
+            q->y += (int)read_signed(reader);
+        }
+        if (mask & FIELD_ANGLE) q->angle += (int)read_signed(reader);
+        if (mask & FIELD_STATE) q->state = (int)read_varint(reader);
+        if (mask & FIELD_COOLDOWN) q->cooldown += (int)read_signed(reader);
+        
+        apply_character(character, q, sim->maze->cell_size);
+    }
+    
+    sim->event_count = 0;
+    bool maze_changed = false;
+    int event_count = (int)read_varint(reader);
+    for (int i = 0; i < event_count && !reader->failed; i++) {
+        SimulationEvent event = {0};
+        event.type = (SimulationEventType)read_varint(reader);
+        event.kind = (int)read_varint(reader);
+        if (event.type == SIM_EVENT_EFFECT) {
+            event.x = read_signed(reader) / POSITION_SCALE;
+            event.y = read_signed(reader) / POSITION_SCALE;
+            event.count = (int)read_varint(reader);
+        } else {
+            event.cell_x = (int)read_varint(reader);
+            event.cell_y = (int)read_varint(reader);
+            if (event.kind < CELL_EMPTY || event.kind > CELL_SPECIAL) {
+                reader->failed = true;
+                break;
+            }
+            maze_set_cell(sim->maze, event.cell_x, event.cell_y, (CellType)event.kind);
+            maze_changed = true;
+        }
+        simulation_push_event(sim, &event);
+    }
+    maze_clear_changes(sim->maze);
+    
+    if (sim->fog) {
+        update_fog(sim, maze_changed);
+    }
+    
+    return !reader->failed;
+}
+
+// Free a reader and its replayed race
+void trajectory_reader_close(TrajectoryReader* reader) {
+    if (!reader) return;
+    
+    simulation_destroy(reader->sim);
+    free(reader->previous);
+    free(reader->data);
+    free(reader);
+}
+
+// Helper: Read the header and build the race state
+static bool read_header(TrajectoryReader* reader) {
+    if (reader->length < 4 || memcmp(reader->data, TRAJECTORY_MAGIC, 4) != 0) return false;
+    reader->cursor = 4;
+    
+    if (read_varint(reader) != TRAJECTORY_VERSION) return false;
+    
+    reader->fps = (int)read_varint(reader);
+    
+    SimulationConfig config;
+    memset(&config, 0, sizeof(config));
+    config.random_seed = (unsigned int)read_varint(reader);
+    config.simulation_duration = (int)read_varint(reader);
+    config.fog_radius = (int)read_varint(reader);
+    config.maze_width = (int)read_varint(reader);
+    config.maze_height = (int)read_varint(reader);
+    config.cell_size = (int)read_varint(reader);
+    config.character_types = "";
+    
+    if (reader->failed || reader->fps <= 0 || config.cell_size <= 0 || config.fog_radius < 0 ||
+        config.maze_width <= 0 || config.maze_width > TRAJECTORY_MAX_MAZE_SIDE ||
+        config.maze_height <= 0 || config.maze_height > TRAJECTORY_MAX_MAZE_SIDE) {
+        return false;
+    }
+    
+    Simulation* sim = (Simulation*)calloc(1, sizeof(Simulation));
+    if (!sim) return false;
+    reader->sim = sim;
+    sim->config = config;
+    sim->leader_index = -1;
+    sim->predicted_winner = -1;
+    sim->decided_time = -1.0f;
+    sim->running = true;
+    sim->verbose = false;
+    
+    sim->maze = maze_create(config.maze_width, config.maze_height, config.cell_size);
+    if (!sim->maze) return false;
+    unsigned long long exit_x = read_varint(reader);
+    unsigned long long exit_y = read_varint(reader);
+    if (exit_x >= (unsigned long long)config.maze_width || exit_y >= (unsigned long long)config.maze_height) {
+        return false;
+    }
+    sim->maze->exit_x = (int)exit_x;
+    sim->maze->exit_y = (int)exit_y;
+    
+    int cell_count = config.maze_width * config.maze_height;
+    int index = 0;
+    while (index < cell_count && !reader->failed) {
+        unsigned long long type = read_varint(reader);
+        unsigned long long run = read_varint(reader);
+        if (type > CELL_SPECIAL || run == 0 || run > (unsigned long long)(cell_count - index)) return false;
+        for (unsigned long long i = 0; i < run; i++, index++) {
+            sim->maze->cells[index / config.maze_height][index % config.maze_height] = (CellType)type;
+        }
+    }
+    if (reader->failed) return false;
+    
+    // Frames edit cells incrementally, which needs a settled distance field
+    maze_compute_distance_field(sim->maze);
+    
+    // Terrain layer, with its cost field rebuilt for the replayed maze
+    if (read_varint(reader) != 0) {
+        MazeTerrain* terrain = maze_terrain_create(sim->maze);
+        if (!terrain) return false;
+        index = 0;
+        while (index < cell_count && !reader->failed) {
+            unsigned long long type = read_varint(reader);
+            unsigned long long run = read_varint(reader);
+            if (type >= TERRAIN_COUNT || run == 0 || run > (unsigned long long)(cell_count - index)) return false;
+            for (unsigned long long i = 0; i < run; i++, index++) {
+                maze_terrain_set(terrain, index / config.maze_height, index % config.maze_height, (TerrainType)type);
+            }
+        }
+        if (reader->failed) return false;
+        maze_terrain_compute_costs(terrain);
+    }
+    
+    int character_count = (int)read_varint(reader);
+    if (reader->failed || character_count < 0 || character_count > SIMULATION_MAX_CHARACTERS) return false;
+    
+    sim->characters = (Character**)calloc(SIMULATION_MAX_CHARACTERS, sizeof(Character*));
+    reader->previous = (QuantizedCharacter*)calloc(SIMULATION_MAX_CHARACTERS, sizeof(QuantizedCharacter));
+    if (!sim->characters || !reader->previous) return false;
+    
+    for (int i = 0; i < character_count; i++) {
+        CharacterType type = (CharacterType)read_varint(reader);
+        Character* character = character_create_of_type(type, 0.0f, 0.0f);
+        if (!character) return false;
+        sim->characters[sim->character_count++] = character;
+        read_character(reader, &reader->previous[i]);
+        apply_character(character, &reader->previous[i], config.cell_size);
+    }
+    
+    // Fog of war, revealed from the racers' starting cells and then as frames are read
+    if (config.fog_radius > 0 && character_count > 0) {
+        sim->fog = fog_create(sim->maze, character_count, config.fog_radius);
+        if (!sim->fog) return false;
+        update_fog(sim, false);
+    }
+    
+    return !reader->failed;
+}
+
+// Helper: Recast the field of view of racers that changed cell, as the live
+// race does after each step
+static void update_fog(Simulation* sim, bool maze_changed) {
+    if (maze_changed) {
+        fog_invalidate(sim->fog);
+    }
+    
+    for (int i = 0; i < sim->character_count; i++) {
+        Character* character = sim->characters[i];
+        if (character->has_escaped) continue;
+        fog_move_viewer(sim->fog, i, character->current_cell_x, character->current_cell_y);
+    }
+}
+
+// Helper: Fixed-point snapshot of the fields the renderer needs
+static QuantizedCharacter quantize_character(const Character* character) {
+    QuantizedCharacter q;
+    q.x = (int)lroundf(character->x * POSITION_SCALE);
+    q.y = (int)lroundf(character->y * POSITION_SCALE);
+    q.angle = (int)lroundf(character->angle * ANGLE_SCALE);
+    q.cooldown = (int)lroundf(character->ability_cooldown_remaining * COOLDOWN_SCALE);
+    q.state = character_state_bits(character);
+    return q;
+}
+
+// Helper: Write every field of a quantized character (no delta)
+static void write_character(TrajectoryWriter* writer, const QuantizedCharacter* q) {
+    write_signed(writer, q->x);
+    write_signed(writer, q->y);
+    write_signed(writer, q->angle);
+    write_varint(writer, (unsigned long long)q->state);
+    write_signed(writer, q->cooldown);
+}
+
+// Helper: Read a quantized character written by write_character
+static void read_character(TrajectoryReader* reader, QuantizedCharacter* q) {
+    q->x = (int)read_signed(reader);
+    q->y = (int)read_signed(reader);
+    q->angle = (int)read_signed(reader);
+    q->state = (int)read_varint(reader);
+    q->cooldown = (int)read_signed(reader);
+}
+
+// Helper: Set the replayed fields of a character from its quantized state
+static void apply_character(Character* character, const QuantizedCharacter* q, int cell_size) {
+    character->x = q->x / POSITION_SCALE;
+    character->y = q->y / POSITION_SCALE;
+    character->angle = q->angle / ANGLE_SCALE;
+    character->state = (CharacterState)(q->state & 0x7);
+    character->has_escaped = (q->state & 0x8) != 0;
+    character->ability_cooldown_remaining = q->cooldown / COOLDOWN_SCALE;
+    character->current_cell_x = (int)(character->x / cell_size);
+    character->current_cell_y = (int)(character->y / cell_size);
+}
+
+// Helper: State in the low three bits, escaped flag above it
+static int character_state_bits(const Character* character) {
+    return (int)character->state | (character->has_escaped ? 0x8 : 0);
+}
+
+// Helper: Append one byte to the write buffer
+static void write_byte(TrajectoryWriter* writer, unsigned char value) {
+    if (writer->length == writer->capacity) {
+        flush_writer(writer);
+    }
+    writer->buffer[writer->length++] = value;
+}
+
+// Helper: LEB128 unsigned varint
+static void write_varint(TrajectoryWriter* writer, unsigned long long value) {
+    while (value >= 0x80) {
+        write_byte(writer, (unsigned char)(value | 0x80));
+        value >>= 7;
+    }
+    write_byte(writer, (unsigned char)value);
+}
+
+// Helper: Zigzag-coded signed varint
+static void write_signed(TrajectoryWriter* writer, long long value) {
+    write_varint(writer, ((unsigned long long)value << 1) ^ (unsigned long long)(value >> 63));
+}
+
+// Helper: Write out buffered bytes
+static void flush_writer(TrajectoryWriter* writer) {
+    if (writer->length == 0) return;
+    if (fwrite(writer->buffer, 1, writer->length, writer->file) != writer->length) {
+        writer->failed = true;
+    }
+    writer->length = 0;
+}
+
+// Helper: Decode an unsigned varint, flagging truncated input
+static unsigned long long read_varint(TrajectoryReader* reader) {
+    unsigned long long value = 0;
+    int shift = 0;
+    
+    while (reader->cursor < reader->length && shift < 64) {
+        unsigned char byte = reader->data[reader->cursor++];
+        value |= (unsigned long long)(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) return value;
+        shift += 7;
+    }
+    
+    reader->failed = true;
+    return 0;
+}
+
+// Helper: Decode a zigzag-coded signed varint
+static long long read_signed(TrajectoryReader* reader) {
+    unsigned long long value = read_varint(reader);
+    return (long long)(value >> 1) ^ -(long long)(value & 1);
+}
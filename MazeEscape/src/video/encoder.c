@@ -1,4 +1,5 @@
 #include "video/encoder.h"
+#include "trace/trace.h"
 #include <stdlib.h>
 #include <string.h>
 
@@ -9,8 +10,12 @@ typedef struct {
     char* cmd;
     FILE* pipe;
     SDL_Surface* temp_surface;
+    uint8_t* yuv_buffer;   // Frame converted to planar YUV 4:2:0 for the pipe
 } FFmpegContext;
 
+// Local function prototypes
+static bool encoder_write_frame(VideoEncoder* encoder, FFmpegContext* ctx);
+
 // Create a new video encoder
 VideoEncoder* encoder_create(const char* filename, int width, int height, int fps, int bitrate) {
     VideoEncoder* encoder = (VideoEncoder*)malloc(sizeof(VideoEncoder));
@@ -31,6 +36,7 @@ VideoEncoder* encoder_create(const char* filename, int width, int height, int fp
     ctx->cmd = NULL;
     ctx->pipe = NULL;
     ctx->temp_surface = NULL;
+    ctx->yuv_buffer = NULL;
     encoder->ffmpeg_context = ctx;
     
     return encoder;
@@ -50,6 +56,7 @@ void encoder_destroy(VideoEncoder* encoder) {
         FFmpegContext* ctx = (FFmpegContext*)encoder->ffmpeg_context;
         if (ctx->cmd) free(ctx->cmd);
         if (ctx->temp_surface) SDL_FreeSurface(ctx->temp_surface);
+        free(ctx->yuv_buffer);
         free(ctx);
     }
     
@@ -58,22 +65,36 @@ void encoder_destroy(VideoEncoder* encoder) {
     free(encoder);
 }
 
+// Point a stopped encoder at a new output file, keeping its frame buffers
+bool encoder_set_output(VideoEncoder* encoder, const char* filename) {
+    if (!encoder || encoder->recording) return false;
+    
+    char* copy = strdup(filename);
+    if (!copy) return false;
+    
+    free(encoder->output_filename);
+    encoder->output_filename = copy;
+    return true;
+}
+
 // Start recording
 bool encoder_start(VideoEncoder* encoder) {
     if (!encoder || encoder->recording) return false;
     
     FFmpegContext* ctx = (FFmpegContext*)encoder->ffmpeg_context;
     
-    // Build FFmpeg command
+    // Build FFmpeg command (frames arrive already in the output pixel format,
+    // which halves the bytes sent through the pipe compared to RGB)
     char cmd[1024];
     snprintf(cmd, sizeof(cmd), 
-        "ffmpeg -y -f rawvideo -pix_fmt bgr24 -s %dx%d -r %d "
+        "ffmpeg -y -f rawvideo -pix_fmt yuv420p -s %dx%d -r %d "
         "-i - -c:v libx264 -preset fast -crf 22 -pix_fmt yuv420p "
         "-b:v %d \"%s\"",
         encoder->width, encoder->height, encoder->framerate,
         encoder->bitrate, encoder->output_filename
     );
     
+    if (ctx->cmd) free(ctx->cmd);
     ctx->cmd = strdup(cmd);
     
     // Open pipe to FFmpeg
@@ -88,13 +109,19 @@ bool encoder_start(VideoEncoder* encoder) {
         return false;
     }
     
-    // Create temporary surface for pixel data
-    ctx->temp_surface = SDL_CreateRGBSurface(
-        0, encoder->width, encoder->height, 24,
-        0x0000FF, 0x00FF00, 0xFF0000, 0
-    );
-    
+    // Create temporary surface for pixel data (kept across recordings)
     if (!ctx->temp_surface) {
+        ctx->temp_surface = SDL_CreateRGBSurface(
+            0, encoder->width, encoder->height, 24,
+            0x0000FF, 0x00FF00, 0xFF0000, 0
+        );
+    }
+    
+    if (!ctx->yuv_buffer) {
+        ctx->yuv_buffer = (uint8_t*)malloc(encoder_yuv420_size(encoder->width, encoder->height));
+    }
+    
+    if (!ctx->temp_surface || !ctx->yuv_buffer) {
         fprintf(stderr, "Error creating temporary surface: %s\n", SDL_GetError());
 #ifdef _WIN32
         _pclose(ctx->pipe);
@@ -115,24 +142,23 @@ bool encoder_start(VideoEncoder* encoder) {
 
 // Encode a frame from a surface
 bool encoder_encode_frame(VideoEncoder* encoder, SDL_Surface* surface) {
+    return encoder_encode_region(encoder, surface, NULL);
+}
+
+// Encode the part of a larger frame inside region (NULL = whole surface), so
+// several outputs can be cut from one rendered frame
+bool encoder_encode_region(VideoEncoder* encoder, SDL_Surface* surface, const SDL_Rect* region) {
     if (!encoder || !encoder->recording || !surface) return false;
     
     FFmpegContext* ctx = (FFmpegContext*)encoder->ffmpeg_context;
     if (!ctx->pipe || !ctx->temp_surface) return false;
     
-    // Convert surface to correct format if needed
-    SDL_BlitSurface(surface, NULL, ctx->temp_surface, NULL);
+    // Convert surface to correct format if needed (stages the frame for the pipe)
+    TRACE_BEGIN(queue_zone, "encode.queue");
+    SDL_BlitSurface(surface, region, ctx->temp_surface, NULL);
+    TRACE_END(queue_zone);
     
-    // Write pixel data to FFmpeg pipe
-    fwrite(ctx->temp_surface->pixels, 
-        encoder->width * encoder->height * 3, 1, 
-        ctx->pipe);
-    
-    // Increment frame count
-    ctx->frame_count++;
-    ctx->duration = (float)ctx->frame_count / encoder->framerate;
-    
-    return true;
+    return encoder_write_frame(encoder, ctx);
 }
 
 // Encode a frame from a renderer
@@ -156,6 +182,7 @@ bool encoder_encode_renderer(VideoEncoder* encoder, SDL_Renderer* renderer) {
     }
     
     // Copy renderer to texture
+    TRACE_BEGIN(readback_zone, "encode.readback");
     SDL_SetRenderTarget(renderer, texture);
     SDL_RenderReadPixels(
         renderer, NULL,
@@ -164,22 +191,12 @@ bool encoder_encode_renderer(VideoEncoder* encoder, SDL_Renderer* renderer) {
         ctx->temp_surface->pitch
     );
     SDL_SetRenderTarget(renderer, NULL);
-    
-    // Write pixel data to FFmpeg pipe
-    fwrite(
-        ctx->temp_surface->pixels,
-        encoder->width * encoder->height * 3,
-        1, ctx->pipe
-    );
+    TRACE_END(readback_zone);
     
     // Clean up
     SDL_DestroyTexture(texture);
     
-    // Increment frame count
-    ctx->frame_count++;
-    ctx->duration = (float)ctx->frame_count / encoder->framerate;
-    
-    return true;
+    return encoder_write_frame(encoder, ctx);
 }
 
 // Stop recording
@@ -231,3 +248,114 @@ void encoder_add_transition_effect(VideoEncoder* encoder, const char* effect_nam
     (void)encoder;
     (void)effect_name;
 }
+
+// Bytes in one planar YUV 4:2:0 frame (chroma planes round odd sizes up)
+int encoder_yuv420_size(int width, int height) {
+    int chroma_width = (width + 1) / 2;
+    int chroma_height = (height + 1) / 2;
+    return width * height + 2 * chroma_width * chroma_height;
+}
+
+// Convert packed RGB24 to planar YUV 4:2:0 (BT.601, limited range), averaging
+// chroma over each 2x2 block. Planes are written back to back: Y, U, V.
+void encoder_rgb_to_yuv420(const uint8_t* rgb, int pitch, int width, int height, uint8_t* yuv) {
+    int chroma_width = (width + 1) / 2;
+    int chroma_height = (height + 1) / 2;
+    uint8_t* y_plane = yuv;
+    uint8_t* u_plane = yuv + width * height;
+    uint8_t* v_plane = u_plane + chroma_width * chroma_height;
+    
+    // Luma for every pixel
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = rgb + y * pitch;
+        uint8_t* out = y_plane + y * width;
+        for (int x = 0; x < width; x++) {
+            int r = row[x * 3];
+            int g = row[x * 3 + 1];
+            int b = row[x * 3 + 2];
+            out[x] = (uint8_t)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+        }
+    }
+    
+    // Chroma from the average of each 2x2 block (edge blocks reuse the last row/column)
+    for (int cy = 0; cy < chroma_height; cy++) {
+        const uint8_t* row0 = rgb + (cy * 2) * pitch;
+        const uint8_t* row1 = (cy * 2 + 1 < height) ? row0 + pitch : row0;
+        
+        for (int cx = 0; cx < chroma_width; cx++) {
+            int x0 = cx * 2 * 3;
+            int x1 = (cx * 2 + 1 < width) ? x0 + 3 : x0;
+            
+            int r = row0[x0] + row0[x1] + row1[x0] + row1[x1];
+            int g = row0[x0 + 1] + row0[x1 + 1] + row1[x0 + 1] + row1[x1 + 1];
+            int b = row0[x0 + 2] + row0[x1 + 2] + row1[x0 + 2] + row1[x1 + 2];
+            
+            // Sums are 4x the average, so shift by 2 more bits
+            u_plane[cy * chroma_width + cx] = (uint8_t)(((-38 * r - 74 * g + 112 * b + 512) >> 10) + 128);
+            v_plane[cy * chroma_width + cx] = (uint8_t)(((112 * r - 94 * g - 18 * b + 512) >> 10) + 128);
+        }
+    }
+}
+
+// Helper: Convert the staged RGB frame and write it to the FFmpeg pipe
+static bool encoder_write_frame(VideoEncoder* encoder, FFmpegContext* ctx) {
+    TRACE_BEGIN(convert_zone, "encode.yuv");
+    encoder_rgb_to_yuv420(
+        (const uint8_t*)ctx->temp_surface->pixels,
+        ctx->temp_surface->pitch,
+        encoder->width, encoder->height,
+        ctx->yuv_buffer
+    );
+    TRACE_END(convert_zone);
+    
+    // Write pixel data to FFmpeg pipe
+    TRACE_BEGIN(pipe_zone, "encode.pipe_write");
+    fwrite(ctx->yuv_buffer, encoder_yuv420_size(encoder->width, encoder->height), 1, ctx->pipe);
+    TRACE_END(pipe_zone);
+    
+    // Increment frame count
+    ctx->frame_count++;
+    ctx->duration = (float)ctx->frame_count / encoder->framerate;
+    
+    return true;
+}
+
+// Join videos encoded with identical settings into one file without re-encoding
+bool encoder_concat_files(const char** inputs, int input_count, const char* output_filename) {
+    // FFmpeg's concat demuxer reads the inputs from a list file
+    char list_filename[1024];
+    snprintf(list_filename, sizeof(list_filename), "%s.concat.txt", output_filename);
+    
+    FILE* list = fopen(list_filename, "w");
+    if (!list) {
+        fprintf(stderr, "Error creating concat list %s\n", list_filename);
+        return false;
+    }
+    
+    // Entries are resolved relative to the list file, which sits next to the inputs
+    for (int i = 0; i < input_count; i++) {
+        const char* name = inputs[i];
+        const char* slash = strrchr(name, '/');
+        const char* backslash = strrchr(name, '\\');
+        if (backslash && (!slash || backslash > slash)) slash = backslash;
+        fprintf(list, "file '%s'\n", slash ? slash + 1 : name);
+    }
+    fclose(list);
+    
+    char cmd[2048];
+    snprintf(cmd, sizeof(cmd),
+        "ffmpeg -y -loglevel error -f concat -safe 0 -i \"%s\" -c copy \"%s\"",
+        list_filename, output_filename
+    );
+    
+    int status = system(cmd);
+    remove(list_filename);
+    
+    if (status != 0) {
+        fprintf(stderr, "Error joining video slices into %s\n", output_filename);
+        return false;
+    }
+    
+    printf("Video saved to %s (%d slices)\n", output_filename, input_count);
+    return true;
+}
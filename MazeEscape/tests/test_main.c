@@ -1,5 +1,11 @@
 #include <stdio.h>
-#include "maze_escape.h"
+#include <math.h>
+#include <limits.h>
+#include <string.h>
+#include "maze_core.h"
+
+// Number of failed checks (the exit status of the test run)
+static int test_failures = 0;
 
 // Simple test to verify maze generation
 void test_maze_generation() {
@@ -12,6 +18,7 @@ void test_maze_generation() {
     printf("Exit position: (%d, %d)\n", maze->exit_x, maze->exit_y);
     if (maze->cells[maze->exit_x][maze->exit_y] != CELL_EXIT) {
         printf("FAIL: Exit cell not properly marked\n");
+        test_failures++;
     } else {
         printf("PASS: Exit cell properly marked\n");
     }
@@ -49,12 +56,14 @@ void test_maze_generation() {
     // Check that we have a reasonable distribution of cells
     if (empty_count < 100) {
         printf("FAIL: Not enough empty cells\n");
+        test_failures++;
     } else {
         printf("PASS: Sufficient empty cells\n");
     }
     
     if (breakable_count < 5) {
         printf("FAIL: Not enough breakable walls\n");
+        test_failures++;
     } else {
         printf("PASS: Sufficient breakable walls\n");
     }
@@ -87,24 +96,28 @@ void test_character_creation() {
     // Check abilities
     if (runner->use_ability == NULL) {
         printf("FAIL: Runner has no ability\n");
+        test_failures++;
     } else {
         printf("PASS: Runner has an ability\n");
     }
     
     if (smasher->use_ability == NULL) {
         printf("FAIL: Smasher has no ability\n");
+        test_failures++;
     } else {
         printf("PASS: Smasher has an ability\n");
     }
     
     if (climber->use_ability == NULL) {
         printf("FAIL: Climber has no ability\n");
+        test_failures++;
     } else {
         printf("PASS: Climber has an ability\n");
     }
     
     if (teleporter->use_ability == NULL) {
         printf("FAIL: Teleporter has no ability\n");
+        test_failures++;
     } else {
         printf("PASS: Teleporter has an ability\n");
     }
@@ -118,12 +131,1476 @@ void test_character_creation() {
     printf("Character creation test complete\n\n");
 }
 
+// Test shortest paths read from the exit distance field
+void test_path_to_exit() {
+    printf("Testing path to exit...\n");
+    
+    Maze* maze = maze_create(20, 20, 40);
+    maze_generate(maze, 12345);
+    
+    int start_x = maze->start_positions[0];
+    int start_y = maze->start_positions[1];
+    int* path;
+    int path_length;
+    maze_get_path_to_exit(maze, start_x, start_y, &path, &path_length);
+    
+    if (path_length == 0 || path_length != maze_get_exit_distance(maze, start_x, start_y) + 1) {
+        printf("FAIL: Path length %d does not match exit distance\n", path_length);
+        test_failures++;
+    } else if (path[path_length * 2 - 2] != maze->exit_x || path[path_length * 2 - 1] != maze->exit_y) {
+        printf("FAIL: Path does not end at the exit\n");
+        test_failures++;
+    } else {
+        printf("PASS: Path of %d cells reaches the exit\n", path_length);
+    }
+    
+    // Every step moves to an adjacent open cell
+    bool connected = true;
+    for (int i = 1; i < path_length; i++) {
+        int dx = abs(path[i * 2] - path[i * 2 - 2]);
+        int dy = abs(path[i * 2 + 1] - path[i * 2 - 1]);
+        if (dx + dy != 1 || maze_is_wall(maze, path[i * 2], path[i * 2 + 1])) {
+            connected = false;
+        }
+    }
+    
+    if (!connected) {
+        printf("FAIL: Path has a gap or crosses a wall\n");
+        test_failures++;
+    } else {
+        printf("PASS: Path is connected\n");
+    }
+    
+    free(path);
+    maze_destroy(maze);
+    printf("Path to exit test complete\n\n");
+}
+
+// Test that every generated maze is solvable and that a cut maze gets repaired
+void test_maze_solvable() {
+    printf("Testing maze solvability...\n");
+    
+    // Entrance and spawns reach the exit for every algorithm and both grid
+    // parities, and any repair only opens a wall or two (none at all for the
+    // node-grid carvers, whose stubs sit on odd columns)
+    int unsolvable = 0;
+    int largest_repair = 0;
+    int node_grid_repairs = 0;
+    for (int a = 0; a < MAZE_ALGORITHM_COUNT; a++) {
+        for (unsigned int seed = 1; seed <= 200; seed++) {
+            Maze* maze = maze_create(20 + seed % 2, 30 + seed / 2 % 2, 40);
+            maze_generate_with(maze, seed, (MazeAlgorithm)a);
+            for (int i = 0; i < 4; i++) {
+                if (maze_get_exit_distance(maze, maze->start_positions[i * 2], maze->start_positions[i * 2 + 1]) == MAZE_UNREACHABLE) {
+                    unsolvable++;
+                    break;
+                }
+            }
+            if (maze->repaired_cells > largest_repair) largest_repair = maze->repaired_cells;
+            if (a != MAZE_ALGORITHM_BACKTRACKER && maze->repaired_cells > 0) node_grid_repairs++;
+            maze_destroy(maze);
+        }
+    }
+    
+    if (unsolvable > 0) {
+        printf("FAIL: %d of %d mazes cannot be solved\n", unsolvable, 200 * MAZE_ALGORITHM_COUNT);
+        test_failures++;
+    } else if (node_grid_repairs > 0) {
+        printf("FAIL: %d node-grid mazes placed the entrance or exit off the carved grid\n", node_grid_repairs);
+        test_failures++;
+    } else if (largest_repair > 2) {
+        printf("FAIL: Generation opened up to %d cells to join the entrance and exit\n", largest_repair);
+        test_failures++;
+    } else {
+        printf("PASS: All generated mazes are solvable (largest repair %d cells)\n", largest_repair);
+    }
+    
+    // Wall off a full row, then repair from the first spawn
+    Maze* maze = maze_create(20, 30, 40);
+    maze_generate(maze, 777);
+    for (int x = 0; x < maze->width; x++) {
+        maze->cells[x][maze->height / 2] = CELL_WALL;
+    }
+    int spawn_x = maze->start_positions[0];
+    int spawn_y = maze->start_positions[1];
+    int opened = maze_connect_to_exit(maze, spawn_x, spawn_y);
+    maze_compute_distance_field(maze);
+    
+    if (opened == 0 || opened > 2 || maze_get_exit_distance(maze, spawn_x, spawn_y) == MAZE_UNREACHABLE) {
+        printf("FAIL: Cut maze was not reconnected through the row (%d cells opened)\n", opened);
+        test_failures++;
+    } else if (maze_connect_to_exit(maze, spawn_x, spawn_y) != 0) {
+        printf("FAIL: Connected maze was changed\n");
+        test_failures++;
+    } else {
+        printf("PASS: Cut maze reconnected by opening %d cells\n", opened);
+    }
+    
+    maze_destroy(maze);
+    printf("Maze solvability test complete\n\n");
+}
+
+// Test every carving algorithm: reachable node cells, determinism, RNG jumps
+void test_maze_algorithms() {
+    printf("Testing maze algorithms...\n");
+    
+    for (int a = 0; a < MAZE_ALGORITHM_COUNT; a++) {
+        MazeAlgorithm algorithm = (MazeAlgorithm)a;
+        Maze* first = maze_create(31, 40, 40);
+        Maze* second = maze_create(31, 40, 40);
+        maze_generate_with(first, 99, algorithm);
+        maze_generate_with(second, 99, algorithm);
+        
+        // Node cells at odd coordinates all join the exit (the backtracker may use the other parity)
+        int cut_off = 0;
+        bool identical = true;
+        for (int x = 0; x < first->width; x++) {
+            for (int y = 0; y < first->height; y++) {
+                if (first->cells[x][y] != second->cells[x][y]) identical = false;
+                if (algorithm != MAZE_ALGORITHM_BACKTRACKER && x % 2 == 1 && y % 2 == 1 &&
+                    x < first->width - 1 && y < first->height - 1 &&
+                    maze_get_exit_distance(first, x, y) == MAZE_UNREACHABLE) {
+                    cut_off++;
+                }
+            }
+        }
+        for (int i = 0; i < 4; i++) {
+            if (maze_get_exit_distance(first, first->start_positions[i * 2], first->start_positions[i * 2 + 1]) == MAZE_UNREACHABLE) {
+                cut_off++;
+            }
+        }
+        
+        if (cut_off > 0 || !identical) {
+            printf("FAIL: %s: %d cells cut off, %s\n", maze_algorithm_name(algorithm), cut_off,
+                identical ? "deterministic" : "not deterministic");
+            test_failures++;
+        } else {
+            printf("PASS: %s mazes are connected and deterministic\n", maze_algorithm_name(algorithm));
+        }
+        
+        maze_destroy(first);
+        maze_destroy(second);
+    }
+    
+    // A jump lands where the same number of single steps does
+    unsigned int stepped = 4242;
+    for (int i = 0; i < 1000; i++) {
+        maze_random_next(&stepped);
+    }
+    MazeAlgorithm parsed;
+    if (maze_random_jump(4242, 1000) != stepped) {
+        printf("FAIL: Random jump does not match stepping\n");
+        test_failures++;
+    } else if (!maze_algorithm_parse("sidewinder", &parsed) || parsed != MAZE_ALGORITHM_SIDEWINDER) {
+        printf("FAIL: Algorithm names do not parse\n");
+        test_failures++;
+    } else {
+        printf("PASS: Random jumps match stepping\n");
+    }
+    
+    printf("Maze algorithms test complete\n\n");
+}
+
+// Test braiding: fewer dead ends, and the relaxed distance field matches a full recompute
+void test_maze_braid() {
+    printf("Testing maze braiding...\n");
+    
+    Maze* maze = maze_create(41, 41, 40);
+    maze_generate(maze, 31337);
+    
+    MazeStats before;
+    maze_compute_stats(maze, &before);
+    int opened = maze_braid(maze, 0.5f, 31337);
+    MazeStats after;
+    maze_compute_stats(maze, &after);
+    
+    int cell_count = maze->width * maze->height;
+    int* relaxed = (int*)malloc(cell_count * sizeof(int));
+    memcpy(relaxed, maze->exit_distance, cell_count * sizeof(int));
+    maze_compute_distance_field(maze);
+    bool field_matches = memcmp(relaxed, maze->exit_distance, cell_count * sizeof(int)) == 0;
+    free(relaxed);
+    
+    if (opened == 0 || after.dead_ends >= before.dead_ends) {
+        printf("FAIL: Braiding opened %d walls, dead ends %d -> %d\n", opened, before.dead_ends, after.dead_ends);
+        test_failures++;
+    } else if (!field_matches) {
+        printf("FAIL: Relaxed distance field differs from a full recompute\n");
+        test_failures++;
+    } else {
+        printf("PASS: Braiding opened %d walls, dead ends %d -> %d\n", opened, before.dead_ends, after.dead_ends);
+    }
+    
+    maze_destroy(maze);
+    printf("Maze braiding test complete\n\n");
+}
+
+// Test raycasts against a hand-built corridor: the first wall, its face, distance and cells crossed
+void test_maze_raycast() {
+    printf("Testing maze raycasts...\n");
+    
+    // A horizontal corridor along row 5 from x = 1 to x = 8, walls everywhere else
+    Maze* maze = maze_create(10, 10, 40);
+    for (int x = 0; x < maze->width; x++) {
+        for (int y = 0; y < maze->height; y++) {
+            maze->cells[x][y] = (y == 5 && x >= 1 && x <= 8) ? CELL_EMPTY : CELL_WALL;
+        }
+    }
+    
+    float cell_size = (float)maze->cell_size;
+    float origin_x = 1.5f * cell_size;
+    float origin_y = 5.5f * cell_size;
+    int cells[32];
+    MazeRayHit along;
+    bool along_hit = maze_raycast(maze, origin_x, origin_y, 1.0f, 0.0f, 20.0f * cell_size, &along, cells, 16);
+    
+    // Straight down the corridor hits the end wall's west face after 8 open cells
+    if (!along_hit || along.cell_x != 9 || along.cell_y != 5 || along.normal_x != -1 ||
+        along.cell_count != 8 || fabsf(along.distance - 7.5f * cell_size) > 0.01f || cells[14] != 8) {
+        printf("FAIL: Corridor ray stopped at (%d,%d) after %d cells, distance %.1f\n",
+            along.cell_x, along.cell_y, along.cell_count, along.distance);
+        test_failures++;
+    } else {
+        printf("PASS: Corridor ray hit (9,5) after 8 cells\n");
+    }
+    
+    // A steep ray leaves through the corridor's floor; a short one stops in the open
+    MazeRay rays[2] = {
+        {origin_x, origin_y, 0.3f, 1.0f, 20.0f * cell_size},
+        {origin_x, origin_y, 1.0f, 0.0f, 2.0f * cell_size},
+    };
+    MazeRayHit hits[2];
+    maze_raycast_batch(maze, rays, 2, hits);
+    int traced = maze_trace_cells(maze, origin_x, origin_y, 0.0f, 1.0f, 3.0f * cell_size, cells, 16);
+    
+    if (!hits[0].hit || hits[0].cell_y != 6 || hits[0].normal_y != -1 || hits[1].hit || hits[1].cell_x != 3) {
+        printf("FAIL: Batched rays stopped at (%d,%d) and (%d,%d)\n",
+            hits[0].cell_x, hits[0].cell_y, hits[1].cell_x, hits[1].cell_y);
+        test_failures++;
+    } else if (traced != 4 || cells[7] != 8) {
+        printf("FAIL: Traced %d cells through the walls (expected 4)\n", traced);
+        test_failures++;
+    } else if (!maze_line_of_sight(maze, origin_x, origin_y, 8.5f * cell_size, origin_y) ||
+               maze_line_of_sight(maze, origin_x, origin_y, 8.5f * cell_size, 7.5f * cell_size)) {
+        printf("FAIL: Line of sight disagrees with the corridor\n");
+        test_failures++;
+    } else {
+        printf("PASS: Batched rays, cell traces and line of sight agree\n");
+    }
+    
+    maze_destroy(maze);
+    printf("Maze raycast test complete\n\n");
+}
+
+// Test fog of war: walls block sight, the radius limits it, and only cell changes recast
+void test_fog_of_war() {
+    printf("Testing fog of war...\n");
+    
+    // The same corridor as the raycast test: row 5 open from x = 1 to x = 8
+    Maze* maze = maze_create(10, 10, 40);
+    for (int x = 0; x < maze->width; x++) {
+        for (int y = 0; y < maze->height; y++) {
+            maze->cells[x][y] = (y == 5 && x >= 1 && x <= 8) ? CELL_EMPTY : CELL_WALL;
+        }
+    }
+    
+    MazeFog* fog = fog_create(maze, 2, 6);
+    bool all_dirty = fog->dirty_count == fog->tiles_x * fog->tiles_y;
+    fog_clear_dirty(fog);
+    bool first_move = fog_move_viewer(fog, 0, 1, 5);
+    bool repeat_move = fog_move_viewer(fog, 0, 1, 5);
+    
+    // Corridor and its walls are seen up to the radius, nothing behind the walls
+    bool sight_ok = fog_is_revealed(fog, 7, 5) && fog_is_revealed(fog, 4, 4) && fog_is_revealed(fog, 4, 6) &&
+                    !fog_is_revealed(fog, 8, 5) && !fog_is_revealed(fog, 3, 3) && !fog_is_revealed(fog, 3, 7);
+    bool viewer_ok = fog_viewer_revealed(fog, 0, 7, 5) && !fog_viewer_revealed(fog, 1, 7, 5);
+    
+    if (!all_dirty || !first_move || repeat_move || fog->dirty_count != 1) {
+        printf("FAIL: Fog recast or dirty tiles wrong (first %d, repeat %d, dirty %d)\n",
+            first_move, repeat_move, fog->dirty_count);
+        test_failures++;
+    } else if (!sight_ok || !viewer_ok) {
+        printf("FAIL: Fog revealed the wrong cells\n");
+        test_failures++;
+    } else {
+        printf("PASS: Fog reveals %d cells along the corridor only\n", fog->revealed_count);
+    }
+    
+    fog_destroy(fog);
+    maze_destroy(maze);
+    
+    // On a generated maze nothing beyond the radius is ever revealed
+    maze = maze_create(41, 41, 40);
+    maze_generate(maze, 4242);
+    fog = fog_create(maze, 1, 5);
+    int start_x = maze->start_positions[0];
+    int start_y = maze->start_positions[1];
+    fog_move_viewer(fog, 0, start_x, start_y);
+    
+    int outside = 0;
+    for (int x = 0; x < maze->width; x++) {
+        for (int y = 0; y < maze->height; y++) {
+            if (fog_is_revealed(fog, x, y) && (abs(x - start_x) > 5 || abs(y - start_y) > 5)) outside++;
+        }
+    }
+    
+    if (outside > 0 || !fog_is_revealed(fog, start_x, start_y)) {
+        printf("FAIL: %d cells revealed beyond the sight radius\n", outside);
+        test_failures++;
+    } else {
+        printf("PASS: Fog stays within the sight radius\n");
+    }
+    
+    fog_destroy(fog);
+    maze_destroy(maze);
+    printf("Fog of war test complete\n\n");
+}
+
+// Helper: Occupancy check that blocks every cell
+static bool test_block_all(void* user_data, int x, int y) {
+    (void)user_data;
+    (void)x;
+    (void)y;
+    return true;
+}
+
+// Helper: Whether the incremental exit distance field matches a full recompute
+static bool test_distance_field_exact(Maze* maze) {
+    int cell_count = maze->width * maze->height;
+    int* incremental = (int*)malloc(cell_count * sizeof(int));
+    memcpy(incremental, maze->exit_distance, cell_count * sizeof(int));
+    maze_compute_distance_field(maze);
+    bool exact = memcmp(incremental, maze->exit_distance, cell_count * sizeof(int)) == 0;
+    free(incremental);
+    return exact;
+}
+
+// Test the dynamic maze: scheduled changes keep the distance field exact, doors
+// wait for blocked cells, and colliders follow the journal
+void test_dynamic_maze() {
+    printf("Testing dynamic maze...\n");
+    
+    Maze* maze = maze_create(41, 41, 40);
+    maze_generate(maze, 2024);
+    maze_braid(maze, 0.5f, 2024);
+    cpSpace* space = physics_create_space(0.0f, 0.0f);
+    maze->physics_space = space;
+    maze_add_physics_bodies(maze, space);
+    
+    // Closing and reopening single cells, one at a time
+    int mismatches = 0;
+    for (int x = 1; x < maze->width - 1; x += 4) {
+        for (int y = 1; y < maze->height - 1; y += 3) {
+            if (maze_get_cell(maze, x, y) != CELL_EMPTY) continue;
+            maze_set_cell(maze, x, y, CELL_WALL);
+            if (!test_distance_field_exact(maze)) mismatches++;
+            maze_set_cell(maze, x, y, CELL_EMPTY);
+            if (!test_distance_field_exact(maze)) mismatches++;
+        }
+    }
+    
+    // Colliders follow the journal
+    maze_sync_physics(maze, maze->changes, maze->change_count);
+    maze_clear_changes(maze);
+    int open_x = maze->exit_x;
+    int open_y = maze->exit_y - 1;
+    maze_set_cell(maze, open_x, open_y, CELL_WALL);
+    maze_sync_physics(maze, maze->changes, maze->change_count);
+    maze_clear_changes(maze);
+    bool collider_added = maze->cell_shapes[open_x * maze->height + open_y] != NULL;
+    maze_set_cell(maze, open_x, open_y, CELL_EMPTY);
+    maze_sync_physics(maze, maze->changes, maze->change_count);
+    maze_clear_changes(maze);
+    bool collider_removed = maze->cell_shapes[open_x * maze->height + open_y] == NULL;
+    
+    if (mismatches > 0) {
+        printf("FAIL: Incremental distance field wrong after %d edits\n", mismatches);
+        test_failures++;
+    } else if (!collider_added || !collider_removed) {
+        printf("FAIL: Colliders did not follow the journal\n");
+        test_failures++;
+    } else {
+        printf("PASS: Single edits keep the distance field and colliders exact\n");
+    }
+    
+    // A populated schedule running for twenty seconds
+    MazeDynamic* dynamic = maze_dynamic_create(maze);
+    maze->dynamic = dynamic;
+    int pieces = maze_dynamic_populate(dynamic, 2024);
+    int changed = 0;
+    for (int tick = 0; tick < 20 * 60 && mismatches == 0; tick++) {
+        maze_update(maze, 1.0f / 60.0f);
+        changed += maze->change_count;
+        maze_sync_physics(maze, maze->changes, maze->change_count);
+        maze_clear_changes(maze);
+        if (!test_distance_field_exact(maze)) mismatches++;
+    }
+    
+    if (pieces == 0 || changed == 0 || mismatches > 0) {
+        printf("FAIL: %d pieces made %d changes, field %s\n", pieces, changed, mismatches ? "wrong" : "exact");
+        test_failures++;
+    } else {
+        printf("PASS: %d pieces made %d changes with an exact distance field\n", pieces, changed);
+    }
+    maze_dynamic_destroy(dynamic);
+    
+    // A door waits while its cell is blocked
+    dynamic = maze_dynamic_create(maze);
+    maze->dynamic = dynamic;
+    int door_x = maze->start_positions[0];
+    int door_y = maze->start_positions[1] + 1;
+    maze_set_cell(maze, door_x, door_y, CELL_EMPTY);
+    maze_dynamic_add_door(dynamic, door_x, door_y, 1.0f, 0.5f);
+    maze_dynamic_set_blocked(dynamic, test_block_all, NULL);
+    maze_update(maze, 0.6f);
+    bool waited = maze_get_cell(maze, door_x, door_y) == CELL_EMPTY && dynamic->postponed == 1;
+    maze_dynamic_set_blocked(dynamic, NULL, NULL);
+    maze_update(maze, 0.1f);
+    bool closed = maze_get_cell(maze, door_x, door_y) == CELL_WALL;
+    maze_update(maze, 1.0f);
+    bool reopened = maze_get_cell(maze, door_x, door_y) == CELL_EMPTY;
+    
+    if (!waited || !closed || !reopened) {
+        printf("FAIL: Door timing wrong (waited %d, closed %d, reopened %d)\n", waited, closed, reopened);
+        test_failures++;
+    } else {
+        printf("PASS: Doors wait for blocked cells and follow their period\n");
+    }
+    
+    maze_dynamic_destroy(dynamic);
+    physics_destroy_space(space);
+    maze_destroy(maze);
+    printf("Dynamic maze test complete\n\n");
+}
+
+// Helper: The first `count` cells of the route a racer steers from (x, y):
+// each step goes to the first neighbour with a lower exit cost
+static void test_downhill_route(Maze* maze, int x, int y, int route[][2], int count) {
+    for (int i = 0; i < count; i++) {
+        route[i][0] = x;
+        route[i][1] = y;
+        int best = maze_get_exit_cost(maze, x, y);
+        int best_x = x;
+        int best_y = y;
+        for (int dir = 0; dir < 4; dir++) {
+            int nx = x + (dir == 1) - (dir == 3);
+            int ny = y + (dir == 2) - (dir == 0);
+            int cost = maze_get_exit_cost(maze, nx, ny);
+            if (cost != MAZE_UNREACHABLE && cost < best) {
+                best = cost;
+                best_x = nx;
+                best_y = ny;
+            }
+        }
+        x = best_x;
+        y = best_y;
+    }
+}
+
+// Helper: Replace a race's trigger table with one portal pair
+static void test_set_portal_pair(Simulation* sim, int ax, int ay, int bx, int by) {
+    MazeTriggers* table = sim->triggers;
+    for (int i = 0; i < table->trigger_count; i++) {
+        table->cell_triggers[table->triggers[i].x * sim->maze->height + table->triggers[i].y] = -1;
+    }
+    
+    MazeTrigger pair[2] = {
+        {MAZE_TRIGGER_PORTAL, ax, ay, 1},
+        {MAZE_TRIGGER_PORTAL, bx, by, 0}
+    };
+    for (int i = 0; i < 2; i++) {
+        table->triggers[i] = pair[i];
+        table->cell_triggers[pair[i].x * sim->maze->height + pair[i].y] = i;
+    }
+    table->trigger_count = 2;
+}
+
+// Test the special cell trigger table and its use in a race
+void test_special_triggers() {
+    printf("Testing special cell triggers...\n");
+    
+    Maze* maze = maze_create(41, 41, 40);
+    maze_generate(maze, 4242);
+    MazeTriggers* triggers = maze_triggers_create(maze, 4242);
+    
+    // Every special cell, and only those, has a trigger; portals come in pairs
+    bool table_ok = triggers != NULL;
+    int portal_index = -1;
+    for (int x = 0; table_ok && x < maze->width; x++) {
+        for (int y = 0; table_ok && y < maze->height; y++) {
+            const MazeTrigger* trigger = maze_triggers_at(triggers, x, y);
+            table_ok = (trigger != NULL) == (maze->cells[x][y] == CELL_SPECIAL) &&
+                       (!trigger || (trigger->x == x && trigger->y == y));
+            if (trigger && trigger->type == MAZE_TRIGGER_PORTAL) {
+                const MazeTrigger* partner = &triggers->triggers[trigger->partner];
+                table_ok = table_ok && partner->type == MAZE_TRIGGER_PORTAL &&
+                           &triggers->triggers[partner->partner] == trigger;
+                portal_index = (int)(trigger - triggers->triggers);
+            }
+        }
+    }
+    
+    if (!table_ok || triggers->trigger_count == 0) {
+        printf("FAIL: Trigger table does not match the special cells\n");
+        test_failures++;
+    } else {
+        printf("PASS: %d special cells indexed with paired portals\n", triggers->trigger_count);
+    }
+    
+    // Journaled edits keep the table in step: a removed portal orphans its partner
+    if (portal_index >= 0) {
+        MazeTrigger portal = triggers->triggers[portal_index];
+        MazeTrigger partner = triggers->triggers[portal.partner];
+        int count = triggers->trigger_count;
+        maze_set_cell(maze, portal.x, portal.y, CELL_EMPTY);
+        maze_triggers_apply_changes(triggers, maze->changes, maze->change_count);
+        maze_clear_changes(maze);
+        
+        const MazeTrigger* orphan = maze_triggers_at(triggers, partner.x, partner.y);
+        if (maze_triggers_at(triggers, portal.x, portal.y) || triggers->trigger_count != count - 1 ||
+            !orphan || orphan->type != MAZE_TRIGGER_SPEED_PAD || orphan->partner != -1) {
+            printf("FAIL: Trigger table not updated after a special cell was cleared\n");
+            test_failures++;
+        } else {
+            printf("PASS: Clearing a portal drops its trigger and orphans its partner\n");
+        }
+    }
+    
+    maze_triggers_destroy(triggers);
+    maze_destroy(maze);
+    
+    // In a race, entering a portal cell moves the racer to the paired portal
+    SimulationConfig config = {
+        .maze_width = 41,
+        .maze_height = 41,
+        .cell_size = 40,
+        .character_types = "runner",
+        .simulation_duration = 5,
+        .random_seed = 4242
+    };
+    Simulation* sim = simulation_create(&config);
+    sim->verbose = false;
+    
+    // Portals only jump towards the exit, so take one whose partner is closer
+    const MazeTrigger* portal = NULL;
+    for (int i = 0; i < sim->triggers->trigger_count && !portal; i++) {
+        const MazeTrigger* trigger = &sim->triggers->triggers[i];
+        if (trigger->type != MAZE_TRIGGER_PORTAL) continue;
+        
+        const MazeTrigger* partner = &sim->triggers->triggers[trigger->partner];
+        if (maze_get_exit_cost(sim->maze, partner->x, partner->y) < maze_get_exit_cost(sim->maze, trigger->x, trigger->y)) {
+            portal = trigger;
+        }
+    }
+    
+    if (portal) {
+        const MazeTrigger* partner = &sim->triggers->triggers[portal->partner];
+        Character* runner = sim->characters[0];
+        cpBodySetPosition(runner->body, cpv((portal->x + 0.5f) * config.cell_size, (portal->y + 0.5f) * config.cell_size));
+        simulation_step(sim, 1.0f / 60.0f);
+        
+        if (runner->current_cell_x != partner->x || runner->current_cell_y != partner->y || sim->triggers_fired != 1) {
+            printf("FAIL: Portal did not move the racer to its partner (%d, %d)\n", partner->x, partner->y);
+            test_failures++;
+        } else {
+            printf("PASS: Portal moves the racer to its partner\n");
+        }
+        
+        // Standing on the arrival portal does not bounce the racer back
+        simulation_step(sim, 1.0f / 60.0f);
+        if (sim->triggers_fired != 1) {
+            printf("FAIL: Arrival portal fired without a cell change\n");
+            test_failures++;
+        } else {
+            printf("PASS: Triggers fire once per cell entered\n");
+        }
+    }
+    
+    simulation_destroy(sim);
+    
+    // Portal A lies on the route from its partner B to the exit: a racer
+    // walking into A must carry on instead of bouncing back to B forever
+    config.simulation_duration = 30;
+    sim = simulation_create(&config);
+    sim->verbose = false;
+    Maze* race_maze = sim->maze;
+    Character* runner = sim->characters[0];
+    
+    int route[8][2];
+    test_downhill_route(race_maze, runner->current_cell_x, runner->current_cell_y, route, 8);
+    test_set_portal_pair(sim, route[2][0], route[2][1], route[6][0], route[6][1]);
+    
+    int portal_a_distance = maze_get_exit_distance(race_maze, route[6][0], route[6][1]);
+    cpBodySetPosition(runner->body, cpv((route[5][0] + 0.5f) * config.cell_size, (route[5][1] + 0.5f) * config.cell_size));
+    bool passed = false;
+    while (sim->running && !passed) {
+        simulation_step(sim, 1.0f / 60.0f);
+        passed = runner->has_escaped ||
+                 maze_get_exit_distance(race_maze, runner->current_cell_x, runner->current_cell_y) < portal_a_distance;
+    }
+    
+    if (!passed || sim->triggers_fired != 0) {
+        printf("FAIL: Racer sent back along its route by a portal (%d portal jumps)\n", sim->triggers_fired);
+        test_failures++;
+    } else {
+        printf("PASS: Portals leading away from the exit are walked over\n");
+    }
+    
+    simulation_destroy(sim);
+    printf("Special cell trigger test complete\n\n");
+}
+
+// Helper: Weighted exit costs by repeated relaxation until nothing changes
+// (slow but obviously right), for checking the radix-heap Dijkstra
+static int* test_reference_costs(Maze* maze) {
+    static const int dx[4] = {0, 1, 0, -1};
+    static const int dy[4] = {-1, 0, 1, 0};
+    MazeTerrain* terrain = maze->terrain;
+    int cell_count = maze->width * maze->height;
+    int* cost = (int*)malloc(cell_count * sizeof(int));
+    for (int i = 0; i < cell_count; i++) cost[i] = INT_MAX;
+    cost[maze->exit_x * maze->height + maze->exit_y] = 0;
+    
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (int x = 0; x < maze->width; x++) {
+            for (int y = 0; y < maze->height; y++) {
+                int index = x * maze->height + y;
+                if (cost[index] == INT_MAX || maze_is_wall(maze, x, y)) continue;
+                
+                const TerrainInfo* info = maze_terrain_info((TerrainType)terrain->types[index]);
+                for (int dir = 0; dir < 4; dir++) {
+                    int nx = x - dx[dir];
+                    int ny = y - dy[dir];
+                    if (maze_is_wall(maze, nx, ny)) continue;
+                    
+                    // Moving from (nx, ny) into (x, y) in direction dir
+                    int step = terrain->costs[index];
+                    if (info->push_x == dx[dir] && info->push_y == dy[dir]) step = step > 1 ? step / 2 : 1;
+                    else if (info->push_x == -dx[dir] && info->push_y == -dy[dir]) step *= 2;
+                    
+                    int next = nx * maze->height + ny;
+                    if (cost[index] + step < cost[next]) {
+                        cost[next] = cost[index] + step;
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+    
+    for (int i = 0; i < cell_count; i++) {
+        if (cost[i] == INT_MAX) cost[i] = MAZE_UNREACHABLE;
+    }
+    return cost;
+}
+
+// Test the radix heap and the terrain cost field
+void test_terrain_costs() {
+    printf("Testing terrain costs...\n");
+    
+    // Pops come out in key order while pushes stay at or above the last pop
+    RadixHeap heap;
+    radix_heap_init(&heap);
+    unsigned int seed = 4242;
+    for (int i = 0; i < 500; i++) {
+        radix_heap_push(&heap, (unsigned int)maze_random_below(&seed, 100000), i);
+    }
+    
+    RadixHeapEntry entry;
+    unsigned int previous = 0;
+    int popped = 0;
+    bool ordered = true;
+    while (radix_heap_pop(&heap, &entry)) {
+        ordered = ordered && entry.key >= previous;
+        previous = entry.key;
+        if (popped++ < 300) {
+            radix_heap_push(&heap, entry.key + (unsigned int)maze_random_below(&seed, 50), -1);
+        }
+    }
+    radix_heap_free(&heap);
+    
+    if (!ordered || popped != 800) {
+        printf("FAIL: Radix heap popped %d entries, ordered %d\n", popped, ordered);
+        test_failures++;
+    } else {
+        printf("PASS: Radix heap pops in key order\n");
+    }
+    
+    // Plain floor: every step costs the same
+    Maze* maze = maze_create(41, 41, 40);
+    maze_generate(maze, 4242);
+    MazeTerrain* terrain = maze_terrain_create(maze);
+    
+    bool uniform = true;
+    for (int i = 0; i < maze->width * maze->height; i++) {
+        int distance = maze->exit_distance[i];
+        int expected = distance == MAZE_UNREACHABLE ? MAZE_UNREACHABLE : distance * TERRAIN_BASE_COST;
+        uniform = uniform && terrain->exit_cost[i] == expected;
+    }
+    
+    if (!terrain || maze->terrain != terrain || !uniform) {
+        printf("FAIL: Plain terrain costs are not steps times the base cost\n");
+        test_failures++;
+    } else {
+        printf("PASS: Plain terrain costs follow the exit distance\n");
+    }
+    
+    // Mud, ice and belts: the Dijkstra field matches the reference, also after a wall opens
+    int placed = maze_terrain_populate(terrain, 4242, 0.3f);
+    int* reference = test_reference_costs(maze);
+    bool matches = memcmp(reference, terrain->exit_cost, maze->width * maze->height * sizeof(int)) == 0;
+    free(reference);
+    
+    int wall_x = -1;
+    int wall_y = -1;
+    for (int x = 2; x < maze->width - 2 && wall_x < 0; x++) {
+        for (int y = 2; y < maze->height - 2 && wall_x < 0; y++) {
+            if (maze->cells[x][y] == CELL_WALL && !maze_is_wall(maze, x - 1, y) && !maze_is_wall(maze, x + 1, y)) {
+                wall_x = x;
+                wall_y = y;
+            }
+        }
+    }
+    maze_set_cell(maze, wall_x, wall_y, CELL_EMPTY);
+    reference = test_reference_costs(maze);
+    bool matches_after_edit = memcmp(reference, terrain->exit_cost, maze->width * maze->height * sizeof(int)) == 0;
+    free(reference);
+    
+    if (placed == 0 || terrain->terrain_cells != placed || !matches || !matches_after_edit) {
+        printf("FAIL: Terrain cost field wrong (%d cells placed, match %d, after edit %d)\n",
+            placed, matches, matches_after_edit);
+        test_failures++;
+    } else {
+        printf("PASS: Terrain cost field exact over %d terrain cells and after an edit\n", placed);
+    }
+    
+    maze_terrain_destroy(terrain);
+    if (maze->terrain != NULL || maze_get_exit_cost(maze, maze->exit_x, maze->exit_y) != 0) {
+        printf("FAIL: Destroyed terrain still attached to the maze\n");
+        test_failures++;
+    }
+    
+    maze_destroy(maze);
+    printf("Terrain cost test complete\n\n");
+}
+
+// Test race outcome prediction and stopping decided races
+void test_race_prediction() {
+    printf("Testing race prediction...\n");
+    
+    SimulationConfig config = {
+        .maze_width = 41,
+        .maze_height = 41,
+        .cell_size = 40,
+        .character_types = "runner,smasher",
+        .simulation_duration = 30,
+        .random_seed = 4242,
+        .stop_when_decided = true,
+        .decided_epilogue = 0.5f
+    };
+    
+    // Two racers side by side next to the exit: nobody is ahead for sure
+    Simulation* sim = simulation_create(&config);
+    sim->verbose = false;
+    Maze* maze = sim->maze;
+    int near_x = -1;
+    int near_y = -1;
+    for (int x = 0; x < maze->width && near_x < 0; x++) {
+        for (int y = 0; y < maze->height && near_x < 0; y++) {
+            if (maze_get_exit_distance(maze, x, y) == 2) {
+                near_x = x;
+                near_y = y;
+            }
+        }
+    }
+    cpVect near = cpv((near_x + 0.5f) * config.cell_size, (near_y + 0.5f) * config.cell_size);
+    cpBodySetPosition(sim->characters[0]->body, near);
+    cpBodySetPosition(sim->characters[1]->body, near);
+    simulation_step(sim, 1.0f / 60.0f);
+    
+    bool open_race = sim->decided_time < 0.0f && sim->predicted_finish[0] > sim->time &&
+                     sim->predicted_finish[0] < sim->predicted_finish[1];
+    simulation_destroy(sim);
+    
+    // The runner next to the exit and the smasher at its spawn: decided at once
+    sim = simulation_create(&config);
+    sim->verbose = false;
+    cpBodySetPosition(sim->characters[0]->body, near);
+    simulation_step(sim, 1.0f / 60.0f);
+    bool decided = sim->decided_time >= 0.0f && sim->predicted_winner == 0;
+    
+    // ...stops running by the end of the epilogue...
+    while (sim->running && sim->time < config.simulation_duration) {
+        simulation_step(sim, 1.0f / 60.0f);
+    }
+    float stopped_after = sim->time - sim->decided_time;
+    
+    // ...and finishing it off-screen gives the real first escape
+    simulation_finish(sim, 1.0f / 60.0f);
+    bool finished = !sim->running && (sim->winner ? sim->winner->has_escaped : sim->time >= config.simulation_duration);
+    
+    if (!open_race) {
+        printf("FAIL: Race with two racers at the same cell was decided\n");
+        test_failures++;
+    } else if (!decided || stopped_after > 0.52f) {
+        printf("FAIL: Decided race not over after its epilogue (decided %d, ended after %.2fs)\n",
+            decided, stopped_after);
+        test_failures++;
+    } else if (!finished) {
+        printf("FAIL: Finishing a decided race did not reach an escape or the time limit\n");
+        test_failures++;
+    } else {
+        printf("PASS: Races are decided only by a clear lead, stop after the epilogue and finish off-screen\n");
+    }
+    simulation_destroy(sim);
+    
+    // On mud, ice and belts, a portal on the runner's route is part of its estimate
+    SimulationConfig terrain_config = config;
+    terrain_config.terrain_fraction = 0.3f;
+    terrain_config.stop_when_decided = false;
+    sim = simulation_create(&terrain_config);
+    sim->verbose = false;
+    Character* runner = sim->characters[0];
+    int route[4][2];
+    test_downhill_route(sim->maze, runner->current_cell_x, runner->current_cell_y, route, 4);
+    test_set_portal_pair(sim, route[2][0], route[2][1], sim->maze->exit_x, sim->maze->exit_y - 1);
+    int steps = maze_get_exit_distance(sim->maze, runner->current_cell_x, runner->current_cell_y);
+    simulation_step(sim, 1.0f / 60.0f);
+    
+    float estimate = sim->predicted_finish[0] - sim->time;
+    float nominal = steps * config.cell_size / runner->speed;
+    bool follows_portal = estimate > 0.0f && estimate < nominal / 2.0f;
+    simulation_destroy(sim);
+    
+    // ...and early calls on those floors, with portals and loops, match the full race
+    int decided_races = 0;
+    int wrong_calls = 0;
+    for (unsigned int seed = 1; seed <= 20; seed++) {
+        SimulationConfig full_config = {
+            .maze_width = 21,
+            .maze_height = 21,
+            .cell_size = 40,
+            .character_types = "runner,smasher,climber,teleporter",
+            .simulation_duration = 60,
+            .random_seed = seed,
+            .braid_fraction = 0.5f,
+            .terrain_fraction = 0.3f
+        };
+        sim = simulation_create(&full_config);
+        sim->verbose = false;
+        int called = -1;
+        while (sim->running) {
+            simulation_step(sim, 1.0f / 60.0f);
+            if (called < 0 && sim->decided_time >= 0.0f) called = sim->predicted_winner;
+        }
+        if (called >= 0) {
+            decided_races++;
+            if (sim->winner != sim->characters[called]) wrong_calls++;
+        }
+        simulation_destroy(sim);
+    }
+    
+    if (!follows_portal) {
+        printf("FAIL: Estimate ignores the portal on the route (%.2fs against %.2fs walking)\n", estimate, nominal);
+        test_failures++;
+    } else if (decided_races == 0 || wrong_calls > 0) {
+        printf("FAIL: %d of %d early calls on terrain with portals picked the wrong winner\n",
+            wrong_calls, decided_races);
+        test_failures++;
+    } else {
+        printf("PASS: Estimates follow portals over terrain; %d early calls all right\n", decided_races);
+    }
+    
+    printf("Race prediction test complete\n\n");
+}
+
+// Test time-lapse speed-up over a stalled race
+void test_timelapse() {
+    printf("Testing time-lapse...\n");
+    
+    SimulationConfig config = {
+        .maze_width = 21,
+        .maze_height = 21,
+        .cell_size = 40,
+        .character_types = "runner,smasher",
+        .simulation_duration = 60,
+        .random_seed = 99
+    };
+    Simulation* sim = simulation_create(&config);
+    sim->verbose = false;
+    
+    // Racers that cannot move and use no abilities: after the lively start,
+    // playback speeds up
+    for (int i = 0; i < sim->character_count; i++) {
+        sim->characters[i]->speed = 0.0f;
+    }
+    float dt = 1.0f / 60.0f;
+    TimeLapse* lapse = timelapse_open(4, 60, NULL);
+    int first_speedup = 0;
+    int speedup = 0;
+    for (int frame = 0; frame < 10 * 60 && sim->running; frame++) {
+        speedup = timelapse_next_speedup(lapse);
+        if (frame == 0) first_speedup = speedup;
+        for (int step = 0; step < speedup && sim->running; step++) {
+            simulation_step(sim, dt);
+            sim->event_count = 0;
+            timelapse_measure(lapse, sim, dt);
+        }
+        timelapse_write_frame(lapse, sim->time);
+    }
+    float output_time = lapse->frame_count * dt;
+    
+    // An event drops straight back to real time
+    SimulationEvent event = {0};
+    event.type = SIM_EVENT_EFFECT;
+    simulation_step(sim, dt);
+    simulation_push_event(sim, &event);
+    timelapse_measure(lapse, sim, dt);
+    int after_event = timelapse_next_speedup(lapse);
+    
+    if (first_speedup != 1 || speedup != 4 || sim->time < 2.0f * output_time) {
+        printf("FAIL: Stalled race not sped up (first %d, last %d, %.1fs of race in %.1fs)\n",
+            first_speedup, speedup, sim->time, output_time);
+        test_failures++;
+    } else if (after_event != 1 || lapse->step_count <= lapse->frame_count) {
+        printf("FAIL: Event did not return the time-lapse to real time (speed-up %d)\n", after_event);
+        test_failures++;
+    } else {
+        printf("PASS: %.1fs of stalled race played in %.1fs, real time again on an event\n",
+            sim->time, output_time);
+    }
+    
+    timelapse_close(lapse);
+    simulation_destroy(sim);
+    printf("Time-lapse test complete\n\n");
+}
+
+// Test cooperative planning: racers stepping along their plans never share a cell and all escape
+void test_cooperative_planning() {
+    printf("Testing cooperative planning...\n");
+    
+    Maze* maze = maze_create(20, 30, 40);
+    maze_generate(maze, 12345);
+    MazeCoop* coop = coop_create(maze, 4, COOP_DEFAULT_WINDOW);
+    
+    int x[4];
+    int y[4];
+    bool escaped[4] = {false, false, false, false};
+    for (int i = 0; i < 4; i++) {
+        x[i] = maze->start_positions[i * 2];
+        y[i] = maze->start_positions[i * 2 + 1];
+    }
+    
+    // Step every racer to its next planned cell, one planning step at a time
+    int collisions = 0;
+    int steps = 0;
+    int escaped_count = 0;
+    for (; steps < 300 && escaped_count < 4; steps++) {
+        for (int i = 0; i < 4; i++) {
+            coop_set_agent(coop, i, escaped[i] ? -1 : x[i], y[i]);
+        }
+        coop_update(coop, COOP_DEFAULT_BUDGET);
+        
+        for (int i = 0; i < 4; i++) {
+            int next_x, next_y;
+            if (escaped[i] || !coop_next_cell(coop, i, &next_x, &next_y)) continue;
+            x[i] = next_x;
+            y[i] = next_y;
+            if (x[i] == maze->exit_x && y[i] == maze->exit_y) {
+                escaped[i] = true;
+                escaped_count++;
+            }
+        }
+        coop_advance(coop);
+        
+        for (int i = 0; i < 4; i++) {
+            for (int j = i + 1; j < 4; j++) {
+                if (!escaped[i] && !escaped[j] && x[i] == x[j] && y[i] == y[j]) collisions++;
+            }
+        }
+    }
+    
+    if (collisions > 0) {
+        printf("FAIL: Planned racers shared a cell %d times\n", collisions);
+        test_failures++;
+    } else if (escaped_count < 4) {
+        printf("FAIL: Only %d of 4 planned racers escaped in %d steps\n", escaped_count, steps);
+        test_failures++;
+    } else {
+        printf("PASS: 4 planned racers escaped in %d steps without sharing a cell\n", steps);
+    }
+    
+    coop_destroy(coop);
+    maze_destroy(maze);
+    printf("Cooperative planning test complete\n\n");
+}
+
+// Test hierarchical paths against the exit distance field, before and after a wall breaks
+void test_hpa_paths() {
+    printf("Testing hierarchical paths...\n");
+    
+    Maze* maze = maze_create(97, 61, 40);
+    maze_generate(maze, 12345);
+    MazeHpa* hpa = hpa_create(maze, 8);
+    
+    int mismatches = 0;
+    for (int round = 0; round < 2; round++) {
+        for (int x = 1; x < maze->width; x += 7) {
+            for (int y = 1; y < maze->height; y += 5) {
+                int distance = maze_get_exit_distance(maze, x, y);
+                if (distance == MAZE_UNREACHABLE) continue;
+                
+                int* path;
+                int path_length;
+                hpa_get_path_to_exit(hpa, x, y, &path, &path_length);
+                
+                // Shortest, connected and ending at the exit
+                bool valid = path_length == distance + 1 &&
+                             path[path_length * 2 - 2] == maze->exit_x &&
+                             path[path_length * 2 - 1] == maze->exit_y;
+                for (int i = 1; valid && i < path_length; i++) {
+                    int dx = abs(path[i * 2] - path[i * 2 - 2]);
+                    int dy = abs(path[i * 2 + 1] - path[i * 2 - 1]);
+                    valid = dx + dy == 1 && !maze_is_wall(maze, path[i * 2], path[i * 2 + 1]);
+                }
+                if (!valid) mismatches++;
+                free(path);
+            }
+        }
+        
+        // Open every breakable wall; only the sectors around them are rebuilt
+        int rebuilds = hpa->sector_rebuilds;
+        for (int x = 0; x < maze->width; x++) {
+            for (int y = 0; y < maze->height; y++) {
+                maze_break_wall(maze, x, y);
+            }
+        }
+        if (round == 0 && hpa->sector_rebuilds != rebuilds) {
+            printf("FAIL: Sectors were rebuilt eagerly\n");
+            test_failures++;
+        }
+    }
+    
+    if (mismatches > 0) {
+        printf("FAIL: %d hierarchical paths differ from the distance field\n", mismatches);
+        test_failures++;
+    } else {
+        printf("PASS: Hierarchical paths are shortest paths\n");
+    }
+    
+    hpa_destroy(hpa);
+    maze_destroy(maze);
+    printf("Hierarchical path test complete\n\n");
+}
+
+// Test the junction graph against the grid, before and after walls break
+void test_junction_graph() {
+    printf("Testing junction graph...\n");
+    
+    Maze* maze = maze_create(41, 29, 40);
+    maze_generate(maze, 12345);
+    MazeGraph* graph = maze_graph_create(maze);
+    int* field = (int*)malloc(maze->width * maze->height * sizeof(int));
+    
+    int open_cells = 0;
+    for (int x = 0; x < maze->width; x++) {
+        for (int y = 0; y < maze->height; y++) {
+            if (!maze_is_wall(maze, x, y)) open_cells++;
+        }
+    }
+    if (graph->node_count * 4 > open_cells) {
+        printf("FAIL: %d nodes for %d open cells\n", graph->node_count, open_cells);
+        test_failures++;
+    } else {
+        printf("PASS: %d open cells collapse to %d nodes\n", open_cells, graph->node_count);
+    }
+    
+    int mismatches = 0;
+    for (int round = 0; round < 2; round++) {
+        // Exit distances match the grid breadth-first search
+        maze_compute_distance_field(maze);
+        maze_graph_distance_field(graph, maze->exit_x, maze->exit_y, field);
+        for (int i = 0; i < maze->width * maze->height; i++) {
+            if (field[i] != maze->exit_distance[i]) mismatches++;
+        }
+        
+        // Paths from cells to the exit are shortest and connected
+        for (int x = 1; x < maze->width; x += 3) {
+            for (int y = 1; y < maze->height; y += 3) {
+                int distance = maze_get_exit_distance(maze, x, y);
+                if (distance == MAZE_UNREACHABLE) continue;
+                
+                int* path;
+                int path_length;
+                bool found = maze_graph_find_path(graph, x, y, maze->exit_x, maze->exit_y, &path, &path_length);
+                bool valid = found && path_length == distance + 1 &&
+                             maze_graph_distance(graph, x, y, maze->exit_x, maze->exit_y) == distance;
+                for (int i = 1; valid && i < path_length; i++) {
+                    int dx = abs(path[i * 2] - path[i * 2 - 2]);
+                    int dy = abs(path[i * 2 + 1] - path[i * 2 - 1]);
+                    valid = dx + dy == 1 && !maze_is_wall(maze, path[i * 2], path[i * 2 + 1]);
+                }
+                if (!valid) mismatches++;
+                free(path);
+            }
+        }
+        
+        // Open every breakable wall; the graph follows through its maze listener
+        for (int x = 0; x < maze->width; x++) {
+            for (int y = 0; y < maze->height; y++) {
+                if (maze_get_cell(maze, x, y) == CELL_BREAKABLE) {
+                    maze_set_cell(maze, x, y, CELL_EMPTY);
+                }
+            }
+        }
+    }
+    
+    if (mismatches > 0) {
+        printf("FAIL: %d graph distances or paths differ from the grid\n", mismatches);
+        test_failures++;
+    } else {
+        printf("PASS: Graph distances and paths match the grid\n");
+    }
+    
+    free(field);
+    maze_graph_destroy(graph);
+    maze_destroy(maze);
+    printf("Junction graph test complete\n\n");
+}
+
+// Test the one-pass layout statistics against direct counts
+void test_maze_stats() {
+    printf("Testing maze statistics...\n");
+    
+    Maze* maze = maze_create(31, 41, 40);
+    maze_generate(maze, 2024);
+    
+    MazeStats stats;
+    maze_compute_stats(maze, &stats);
+    
+    // Count dead ends and junctions and find the entrance cell by cell
+    int dead_ends = 0;
+    int junctions = 0;
+    int entrance_distance = MAZE_UNREACHABLE;
+    for (int x = 0; x < maze->width; x++) {
+        for (int y = 0; y < maze->height; y++) {
+            if (maze_is_wall(maze, x, y)) continue;
+            int degree = 0;
+            if (!maze_is_wall(maze, x, y - 1)) degree++;
+            if (!maze_is_wall(maze, x + 1, y)) degree++;
+            if (!maze_is_wall(maze, x, y + 1)) degree++;
+            if (!maze_is_wall(maze, x - 1, y)) degree++;
+            if (degree == 1) dead_ends++;
+            if (degree >= 3) junctions++;
+            if (maze->cells[x][y] == CELL_START) entrance_distance = maze_get_exit_distance(maze, x, y);
+        }
+    }
+    
+    bool spawns_match = true;
+    for (int i = 0; i < MAZE_STATS_SPAWNS; i++) {
+        int distance = maze_get_exit_distance(maze, maze->start_positions[i * 2], maze->start_positions[i * 2 + 1]);
+        if (stats.spawn_distance[i] != distance) spawns_match = false;
+    }
+    
+    if (stats.dead_ends != dead_ends || stats.junctions != junctions || stats.dead_ends == 0) {
+        printf("FAIL: Dead ends %d/%d, junctions %d/%d\n", stats.dead_ends, dead_ends, stats.junctions, junctions);
+        test_failures++;
+    } else if (stats.solution_length != entrance_distance || stats.solution_length == MAZE_UNREACHABLE) {
+        printf("FAIL: Solution length %d, expected %d\n", stats.solution_length, entrance_distance);
+        test_failures++;
+    } else if (!spawns_match) {
+        printf("FAIL: Spawn distances do not match the exit distance field\n");
+        test_failures++;
+    } else if (stats.longest_corridor < 2 || stats.branching_factor < 2.0f) {
+        printf("FAIL: Corridor %d or branching factor %.2f out of range\n",
+            stats.longest_corridor, stats.branching_factor);
+        test_failures++;
+    } else {
+        printf("PASS: Maze statistics match direct counts\n");
+    }
+    
+    maze_destroy(maze);
+    printf("Maze statistics test complete\n\n");
+}
+
+// Test that a race is reproducible from its seed
+void test_simulation_determinism() {
+    printf("Testing simulation determinism...\n");
+    
+    SimulationConfig config = {
+        .maze_width = 20,
+        .maze_height = 30,
+        .cell_size = 40,
+        .character_types = "runner,smasher,climber,teleporter",
+        .simulation_duration = 5,
+        .random_seed = 4242
+    };
+    
+    Simulation* first = simulation_create(&config);
+    Simulation* second = simulation_create(&config);
+    first->verbose = false;
+    second->verbose = false;
+    
+    for (int i = 0; i < 120; i++) {
+        simulation_step(first, 1.0f / 60.0f);
+        simulation_step(second, 1.0f / 60.0f);
+    }
+    
+    bool identical = first->character_count == second->character_count;
+    for (int i = 0; identical && i < first->character_count; i++) {
+        identical = first->characters[i]->x == second->characters[i]->x &&
+                    first->characters[i]->y == second->characters[i]->y &&
+                    first->characters[i]->ability_uses == second->characters[i]->ability_uses;
+    }
+    
+    if (!identical) {
+        printf("FAIL: Two races with the same seed diverged\n");
+        test_failures++;
+    } else {
+        printf("PASS: Races with the same seed are identical\n");
+    }
+    
+    simulation_destroy(first);
+    simulation_destroy(second);
+    printf("Simulation determinism test complete\n\n");
+}
+
+// Test recording a race to a trajectory and replaying it
+void test_trajectory_roundtrip() {
+    printf("Testing trajectory record and replay...\n");
+    
+    SimulationConfig config = {
+        .maze_width = 31,
+        .maze_height = 21,
+        .cell_size = 40,
+        .character_types = "runner,smasher,climber,teleporter",
+        .simulation_duration = 10,
+        .random_seed = 4242,
+        .fog_radius = 4,
+        .terrain_fraction = 0.3f
+    };
+    const char* path = "test_trajectory.mztr";
+    const char* truncated_path = "test_trajectory_truncated.mztr";
+    enum { FRAMES = 90 };
+    
+    Simulation* sim = simulation_create(&config);
+    sim->verbose = false;
+    int count = sim->character_count;
+    float x[FRAMES][SIMULATION_MAX_CHARACTERS];
+    float y[FRAMES][SIMULATION_MAX_CHARACTERS];
+    float angle[FRAMES][SIMULATION_MAX_CHARACTERS];
+    int state[FRAMES][SIMULATION_MAX_CHARACTERS];
+    
+    // Record, breaking a wall partway through so a cell edit is in the file
+    TrajectoryWriter* writer = trajectory_writer_open(path, sim, 60);
+    int broken_walls = 0;
+    for (int frame = 0; frame < FRAMES && writer; frame++) {
+        if (frame == FRAMES / 2) {
+            for (int cx = 1; cx < sim->maze->width - 1 && !broken_walls; cx++) {
+                for (int cy = 1; cy < sim->maze->height - 1 && !broken_walls; cy++) {
+                    if (sim->maze->cells[cx][cy] == CELL_BREAKABLE) {
+                        maze_break_wall(sim->maze, cx, cy);
+                        broken_walls++;
+                    }
+                }
+            }
+        }
+        simulation_step(sim, 1.0f / 60.0f);
+        trajectory_write_frame(writer, sim, true);
+        for (int i = 0; i < count; i++) {
+            Character* character = sim->characters[i];
+            x[frame][i] = character->x;
+            y[frame][i] = character->y;
+            angle[frame][i] = character->angle;
+            state[frame][i] = (int)character->state | (character->has_escaped ? 0x8 : 0);
+        }
+    }
+    bool recorded = writer && trajectory_writer_close(writer);
+    
+    // Replay: every frame within quantization (1/64 pixel, 1/1024 radian)
+    TrajectoryReader* reader = recorded ? trajectory_reader_open(path) : NULL;
+    Simulation* replay = reader ? trajectory_reader_simulation(reader) : NULL;
+    int frames_read = 0;
+    int mismatched_frames = 0;
+    while (replay && frames_read < FRAMES && trajectory_read_frame(reader)) {
+        bool matches = replay->character_count == count;
+        for (int i = 0; matches && i < count; i++) {
+            Character* character = replay->characters[i];
+            int replay_state = (int)character->state | (character->has_escaped ? 0x8 : 0);
+            matches = fabsf(character->x - x[frames_read][i]) <= 0.5f / 64.0f + 1e-3f &&
+                      fabsf(character->y - y[frames_read][i]) <= 0.5f / 64.0f + 1e-3f &&
+                      fabsf(character->angle - angle[frames_read][i]) <= 0.5f / 1024.0f + 1e-4f &&
+                      replay_state == state[frames_read][i];
+        }
+        if (!matches) mismatched_frames++;
+        frames_read++;
+    }
+    
+    // Cells (with the broken wall), terrain and fog come back identical
+    bool maze_same = replay && replay->maze->terrain && sim->maze->terrain;
+    int cell_count = config.maze_width * config.maze_height;
+    for (int i = 0; maze_same && i < cell_count; i++) {
+        int cx = i / config.maze_height;
+        int cy = i % config.maze_height;
+        maze_same = replay->maze->cells[cx][cy] == sim->maze->cells[cx][cy] &&
+                    replay->maze->terrain->types[i] == sim->maze->terrain->types[i] &&
+                    replay->maze->terrain->exit_cost[i] == sim->maze->terrain->exit_cost[i];
+    }
+    bool fog_same = replay && replay->fog && sim->fog &&
+                    replay->fog->revealed_count == sim->fog->revealed_count &&
+                    memcmp(replay->fog->revealed, sim->fog->revealed,
+                           sim->fog->words_per_map * sizeof(uint64_t)) == 0 &&
+                    memcmp(replay->fog->viewer_maps, sim->fog->viewer_maps,
+                           (size_t)sim->fog->words_per_map * count * sizeof(uint64_t)) == 0;
+    
+    if (!recorded || !replay || frames_read != FRAMES || mismatched_frames > 0) {
+        printf("FAIL: Replay diverged (%d of %d frames read, %d mismatched)\n",
+            frames_read, FRAMES, mismatched_frames);
+        test_failures++;
+    } else if (broken_walls != 1 || !maze_same || !fog_same) {
+        printf("FAIL: Replayed maze differs (broken walls %d, cells and terrain %d, fog %d)\n",
+            broken_walls, maze_same, fog_same);
+        test_failures++;
+    } else {
+        printf("PASS: %d frames replay within quantization, with the same cells, terrain and fog\n", frames_read);
+    }
+    trajectory_reader_close(reader);
+    simulation_destroy(sim);
+    
+    // A file cut inside its header is rejected, and one cut inside its
+    // frames ends the replay early
+    FILE* file = fopen(path, "rb");
+    long size = 0;
+    unsigned char* data = NULL;
+    if (file) {
+        fseek(file, 0, SEEK_END);
+        size = ftell(file);
+        fseek(file, 0, SEEK_SET);
+        data = (unsigned char*)malloc(size > 0 ? (size_t)size : 1);
+        if (data && fread(data, 1, (size_t)size, file) != (size_t)size) size = 0;
+        fclose(file);
+    }
+    
+    bool header_rejected = false;
+    int truncated_frames = -1;
+    file = data && size > 64 ? fopen(truncated_path, "wb") : NULL;
+    if (file) {
+        fwrite(data, 1, 32, file);
+        fclose(file);
+        TrajectoryReader* cut = trajectory_reader_open(truncated_path);
+        header_rejected = cut == NULL;
+        trajectory_reader_close(cut);
+        
+        file = fopen(truncated_path, "wb");
+        fwrite(data, 1, (size_t)size - 5, file);
+        fclose(file);
+        cut = trajectory_reader_open(truncated_path);
+        if (cut) {
+            truncated_frames = 0;
+            while (trajectory_read_frame(cut)) truncated_frames++;
+            trajectory_reader_close(cut);
+        }
+    }
+    
+    if (!header_rejected || truncated_frames < 0 || truncated_frames >= FRAMES) {
+        printf("FAIL: Truncated trajectory accepted (header rejected %d, %d frames read)\n",
+            header_rejected, truncated_frames);
+        test_failures++;
+    } else {
+        printf("PASS: Truncated trajectories are rejected\n");
+    }
+    
+    free(data);
+    remove(path);
+    remove(truncated_path);
+    printf("Trajectory test complete\n\n");
+}
+
+// Test arena allocation and O(1) reset
+void test_arena() {
+    printf("Testing arena allocator...\n");
+    
+    Arena* arena = arena_create(1024);
+    
+    char* first = (char*)arena_alloc(arena, 100);
+    char* name = arena_strdup(arena, "Runner");
+    char* large = (char*)arena_alloc(arena, 4096); // Bigger than a block
+    
+    if (!first || !name || !large || strcmp(name, "Runner") != 0) {
+        printf("FAIL: Arena allocations failed\n");
+        test_failures++;
+    } else if (((size_t)first % 16) != 0 || ((size_t)large % 16) != 0) {
+        printf("FAIL: Arena allocations are not aligned\n");
+        test_failures++;
+    } else {
+        printf("PASS: Arena allocations succeed and are aligned\n");
+    }
+    
+    // A reset hands out the same memory again without growing
+    size_t capacity = arena_capacity(arena);
+    arena_reset(arena);
+    char* again = (char*)arena_alloc(arena, 100);
+    arena_alloc(arena, 4096);
+    
+    if (again != first || arena_capacity(arena) != capacity) {
+        printf("FAIL: Arena reset did not reuse its blocks\n");
+        test_failures++;
+    } else {
+        printf("PASS: Arena reset reuses its blocks\n");
+    }
+    
+    arena_destroy(arena);
+    
+    // The physics pool keeps data across reallocs between size classes
+    int* values = (int*)pool_calloc(4, sizeof(int));
+    for (int i = 0; i < 4; i++) values[i] = i + 1;
+    values = (int*)pool_realloc(values, 2048 * sizeof(int)); // Large block
+    bool kept = values[0] == 1 && values[3] == 4;
+    values = (int*)pool_realloc(values, 8 * sizeof(int));    // Back into a size class
+    kept = kept && values[0] == 1 && values[3] == 4;
+    pool_free(values);
+    
+    if (!kept) {
+        printf("FAIL: Pool realloc lost data\n");
+        test_failures++;
+    } else {
+        printf("PASS: Pool realloc keeps data\n");
+    }
+    
+    printf("Arena allocator test complete\n\n");
+}
+
 // Main test function
 int main() {
     printf("Running MazeEscape tests...\n\n");
     
     test_maze_generation();
     test_character_creation();
+    test_path_to_exit();
+    test_maze_solvable();
+    test_maze_algorithms();
+    test_maze_braid();
+    test_maze_raycast();
+    test_fog_of_war();
+    test_dynamic_maze();
+    test_special_triggers();
+    test_terrain_costs();
+    test_hpa_paths();
+    test_junction_graph();
+    test_cooperative_planning();
+    test_maze_stats();
+    test_simulation_determinism();
+    test_race_prediction();
+    test_timelapse();
+    test_trajectory_roundtrip();
+    test_arena();
+    
+    if (test_failures > 0) {
+        printf("%d check(s) failed\n", test_failures);
+        return 1;
+    }
     
     printf("All tests complete!\n");
     return 0;